@@ -98,6 +98,21 @@ TOOLBOX_BENCHMARK(async_logger)
     }
 }
 
+// Measures contention between threads pushing to the same asynchronous logger queue.
+TOOLBOX_BENCHMARK_THREADS(async_logger_contention, 1, 2, 4)
+{
+    // Shared by all threads. Initialisation of function-local statics is thread-safe.
+    static AsyncLogger al{null_logger()};
+    static Runner alr{al, "logger"s};
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(50)) {
+            al.write_log(WallTime{}, LogLevel::Info, ctx.thread_index(), LogMsgPtr{}, 0);
+        }
+        // Back off to avoid flooding the queue.
+        this_thread::sleep_for(1ms);
+    }
+}
+
 TOOLBOX_BENCHMARK(single_thread_async_null_logger)
 {
     using namespace noformat;
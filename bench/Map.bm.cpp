@@ -126,4 +126,35 @@ TOOLBOX_BENCHMARK(robin_map_immutable)
     }
 }
 
+// Lookups in maps of increasing size, where the argument is the number of keys.
+TOOLBOX_BENCHMARK_ARGS(std_map_find, 16, 256, 4096, 65536)
+{
+    const auto n = static_cast<int>(ctx.arg());
+    map<int, int> m;
+    for (int k{0}; k < n; ++k) {
+        m.emplace(k, k);
+    }
+    size_t i{0};
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(100)) {
+            bm::do_not_optimise(m.find(RandData[i++ % RandData.size()] * 997 % n));
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK_ARGS(robin_map_find, 16, 256, 4096, 65536)
+{
+    const auto n = static_cast<int>(ctx.arg());
+    RobinMap<int, int> m;
+    for (int k{0}; k < n; ++k) {
+        m.emplace(k, k);
+    }
+    size_t i{0};
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(100)) {
+            bm::do_not_optimise(m.find(RandData[i++ % RandData.size()] * 997 % n));
+        }
+    }
+}
+
 } // namespace
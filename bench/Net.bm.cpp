@@ -13,7 +13,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <toolbox/io/Coroutine.hpp>
+#include <toolbox/io/ShmRing.hpp>
+#include <toolbox/net/DgramSock.hpp>
 #include <toolbox/net/Endpoint.hpp>
+#include <toolbox/net/Frame.hpp>
+#include <toolbox/net/FramedConn.hpp>
+#include <toolbox/net/Timestamp.hpp>
 #include <toolbox/util/Random.hpp>
 #include <toolbox/util/Stream.hpp>
 #include <toolbox/bm.hpp>
@@ -22,6 +28,7 @@
 #include <cstddef>
 #include <vector>
 #include <limits>
+#include <memory>
 
 #include <netinet/in.h>
 
@@ -94,4 +101,310 @@ TOOLBOX_BENCHMARK(format_ipv4_endpoint)
     }
 }
 
+// Per-datagram cost of sending and receiving a burst of same-sized datagrams to one destination,
+// using one syscall per datagram, one syscall per burst, or UDP GSO/GRO.
+constexpr size_t Burst{32};
+constexpr size_t DgramSize{1200};
+
+struct UdpPair {
+    UdpPair()
+    {
+        rx_ep = parse_dgram_endpoint("udp4://127.0.0.1:0");
+        rx = DgramSock{rx_ep.protocol()};
+        rx.bind(rx_ep);
+        rx.get_sock_name(rx_ep);
+        rx.set_rcv_buf(4 << 20);
+        tx = DgramSock{rx_ep.protocol()};
+        for (size_t i{0}; i < Burst; ++i) {
+            out.push_back({payload + i * DgramSize, DgramSize}, rx_ep);
+        }
+    }
+    void send_burst() { tx.sendmmsg(out, 0); }
+    void drain()
+    {
+        error_code ec;
+        while (rx.recvmmsg(in, MSG_DONTWAIT, ec) > 0) {
+        }
+    }
+
+    char payload[Burst * DgramSize]{};
+    DgramEndpoint rx_ep;
+    DgramSock rx, tx;
+    DgramBatch out{Burst, 0};
+    DgramBatch in{Burst, 2048};
+};
+
+TOOLBOX_BENCHMARK(udp_recvfrom_burst)
+{
+    UdpPair p;
+    char buf[2048];
+    DgramEndpoint ep;
+    while (ctx) {
+        p.send_burst();
+        for ([[maybe_unused]] auto _ : ctx.range(Burst)) {
+            p.rx.recvfrom(buf, sizeof(buf), 0, ep);
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK(udp_recvmmsg_burst)
+{
+    UdpPair p;
+    while (ctx) {
+        p.send_burst();
+        // Record the average per datagram.
+        [[maybe_unused]] const auto range = ctx.range(Burst);
+        p.rx.recvmmsg(p.in, 0);
+    }
+}
+
+TOOLBOX_BENCHMARK(udp_gro_burst)
+{
+    UdpPair p;
+    p.rx.set_udp_gro(true);
+    constexpr size_t BufSize{65536};
+    const auto buf = make_unique<char[]>(BufSize);
+    DgramEndpoint ep;
+    while (ctx) {
+        p.tx.sendto_gso({p.payload, sizeof(p.payload)}, DgramSize, 0, p.rx_ep);
+        [[maybe_unused]] const auto range = ctx.range(Burst);
+        for (size_t n{0}; n < Burst;) {
+            size_t seg_size;
+            const auto len = p.rx.recvfrom_gro({buf.get(), BufSize}, 0, ep, seg_size);
+            n += for_each_segment({buf.get(), len}, seg_size, [](ConstBuffer seg) {
+                bm::do_not_optimise(seg);
+            });
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK(udp_sendto_burst)
+{
+    UdpPair p;
+    while (ctx) {
+        for (auto i : ctx.range(Burst)) {
+            p.tx.sendto({p.payload + i * DgramSize, DgramSize}, 0, p.rx_ep);
+        }
+        p.drain();
+    }
+}
+
+TOOLBOX_BENCHMARK(udp_sendmmsg_burst)
+{
+    UdpPair p;
+    while (ctx) {
+        {
+            [[maybe_unused]] const auto range = ctx.range(Burst);
+            p.send_burst();
+        }
+        p.drain();
+    }
+}
+
+TOOLBOX_BENCHMARK(udp_gso_burst)
+{
+    UdpPair p;
+    while (ctx) {
+        {
+            [[maybe_unused]] const auto range = ctx.range(Burst);
+            p.tx.sendto_gso({p.payload, sizeof(p.payload)}, DgramSize, 0, p.rx_ep);
+        }
+        p.drain();
+    }
+}
+
+// In-host latency from the kernel receive timestamp to the point at which the datagram is read by
+// the application. A hardware timestamp is used instead when the NIC provides one.
+TOOLBOX_BENCHMARK(udp_rcv_timestamp_latency)
+{
+    UdpPair p;
+    p.rx.enable_software_rcv_timestamps();
+    char buf[2048];
+    DgramEndpoint ep;
+    PacketTimestamps ts;
+    while (ctx) {
+        p.tx.sendto({p.payload, DgramSize}, 0, p.rx_ep);
+        p.rx.recvfrom({buf, sizeof(buf)}, 0, ep, ts);
+        ctx.record(WallClock::now() - ts.best());
+    }
+}
+
+// Cost of sending a length-prefixed frame by copying the header and payload into a contiguous
+// buffer, versus writing them from separate buffers with writev().
+struct FramePair : FramedConn<FramePair> {
+    FramePair(Reactor& r, pair<IoSock, IoSock>&& socks)
+    : FramedConn<FramePair>{r, std::move(socks.first), FrameLength::Varint, endian::little}
+    , rx{std::move(socks.second)}
+    {
+        rx.set_non_block();
+    }
+    void on_frame(CyclTime /*now*/, ConstBuffer /*payload*/) {}
+    void on_conn_disconnect(CyclTime /*now*/) {}
+    void on_conn_error(CyclTime /*now*/, const std::system_error& /*e*/) {}
+    void drain(Reactor& r)
+    {
+        do {
+            error_code ec;
+            while (rx.read(buf, sizeof(buf), ec) > 0) {
+            }
+            r.poll(CyclTime::now(), 0s);
+        } while (pending() > 0);
+    }
+    IoSock rx;
+    char buf[65536];
+};
+
+pair<IoSock, IoSock> make_frame_socketpair()
+{
+    auto socks = socketpair(UnixStreamProtocol{});
+    socks.first.set_non_block();
+    return socks;
+}
+
+TOOLBOX_BENCHMARK_ARGS(frame_send_copy, 64, 1024, 8192)
+{
+    Reactor r;
+    FramePair p{r, make_frame_socketpair()};
+    const string payload(ctx.arg(), 'x');
+    Buffer out;
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(8)) {
+            const auto buf = out.prepare(MaxFrameHeader + payload.size());
+            auto* data = static_cast<char*>(buf.data());
+            const auto n = put_frame_header(data, payload.size(), FrameLength::Varint,
+                                            endian::little);
+            copy(payload.begin(), payload.end(), data + n);
+            out.commit(n + payload.size());
+            error_code ec;
+            out.consume(max<ssize_t>(os::write(p.sock().get(), out.data(), ec), 0));
+        }
+        p.drain(r);
+    }
+}
+
+TOOLBOX_BENCHMARK_ARGS(frame_send_writev, 64, 1024, 8192)
+{
+    Reactor r;
+    FramePair p{r, make_frame_socketpair()};
+    const string payload(ctx.arg(), 'x');
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(8)) {
+            p.send({payload.data(), payload.size()});
+        }
+        p.drain(r);
+    }
+}
+
+// Cost of passing a small message through a shared-memory ring, versus a stream socket. Both are
+// written and read on the same thread, so this excludes the cost of waking the reader.
+TOOLBOX_BENCHMARK(shm_ring_write_read)
+{
+    auto ring = ShmRing::create_memfd("tb-bench", 1024, 64, ShmRingMode::Spsc);
+    ShmWriter w{ring};
+    ShmReader r{ring};
+    char msg[32]{};
+    char buf[64];
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(8)) {
+            w.write({msg, sizeof(msg)});
+            size_t size;
+            r.read({buf, sizeof(buf)}, size);
+            bm::do_not_optimise(buf);
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK(unix_stream_write_read)
+{
+    auto socks = socketpair(UnixStreamProtocol{});
+    char msg[32]{};
+    char buf[64];
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(8)) {
+            socks.first.send(msg, sizeof(msg), 0);
+            socks.second.recv(buf, sizeof(buf), 0);
+            bm::do_not_optimise(buf);
+        }
+    }
+}
+
+// Cost of dispatching a readable event to a callback, versus resuming a coroutine that awaits an
+// AsyncFd. Both include the cost of the send, poll and read, but the coroutine also reads until
+// EAGAIN, as required by the edge-triggered subscription.
+struct ReadHandler {
+    void on_input(CyclTime /*now*/, int fd, unsigned /*events*/)
+    {
+        os::read(fd, buf, sizeof(buf));
+    }
+    char buf[64];
+};
+
+TOOLBOX_BENCHMARK(reactor_callback_read)
+{
+    Reactor r;
+    auto socks = socketpair(UnixStreamProtocol{});
+    ReadHandler h;
+    const auto sub = r.subscribe(*socks.second, EpollIn, bind<&ReadHandler::on_input>(&h));
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(8)) {
+            socks.first.send("x", 1, 0);
+            r.poll(CyclTime::now(), 0s);
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK(reactor_coroutine_read)
+{
+    Reactor r;
+    auto socks = socketpair(UnixStreamProtocol{});
+    socks.second.set_non_block();
+    AsyncFd afd{r, *socks.second};
+    auto t = [](AsyncFd& afd, IoSock& sock) -> Task<> {
+        char buf[64];
+        for (;;) {
+            co_await afd.readable();
+            error_code ec;
+            while (sock.read(buf, sizeof(buf), ec) > 0) {
+            }
+        }
+    }(afd, socks.second);
+    t.start();
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(8)) {
+            socks.first.send("x", 1, 0);
+            r.poll(CyclTime::now(), 0s);
+        }
+    }
+}
+
+// Cost of a handler that enables and disables write interest several times per cycle, when each
+// change is applied immediately, versus deferred until the next poll.
+void toggle_write_interest(bm::Context& ctx, bool deferred)
+{
+    Reactor r;
+    r.set_deferred_updates(deferred);
+    auto socks = socketpair(UnixStreamProtocol{});
+    ReadHandler h;
+    auto sub = r.subscribe(*socks.second, EpollIn, bind<&ReadHandler::on_input>(&h));
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(8)) {
+            for (int i{0}; i < 4; ++i) {
+                sub.set_events(EpollIn | EpollOut);
+                sub.set_events(EpollIn);
+            }
+            r.poll(CyclTime::now(), 0s);
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK(reactor_set_events_immediate)
+{
+    toggle_write_interest(ctx, false);
+}
+
+TOOLBOX_BENCHMARK(reactor_set_events_deferred)
+{
+    toggle_write_interest(ctx, true);
+}
+
 } // namespace
@@ -0,0 +1,239 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <toolbox/http/App.hpp>
+#include <toolbox/http/Serv.hpp>
+#include <toolbox/http/Stream.hpp>
+#include <toolbox/io/EventFd.hpp>
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/net/Endpoint.hpp>
+#include <toolbox/net/StreamSock.hpp>
+
+#include <toolbox/bm.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+TOOLBOX_BENCHMARK_MAIN
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+// Returns true once a complete response, including the body, has been received.
+bool is_response_complete(string_view resp)
+{
+    const auto end = resp.find("\r\n\r\n");
+    if (end == string_view::npos) {
+        return false;
+    }
+    constexpr auto Field = "Content-Length:"sv;
+    auto pos = resp.find(Field);
+    if (pos == string_view::npos || pos > end) {
+        return true;
+    }
+    pos = resp.find_first_not_of(' ', pos + Field.size());
+    size_t len{0};
+    for (; pos < end && resp[pos] >= '0' && resp[pos] <= '9'; ++pos) {
+        len = len * 10 + (resp[pos] - '0');
+    }
+    return resp.size() >= end + 4 + len;
+}
+
+// Returns a loopback endpoint with a port that is not currently in use.
+StreamEndpoint unused_loopback_endpoint()
+{
+    auto ep = parse_stream_endpoint("tcp4://127.0.0.1:0");
+    StreamSockServ sock{ep.protocol()};
+    sock.bind(ep);
+    os::getsockname(sock.get(), ep);
+    return ep;
+}
+
+class BenchApp final : public App {
+  public:
+    ~BenchApp() override = default;
+
+  protected:
+    void do_on_http_connect(CyclTime /*now*/, const Endpoint& /*ep*/) noexcept override {}
+    void do_on_http_disconnect(CyclTime /*now*/, const Endpoint& /*ep*/) noexcept override {}
+    void do_on_http_error(CyclTime /*now*/, const Endpoint& /*ep*/, const std::exception& /*e*/,
+                          http::OStream& /*os*/) noexcept override
+    {
+    }
+    void do_on_http_message(CyclTime /*now*/, const Endpoint& /*ep*/, const Request& /*req*/,
+                            http::OStream& os) override
+    {
+        os.reset(Status::Ok, TextPlain);
+        os << "Hello, World!";
+        os.commit();
+    }
+    void do_on_http_timeout(CyclTime /*now*/, const Endpoint& /*ep*/) noexcept override {}
+};
+
+// Round-trip of a single byte between both ends of a socketpair, where both ends are dispatched by
+// the same reactor.
+TOOLBOX_BENCHMARK(socketpair_ping_pong)
+{
+    Reactor r{1024};
+    auto [ping, pong] = socketpair(UnixStreamProtocol{});
+    ping.set_non_block();
+    pong.set_non_block();
+
+    bool done{false};
+    auto on_ping = [](CyclTime /*now*/, int fd, unsigned /*events*/) {
+        char c;
+        if (os::recv(fd, &c, 1, 0) == 1) {
+            os::send(fd, &c, 1, 0);
+        }
+    };
+    auto on_pong = [&done](CyclTime /*now*/, int fd, unsigned /*events*/) {
+        char c;
+        done = os::recv(fd, &c, 1, 0) == 1;
+    };
+    const auto ping_sub = r.subscribe(*pong, EpollIn, bind(&on_ping));
+    const auto pong_sub = r.subscribe(*ping, EpollIn, bind(&on_pong));
+
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(1)) {
+            done = false;
+            ping.send("x", 1, 0);
+            while (!done) {
+                r.poll(CyclTime::now(), NoTimeout);
+            }
+        }
+    }
+}
+
+// As above, but using a pair of eventfds.
+TOOLBOX_BENCHMARK(eventfd_ping_pong)
+{
+    Reactor r{1024};
+    EventFd ping{0, EFD_NONBLOCK};
+    EventFd pong{0, EFD_NONBLOCK};
+
+    bool done{false};
+    auto on_ping = [&](CyclTime /*now*/, int /*fd*/, unsigned /*events*/) {
+        ping.read();
+        pong.write(1);
+    };
+    auto on_pong = [&](CyclTime /*now*/, int /*fd*/, unsigned /*events*/) {
+        pong.read();
+        done = true;
+    };
+    const auto ping_sub = r.subscribe(ping.fd(), EpollIn, bind(&on_ping));
+    const auto pong_sub = r.subscribe(pong.fd(), EpollIn, bind(&on_pong));
+
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(1)) {
+            done = false;
+            ping.write(1);
+            while (!done) {
+                r.poll(CyclTime::now(), NoTimeout);
+            }
+        }
+    }
+}
+
+// Delay between a timer's requested expiry and its dispatch, where the argument is the timer
+// interval in microseconds.
+TOOLBOX_BENCHMARK_ARGS(timer_jitter, 100, 1000)
+{
+    const Micros interval{ctx.arg()};
+    Reactor r{1024};
+
+    bool done{false};
+    auto on_timer = [&](CyclTime /*now*/, Timer& tmr) {
+        ctx.record(MonoClock::now() - tmr.expiry());
+        done = true;
+    };
+    while (ctx) {
+        done = false;
+        const auto tmr = r.timer(MonoClock::now() + interval, Priority::High, bind(&on_timer));
+        while (!done) {
+            r.poll(CyclTime::now(), NoTimeout);
+        }
+    }
+}
+
+// Delay between a call to wakeup() and the reactor thread returning from poll().
+TOOLBOX_BENCHMARK(wakeup_latency)
+{
+    Reactor r{1024};
+    // Blocking, so that the benchmark thread yields to the reactor thread on single-core machines.
+    EventFd ack{0, 0};
+    atomic<int64_t> sent{0};
+    atomic<int64_t> latency{0};
+    atomic<bool> stop{false};
+
+    jthread reactor_thread{[&]() {
+        while (!stop.load(memory_order_acquire)) {
+            r.poll(CyclTime::now(), NoTimeout);
+            const auto now = TscClock::now().time_since_epoch().count();
+            if (const auto start = sent.exchange(0, memory_order_acq_rel); start != 0) {
+                latency.store(now - start, memory_order_release);
+                ack.write(1);
+            }
+        }
+    }};
+    while (ctx) {
+        sent.store(TscClock::now().time_since_epoch().count(), memory_order_release);
+        r.wakeup();
+        ack.read();
+        ctx.record(Nanos{latency.load(memory_order_acquire)});
+    }
+    stop.store(true, memory_order_release);
+    r.wakeup();
+}
+
+// Request/response round-trip through http::Serv over a loopback TCP connection. The client is
+// driven from the reactor thread, so that only the server's dispatch path and the loopback stack
+// are measured.
+TOOLBOX_BENCHMARK(http_round_trip)
+{
+    Reactor r{1024};
+    BenchApp app;
+    const auto ep = unused_loopback_endpoint();
+    Serv serv{CyclTime::now(), r, ep, app};
+
+    StreamSockClnt clnt{ep.protocol()};
+    clnt.connect(ep);
+    clnt.set_non_block();
+    set_tcp_no_delay(clnt.get(), true);
+
+    constexpr auto Req = "GET /bench HTTP/1.1\r\nHost: localhost\r\n\r\n"sv;
+    string resp;
+    char buf[1024];
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(1)) {
+            resp.clear();
+            clnt.send(Req.data(), Req.size(), 0);
+            do {
+                r.poll(CyclTime::now(), 0ms);
+                error_code ec;
+                const auto n = clnt.recv(buf, sizeof(buf), 0, ec);
+                if (n > 0) {
+                    resp.append(buf, n);
+                } else if (ec && ec != errc::operation_would_block) {
+                    throw system_error{ec, "recv"};
+                }
+            } while (!is_response_complete(resp));
+        }
+    }
+}
+
+} // namespace
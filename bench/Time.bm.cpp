@@ -66,6 +66,16 @@ TOOLBOX_BENCHMARK(sys_clock_gettime_monotonic)
     }
 }
 
+TOOLBOX_BENCHMARK(tsc_clock_now)
+{
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(1000)) {
+            auto t = TscClock::now();
+            bm::do_not_optimise(t);
+        }
+    }
+}
+
 TOOLBOX_BENCHMARK(cycl_time_now)
 {
     while (ctx) {
@@ -87,4 +97,15 @@ TOOLBOX_BENCHMARK(cycl_time_mono_time)
     }
 }
 
+TOOLBOX_BENCHMARK(cycl_time_now_tsc)
+{
+    CyclTime::use_tsc();
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(1000)) {
+            CyclTime::now();
+        }
+    }
+    CyclTime::use_tsc(false);
+}
+
 } // namespace
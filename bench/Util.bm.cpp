@@ -13,7 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <toolbox/util/Arena.hpp>
 #include <toolbox/util/Random.hpp>
+#include <toolbox/util/Slab.hpp>
 #include <toolbox/util/Utility.hpp>
 #include <toolbox/util/Math.hpp>
 
@@ -376,4 +378,68 @@ TOOLBOX_BENCHMARK(stob_string)
     }
 }
 
+// Cost of allocating and then freeing a batch of connection-sized objects with the global
+// allocator, versus the slab allocator.
+constexpr size_t AllocBatch{64};
+
+TOOLBOX_BENCHMARK_ARGS(new_delete_batch, 64, 256, 1024)
+{
+    array<void*, AllocBatch> ptrs;
+    while (ctx) {
+        for (auto i : ctx.range(AllocBatch)) {
+            ptrs[i] = ::operator new(ctx.arg());
+            bm::do_not_optimise(ptrs[i]);
+        }
+        for (auto* ptr : ptrs) {
+            ::operator delete(ptr, ctx.arg());
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK_ARGS(slab_batch, 64, 256, 1024)
+{
+    array<void*, AllocBatch> ptrs;
+    while (ctx) {
+        for (auto i : ctx.range(AllocBatch)) {
+            ptrs[i] = slab_allocate(ctx.arg());
+            bm::do_not_optimise(ptrs[i]);
+        }
+        for (auto* ptr : ptrs) {
+            slab_deallocate(ptr, ctx.arg());
+        }
+    }
+}
+
+// Cost of building a temporary vector of strings per event, using the global allocator versus an
+// arena that is reset after each event.
+TOOLBOX_BENCHMARK(scratch_vector_new)
+{
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(100)) {
+            vector<string> v;
+            for (int i{0}; i < 16; ++i) {
+                v.emplace_back("a string that does not fit in the small buffer");
+            }
+            bm::do_not_optimise(v.data());
+        }
+    }
+}
+
+TOOLBOX_BENCHMARK(scratch_vector_arena)
+{
+    Arena arena;
+    while (ctx) {
+        for ([[maybe_unused]] auto _ : ctx.range(100)) {
+            {
+                pmr::vector<pmr::string> v{&arena};
+                for (int i{0}; i < 16; ++i) {
+                    v.emplace_back("a string that does not fit in the small buffer");
+                }
+                bm::do_not_optimise(v.data());
+            }
+            arena.reset();
+        }
+    }
+}
+
 } // namespace
@@ -18,8 +18,12 @@
 
 #include "bm/Benchmark.hpp"
 #include "bm/Context.hpp"
+#include "bm/Counters.hpp"
+#include "bm/Environment.hpp"
 #include "bm/Range.hpp"
 #include "bm/Record.hpp"
+#include "bm/Reporter.hpp"
+#include "bm/Stats.hpp"
 #include "bm/Suite.hpp"
 #include "bm/Utility.hpp"
 
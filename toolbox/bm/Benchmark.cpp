@@ -16,6 +16,7 @@
 #include "Benchmark.hpp"
 
 #include <toolbox/bm/Suite.hpp>
+#include <toolbox/sys/Time.hpp>
 
 #include <toolbox/util/Options.hpp>
 
@@ -44,18 +45,19 @@ class BenchmarkStore {
     }
     void list(ostream& os) const
     {
-        for (const auto& runnable : store_) {
-            os << runnable.first << '\n';
+        for (const auto& [name, instance] : store_) {
+            os << name << '\n';
         }
     }
-    void run(ostream& os, const string& regex_str, bool randomise)
+    int run(ostream& os, const string& regex_str, bool randomise, const BenchmarkOptions& opts,
+            const string& baseline_path, const string& save_path)
     {
-        vector<Benchmark*> filtered;
+        vector<const pair<const string, Instance>*> filtered;
 
         regex regex{regex_str};
-        for (const auto& bm : store_) {
-            if (regex_search(bm.first, regex)) {
-                filtered.push_back(bm.second);
+        for (const auto& entry : store_) {
+            if (regex_search(entry.first, regex)) {
+                filtered.push_back(&entry);
             }
         }
 
@@ -64,27 +66,64 @@ class BenchmarkStore {
             shuffle(begin(filtered), end(filtered), rng);
         }
 
+        int regressions{0};
         if (!filtered.empty()) {
-            BenchmarkSuite suite{os, 1000.0};
-            for (auto* bm : filtered) {
-                suite.run(bm->name, bm->fn);
+            Baseline baseline;
+            if (!baseline_path.empty()) {
+                baseline = read_baseline(baseline_path);
+            }
+            BenchmarkSuite suite{os, 1000.0, opts, baseline_path.empty() ? nullptr : &baseline};
+            for (const auto* entry : filtered) {
+                const auto& [name, instance] = *entry;
+                suite.run(name.c_str(), instance.fn, instance.params);
+            }
+            if (!save_path.empty()) {
+                write_baseline(save_path, suite.results());
+            }
+            regressions = suite.regressions();
+        }
+        return regressions;
+    }
+    void store(const Benchmark& bm)
+    {
+        const vector<int64_t> args{bm.args.empty() ? vector<int64_t>{0} : bm.args};
+        const vector<int> threads{bm.threads.empty() ? vector<int>{1} : bm.threads};
+        for (const auto arg : args) {
+            for (const auto n : threads) {
+                if (n < 1) {
+                    throw invalid_argument{"invalid thread count for benchmark: "s + bm.name};
+                }
+                string name{bm.name};
+                if (!bm.args.empty()) {
+                    name += '/' + std::to_string(arg);
+                }
+                if (!bm.threads.empty()) {
+                    name += "/threads:" + std::to_string(n);
+                }
+                store_.insert_or_assign(move(name), Instance{bm.fn, {.arg = arg, .threads = n}});
             }
         }
     }
-    void store(const char* name, Benchmark& bm) { store_.insert_or_assign(name, &bm); }
 
   private:
+    struct Instance {
+        void (*fn)(Context&);
+        BenchmarkParams params;
+    };
     BenchmarkStore() = default;
 
-    map<const char*, Benchmark*> store_;
+    map<string, Instance> store_;
 };
 } // namespace
 
-Benchmark::Benchmark(const char* name, void (*fn)(Context&))
+Benchmark::Benchmark(const char* name, void (*fn)(Context&), vector<int64_t> args,
+                     vector<int> threads)
 : name{name}
 , fn{fn}
+, args{move(args)}
+, threads{move(threads)}
 {
-    BenchmarkStore::instance().store(name, *this);
+    BenchmarkStore::instance().store(*this);
 }
 
 namespace detail {
@@ -95,6 +134,14 @@ int main(int argc, char* argv[])
         string regex;
         bool list{false};
         bool randomise{false};
+        int warmup_ms{0};
+        int duration_ms{3000};
+        BenchmarkOptions bm_opts;
+        string baseline_path;
+        string save_path;
+        string format{"text"};
+        vector<double> percentiles;
+        bool mono{false};
 
         Options opts{"benchmark options [options]"};
         // clang-format off
@@ -102,6 +149,21 @@ int main(int argc, char* argv[])
             ('l', "list", Switch{list}, "list available benchmarks")
             ('h', "help", Help{})
             ('r', "random", Switch{randomise}, "run benchmarks in random order")
+            ('w', "warmup", Value{warmup_ms}, "warm-up time in milliseconds before measuring")
+            ('d', "duration", Value{duration_ms}, "duration of each repetition in milliseconds")
+            ('n', "iterations", Value{bm_opts.iterations},
+             "number of samples per repetition, instead of duration")
+            ('k', "repetitions", Value{bm_opts.repetitions}, "number of repetitions")
+            ('b', "baseline", Value{baseline_path},
+             "compare results with baseline file and fail on regression")
+            ('s', "save", Value{save_path}, "save results to baseline file")
+            ('o', "format", Value{format}, "report format: text, json or csv")
+            ('p', "percentile", Value{percentiles}.multitoken(),
+             "percentile reported in json and csv formats; may be repeated")
+            ('c', "counters", Switch{bm_opts.perf_counters},
+             "collect hardware performance counters per iteration")
+            ('m', "mono", Switch{mono},
+             "time with the monotonic clock instead of the calibrated tsc")
             ;
         // clang-format on
 
@@ -112,7 +174,23 @@ int main(int argc, char* argv[])
             store.list(cout);
             return 0;
         }
-        store.run(cout, regex, randomise);
+        // Benchmarks are timed with the TSC clock, which falls back to MonoClock if it is not
+        // calibrated.
+        if (!mono && !TscClock::calibrate()) {
+            cerr << "warning: invariant tsc not available; using monotonic clock\n";
+        }
+        bm_opts.warmup = chrono::milliseconds{warmup_ms};
+        bm_opts.duration = chrono::milliseconds{duration_ms};
+        bm_opts.format = parse_report_format(format);
+        if (!percentiles.empty()) {
+            bm_opts.percentiles = move(percentiles);
+        }
+        const int regressions{
+            store.run(cout, regex, randomise, bm_opts, baseline_path, save_path)};
+        if (regressions > 0) {
+            cerr << regressions << " regression(s) detected\n";
+            return 1;
+        }
         ret = 0;
     } catch (const exception& e) {
         cerr << "error: " << e.what();
@@ -18,13 +18,26 @@
 
 #include <toolbox/Config.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace toolbox::bm {
 class Context;
 
+/// A registered benchmark function.
+///
+/// A benchmark is expanded into one instance for each combination of argument and thread count.
+/// Instance names are suffixed with "/<arg>" if args is non-empty, and "/threads:<n>" if threads
+/// is non-empty.
 struct TOOLBOX_API Benchmark {
-    Benchmark(const char* name, void (*fn)(Context&));
+    Benchmark(const char* name, void (*fn)(Context&), std::vector<std::int64_t> args = {},
+              std::vector<int> threads = {});
     const char* const name;
     void (*fn)(Context&);
+    /// Arguments passed to each instance via Context::arg().
+    const std::vector<std::int64_t> args;
+    /// Number of threads for each instance.
+    const std::vector<int> threads;
 };
 
 namespace detail {
@@ -39,6 +52,22 @@ TOOLBOX_API int main(int argc, char* argv[]);
     }                                                                                              \
     void benchmark::NAME::fn(toolbox::bm::Context& ctx)
 
+/// Register a benchmark that is run once for each of the arguments that follow the name.
+#define TOOLBOX_BENCHMARK_ARGS(NAME, ...)                                                          \
+    namespace benchmark::NAME {                                                                    \
+    void fn(::toolbox::bm::Context& ctx);                                                          \
+    ::toolbox::bm::Benchmark bm{#NAME, fn, {__VA_ARGS__}};                                         \
+    }                                                                                              \
+    void benchmark::NAME::fn(toolbox::bm::Context& ctx)
+
+/// Register a benchmark that is run concurrently on each of the thread counts that follow the name.
+#define TOOLBOX_BENCHMARK_THREADS(NAME, ...)                                                       \
+    namespace benchmark::NAME {                                                                    \
+    void fn(::toolbox::bm::Context& ctx);                                                          \
+    ::toolbox::bm::Benchmark bm{#NAME, fn, {}, {__VA_ARGS__}};                                     \
+    }                                                                                              \
+    void benchmark::NAME::fn(toolbox::bm::Context& ctx)
+
 #define TOOLBOX_BENCHMARK_MAIN                                                                     \
     int main(int argc, char* argv[])                                                               \
     {                                                                                              \
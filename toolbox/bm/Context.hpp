@@ -17,14 +17,38 @@
 #define TOOLBOX_BM_CONTEXT
 
 #include <toolbox/bm/Range.hpp>
+#include <toolbox/hdr/Histogram.hpp>
 #include <toolbox/util/Alarm.hpp>
 
+#include <algorithm>
+#include <chrono>
+
 namespace toolbox::bm {
 
+/// Parameters of a single benchmark instance.
+struct BenchmarkParams {
+    /// Argument of a parameterised benchmark, such as a message or container size.
+    std::int64_t arg{0};
+    /// Number of threads that run the benchmark concurrently.
+    int threads{1};
+};
+
 class TOOLBOX_API Context {
   public:
-    explicit Context(Histogram& hist)
+    /// Construct Context.
+    ///
+    /// \param hist The histogram that samples are recorded in.
+    /// \param max_count Stop once this number of samples has been recorded. Zero means no limit.
+    /// \param perf Optional hardware counters, which are sampled by each range.
+    /// \param params The benchmark instance parameters.
+    /// \param thread_index The index of the calling thread, in the range [0, params.threads).
+    explicit Context(Histogram& hist, std::int64_t max_count = 0, PerfCounters* perf = nullptr,
+                     BenchmarkParams params = {}, int thread_index = 0)
     : hist_{hist}
+    , max_count_{max_count}
+    , perf_{perf}
+    , params_{params}
+    , thread_index_{thread_index}
     {
     }
     ~Context() = default;
@@ -37,14 +61,38 @@ class TOOLBOX_API Context {
     Context(Context&&) = delete;
     Context& operator=(Context&&) = delete;
 
-    explicit operator bool() const noexcept { return !stop_; }
-    BenchmarkRange range(int first, int last) const noexcept { return {hist_, first, last}; }
-    BenchmarkRange range(int count) const noexcept { return {hist_, 0, count}; }
+    explicit operator bool() const noexcept
+    {
+        return !stop_ && (max_count_ == 0 || hist_.total_count() < max_count_);
+    }
+    BenchmarkRange range(int first, int last) const noexcept
+    {
+        return {hist_, first, last, perf_};
+    }
+    BenchmarkRange range(int count) const noexcept { return {hist_, 0, count, perf_}; }
+
+    /// Record a latency that was measured by the benchmark itself, rather than by a range. This is
+    /// useful when the interval of interest starts or ends on another thread, or in a callback.
+    void record(std::chrono::nanoseconds latency) noexcept
+    {
+        hist_.record_value(std::max<std::int64_t>(latency.count(), 0));
+    }
+
+    /// Returns the argument of a parameterised benchmark, or zero.
+    std::int64_t arg() const noexcept { return params_.arg; }
+    /// Returns the number of threads running the benchmark.
+    int threads() const noexcept { return params_.threads; }
+    /// Returns the index of the calling thread, which is zero for single-threaded benchmarks.
+    int thread_index() const noexcept { return thread_index_; }
 
     void stop() noexcept { stop_ = true; }
 
   private:
     Histogram& hist_;
+    const std::int64_t max_count_;
+    PerfCounters* const perf_;
+    const BenchmarkParams params_;
+    const int thread_index_;
     std::atomic_bool stop_{false};
 };
 
@@ -0,0 +1,126 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Counters.hpp"
+
+#include <toolbox/io/PerfEvent.hpp>
+
+#include <cstring>
+
+namespace toolbox::bm {
+using namespace std;
+namespace {
+
+constexpr array<uint64_t, PerfEventCount> Configs{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+perf_event_attr make_attr(uint64_t config, bool leader) noexcept
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    if (leader) {
+        // The group is enabled once all members have been added. Pinning the leader ensures that
+        // the group is never multiplexed, so readings need no scaling.
+        attr.disabled = 1;
+        attr.pinned = 1;
+    }
+    return attr;
+}
+
+} // namespace
+
+string_view to_string(PerfEvent ev) noexcept
+{
+    switch (ev) {
+    case PerfEvent::Cycles:
+        return "cycles";
+    case PerfEvent::Instructions:
+        return "instructions";
+    case PerfEvent::CacheMisses:
+        return "cache_misses";
+    case PerfEvent::BranchMisses:
+        return "branch_misses";
+    }
+    return "unknown";
+}
+
+PerfCounters::PerfCounters() noexcept
+{
+    pos_.fill(-1);
+    int leader{-1};
+    for (size_t i{0}; i < PerfEventCount; ++i) {
+        error_code ec;
+        auto fd = os::perf_event_open(make_attr(Configs[i], leader < 0), 0, -1, leader, 0, ec);
+        if (ec) {
+            if (i == 0) {
+                // The group cannot be created without the leader.
+                ec_ = ec;
+                return;
+            }
+            continue;
+        }
+        if (leader < 0) {
+            leader = fd.get();
+        }
+        pos_[i] = nr_++;
+        totals_.mask |= 1U << i;
+        fds_[i] = move(fd);
+    }
+    os::perf_event_ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP, ec_);
+    if (!ec_) {
+        os::perf_event_ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP, ec_);
+    }
+    if (ec_) {
+        for (auto& fd : fds_) {
+            fd.reset();
+        }
+        totals_.mask = 0;
+    }
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::read(PerfValues& values) const noexcept
+{
+    // Layout for PERF_FORMAT_GROUP: the number of events followed by each value.
+    array<uint64_t, 1 + PerfEventCount> buf;
+    const auto size = static_cast<ssize_t>((1 + nr_) * sizeof(uint64_t));
+    if (!available() || ::read(fds_[0].get(), buf.data(), size) != size) {
+        values.fill(0);
+        return;
+    }
+    for (size_t i{0}; i < PerfEventCount; ++i) {
+        values[i] = pos_[i] >= 0 ? buf[1 + pos_[i]] : 0;
+    }
+}
+
+void PerfCounters::reset_totals() noexcept
+{
+    const auto mask = totals_.mask;
+    totals_ = {};
+    totals_.mask = mask;
+}
+
+} // namespace toolbox::bm
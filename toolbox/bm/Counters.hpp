@@ -0,0 +1,115 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_BM_COUNTERS_HPP
+#define TOOLBOX_BM_COUNTERS_HPP
+
+#include <toolbox/io/Handle.hpp>
+
+#include <toolbox/Config.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+namespace toolbox::bm {
+
+/// Hardware events counted by PerfCounters.
+enum class PerfEvent : int { Cycles, Instructions, CacheMisses, BranchMisses };
+constexpr std::size_t PerfEventCount{4};
+
+/// Returns a short name for the event.
+TOOLBOX_API std::string_view to_string(PerfEvent ev) noexcept;
+
+using PerfValues = std::array<std::uint64_t, PerfEventCount>;
+
+/// Counter totals accumulated over a number of iterations.
+struct PerfTotals {
+    PerfValues values{};
+    std::int64_t iterations{0};
+    /// Bit set of events that are being counted.
+    unsigned mask{0};
+
+    bool has(PerfEvent ev) const noexcept { return mask & (1U << static_cast<int>(ev)); }
+    /// Returns the average count per iteration.
+    double per_iteration(PerfEvent ev) const noexcept
+    {
+        const auto i = static_cast<std::size_t>(ev);
+        return iterations > 0 ? double(values[i]) / iterations : 0.0;
+    }
+};
+
+/// Group of hardware performance counters for the calling thread, which count user-space events
+/// only.
+///
+/// The counters are opened with perf_event_open(2). If the kernel does not permit access, for
+/// example because of the perf_event_paranoid setting or because the machine is virtualised
+/// without a PMU, then the object is left unavailable and error() describes the reason. Events
+/// that are not supported by the hardware are silently omitted from the group.
+class TOOLBOX_API PerfCounters {
+  public:
+    PerfCounters() noexcept;
+    ~PerfCounters();
+
+    // Copy.
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Move.
+    PerfCounters(PerfCounters&&) = delete;
+    PerfCounters& operator=(PerfCounters&&) = delete;
+
+    bool available() const noexcept { return !fds_[0].empty(); }
+    const std::error_code& error() const noexcept { return ec_; }
+    const PerfTotals& totals() const noexcept { return totals_; }
+
+    /// Reads the current counter values with a single system call.
+    void read(PerfValues& values) const noexcept;
+
+    /// Adds the difference between two readings to the totals.
+    ///
+    /// \param start The reading at the start of the measurement.
+    /// \param end The reading at the end of the measurement.
+    /// \param count The number of iterations measured.
+    void accumulate(const PerfValues& start, const PerfValues& end, int count) noexcept
+    {
+        for (std::size_t i{0}; i < PerfEventCount; ++i) {
+            totals_.values[i] += end[i] - start[i];
+        }
+        totals_.iterations += count;
+    }
+    /// Adds totals accumulated by counters on another thread.
+    void add_totals(const PerfTotals& totals) noexcept
+    {
+        for (std::size_t i{0}; i < PerfEventCount; ++i) {
+            totals_.values[i] += totals.values[i];
+        }
+        totals_.iterations += totals.iterations;
+    }
+    void reset_totals() noexcept;
+
+  private:
+    std::array<FileHandle, PerfEventCount> fds_;
+    /// Position of each event in the group read, or -1 if the event is not counted.
+    std::array<int, PerfEventCount> pos_;
+    int nr_{0};
+    std::error_code ec_;
+    PerfTotals totals_;
+};
+
+} // namespace toolbox::bm
+
+#endif // TOOLBOX_BM_COUNTERS_HPP
@@ -0,0 +1,103 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Environment.hpp"
+
+#include <toolbox/sys/Time.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace toolbox::bm {
+using namespace std;
+namespace {
+
+string read_line(const char* path)
+{
+    string line;
+    ifstream is{path};
+    getline(is, line);
+    return line;
+}
+
+string get_cpu_model()
+{
+    ifstream is{"/proc/cpuinfo"};
+    string line;
+    while (getline(is, line)) {
+        if (line.starts_with("model name")) {
+            const auto pos = line.find(':');
+            if (pos != string::npos) {
+                const auto start = line.find_first_not_of(' ', pos + 1);
+                return start != string::npos ? line.substr(start) : string{};
+            }
+        }
+    }
+    return {};
+}
+
+string get_hostname()
+{
+    char buf[256];
+    if (::gethostname(buf, sizeof(buf)) < 0) {
+        return {};
+    }
+    buf[sizeof(buf) - 1] = '\0';
+    return buf;
+}
+
+string get_date()
+{
+    const auto now = chrono::system_clock::to_time_t(chrono::system_clock::now());
+    tm t;
+    localtime_r(&now, &t);
+    stringstream ss;
+    ss << std::put_time(&t, "%Y-%m-%dT%H:%M:%S%z");
+    return ss.str();
+}
+
+} // namespace
+
+Environment get_environment()
+{
+    Environment env;
+    env.version = TOOLBOX_VERSION;
+#if defined(__clang__)
+    env.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    env.compiler = "gcc " __VERSION__;
+#endif
+#if TOOLBOX_BUILD_DEBUG
+    env.build_type = "debug";
+#else
+    env.build_type = "release";
+#endif
+    env.hostname = get_hostname();
+    env.date = get_date();
+    env.cpu_model = get_cpu_model();
+    env.cpu_count = static_cast<int>(thread::hardware_concurrency());
+    env.governor = read_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+    env.isolated_cpus = read_line("/sys/devices/system/cpu/isolated");
+    env.clock = TscClock::is_calibrated() ? "tsc" : "mono";
+    env.tsc_frequency = TscClock::frequency();
+    return env;
+}
+
+} // namespace toolbox::bm
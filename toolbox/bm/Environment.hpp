@@ -0,0 +1,52 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_BM_ENVIRONMENT_HPP
+#define TOOLBOX_BM_ENVIRONMENT_HPP
+
+#include <toolbox/Config.h>
+
+#include <string>
+
+namespace toolbox::bm {
+
+/// Description of the machine and build that benchmarks were run on.
+///
+/// Fields that cannot be determined on the current machine are left empty.
+struct TOOLBOX_API Environment {
+    std::string version;
+    std::string compiler;
+    std::string build_type;
+    std::string hostname;
+    /// Local time that the benchmark run started, in ISO 8601 format.
+    std::string date;
+    std::string cpu_model;
+    int cpu_count{0};
+    /// CPU frequency scaling governor of the first CPU.
+    std::string governor;
+    /// CPUs isolated from the scheduler, in cpu list format.
+    std::string isolated_cpus;
+    /// Clock used to time benchmarks: "tsc" if the TSC clock is calibrated, otherwise "mono".
+    std::string clock;
+    /// Calibrated TSC frequency in Hz, or zero if the TSC clock is not used.
+    double tsc_frequency{0.0};
+};
+
+/// Returns the environment of the current process.
+TOOLBOX_API Environment get_environment();
+
+} // namespace toolbox::bm
+
+#endif // TOOLBOX_BM_ENVIRONMENT_HPP
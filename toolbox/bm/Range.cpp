@@ -22,22 +22,35 @@
 namespace toolbox::bm {
 using namespace std;
 
-BenchmarkRange::BenchmarkRange(Histogram& hist, int first, int last) noexcept
+BenchmarkRange::BenchmarkRange(Histogram& hist, int first, int last, PerfCounters* perf) noexcept
 : hist_{hist}
 , first_{first}
 , last_{last}
-, start_{chrono::high_resolution_clock::now()}
+, perf_{perf}
 {
     assert(first < last);
+    if (perf_) {
+        perf_->read(perf_start_);
+    }
+    // Take the start time last, so that reading the counters is not timed.
+    start_ = TscClock::now();
 }
 
 BenchmarkRange::~BenchmarkRange()
 {
-    const auto end = chrono::high_resolution_clock::now();
-    const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(end - start_);
+    const auto end = TscClock::now();
+    // Read the counters before recording, so that recording is not counted as benchmark work.
+    PerfValues perf_end;
+    if (perf_) {
+        perf_->read(perf_end);
+    }
+    const auto elapsed = end - start_;
     const auto count = last_ - first_;
     // Record average.
     hist_.record_values(elapsed.count() / count, count);
+    if (perf_) {
+        perf_->accumulate(perf_start_, perf_end, count);
+    }
 }
 
 } // namespace toolbox::bm
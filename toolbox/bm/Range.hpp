@@ -16,9 +16,10 @@
 #ifndef TOOLBOX_BM_RANGE
 #define TOOLBOX_BM_RANGE
 
-#include <toolbox/Config.h>
+#include <toolbox/bm/Counters.hpp>
+#include <toolbox/sys/Time.hpp>
 
-#include <chrono>
+#include <toolbox/Config.h>
 
 namespace toolbox {
 inline namespace hdr {
@@ -31,6 +32,8 @@ namespace toolbox::bm {
 /// The BenchmarkRange class records the time elapsed during object lifetime,
 /// i.e., between construction and destruction.
 /// The elapsed time is recorded in the Histogram object during destruction.
+/// If hardware counters are supplied, then they are read either side of the timed region and the
+/// difference is accumulated in the counter totals.
 class TOOLBOX_API BenchmarkRange {
     class Iterator {
         friend constexpr bool operator==(Iterator lhs, Iterator rhs) noexcept
@@ -59,7 +62,7 @@ class TOOLBOX_API BenchmarkRange {
     };
 
   public:
-    BenchmarkRange(Histogram& hist, int first, int last) noexcept;
+    BenchmarkRange(Histogram& hist, int first, int last, PerfCounters* perf = nullptr) noexcept;
     ~BenchmarkRange();
 
     // Copy.
@@ -77,7 +80,9 @@ class TOOLBOX_API BenchmarkRange {
     Histogram& hist_;
     const int first_;
     const int last_;
-    std::chrono::time_point<std::chrono::high_resolution_clock> start_;
+    PerfCounters* const perf_;
+    PerfValues perf_start_;
+    MonoTime start_;
 };
 
 } // namespace toolbox::bm
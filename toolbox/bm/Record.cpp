@@ -25,15 +25,15 @@ using namespace std;
 BenchmarkRecord::BenchmarkRecord(Histogram& hist, int count) noexcept
 : hist_{hist}
 , count_{count}
-, start_{chrono::high_resolution_clock::now()}
+, start_{TscClock::now()}
 {
     assert(count >= 1);
 }
 
 BenchmarkRecord::~BenchmarkRecord()
 {
-    const auto end = chrono::high_resolution_clock::now();
-    const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(end - start_);
+    const auto end = TscClock::now();
+    const auto elapsed = end - start_;
     // Record average.
     hist_.record_values(elapsed.count() / count_, count_);
 }
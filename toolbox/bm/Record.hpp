@@ -16,9 +16,9 @@
 #ifndef TOOLBOX_BM_RECORD
 #define TOOLBOX_BM_RECORD
 
-#include <toolbox/Config.h>
+#include <toolbox/sys/Time.hpp>
 
-#include <chrono>
+#include <toolbox/Config.h>
 
 namespace toolbox {
 inline namespace hdr {
@@ -47,7 +47,7 @@ class TOOLBOX_API BenchmarkRecord {
   private:
     Histogram& hist_;
     const int count_;
-    std::chrono::time_point<std::chrono::high_resolution_clock> start_;
+    MonoTime start_;
 };
 
 } // namespace toolbox::bm
@@ -0,0 +1,418 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Reporter.hpp"
+
+#include <toolbox/bm/Counters.hpp>
+#include <toolbox/bm/Environment.hpp>
+
+#include <toolbox/hdr/Utility.hpp>
+
+#include <boost/io/ios_state.hpp>
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace toolbox::bm {
+using namespace std;
+namespace {
+
+void put_json_string(ostream& os, string_view sv)
+{
+    boost::io::ios_all_saver all_saver{os};
+    os << '"';
+    for (const char c : sv) {
+        switch (c) {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                os << "\\u" << hex << setw(4) << setfill('0') << int{c};
+            } else {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+// JSON has no representation for NaN or infinity, so non-finite values are written as null.
+void put_json_number(ostream& os, double val)
+{
+    if (isfinite(val)) {
+        os << val;
+    } else {
+        os << "null";
+    }
+}
+
+void put_csv_string(ostream& os, string_view sv)
+{
+    if (sv.find_first_of(",\"\n") == string_view::npos) {
+        os << sv;
+        return;
+    }
+    os << '"';
+    for (const char c : sv) {
+        if (c == '"') {
+            os << '"';
+        }
+        os << c;
+    }
+    os << '"';
+}
+
+double change_pct(const Sample& base, const Sample& cur) noexcept
+{
+    return base.median > 0 ? (cur.median / base.median - 1.0) * 100.0 : 0.0;
+}
+
+constexpr PerfEvent PerfEvents[]{PerfEvent::Cycles, PerfEvent::Instructions,
+                                 PerfEvent::CacheMisses, PerfEvent::BranchMisses};
+
+double ipc(const PerfTotals& perf) noexcept
+{
+    const auto cycles = perf.values[static_cast<size_t>(PerfEvent::Cycles)];
+    const auto insns = perf.values[static_cast<size_t>(PerfEvent::Instructions)];
+    return cycles > 0 ? double(insns) / cycles : 0.0;
+}
+
+class TextReporter final : public Reporter {
+  public:
+    TextReporter(ostream& os, double value_scale)
+    : os_{os}
+    , value_scale_{value_scale}
+    {
+    }
+    ~TextReporter() override = default;
+
+    void begin(const Environment& /*env*/, ReportColumns cols) override
+    {
+        boost::io::ios_all_saver all_saver{os_};
+        cols_ = cols;
+
+        // clang-format off
+        os_ << left << setw(45) << "NAME"
+            << right << setw(15) << "COUNT"
+            << right << setw(10) << "MIN"
+            << right << setw(10) << "%50"
+            << right << setw(10) << "%95"
+            << right << setw(10) << "%99"
+            << right << setw(10) << "%99.9"
+            << right << setw(10) << "%99.99"
+            << right << setw(10) << "MEDIAN"
+            << right << setw(10) << "MAD";
+        // clang-format on
+        int width{140};
+        if (cols_.perf) {
+            // clang-format off
+            os_ << right << setw(10) << "CYC/IT"
+                << right << setw(10) << "INS/IT"
+                << right << setw(10) << "IPC"
+                << right << setw(10) << "CMISS/IT"
+                << right << setw(10) << "BMISS/IT";
+            // clang-format on
+            width += 50;
+        }
+        if (cols_.baseline) {
+            os_ << right << setw(10) << "CHANGE";
+            width += 10;
+        }
+        os_ << endl;
+
+        // Separator.
+        os_ << setw(width) << setfill('-') << '-' << setfill(' ') << endl;
+    }
+    void report(const BenchmarkResult& r) override
+    {
+        boost::io::ios_all_saver all_saver{os_};
+        const auto& h = r.hist;
+
+        // clang-format off
+        os_ << left << setw(45) << r.name
+            << right << setw(15) << h.total_count()
+            << right << setw(10) << h.min() / value_scale_
+            << right << setw(10) << value_at_percentile(h, 50) / value_scale_
+            << right << setw(10) << value_at_percentile(h, 95) / value_scale_
+            << right << setw(10) << value_at_percentile(h, 99) / value_scale_
+            << right << setw(10) << value_at_percentile(h, 99.9) / value_scale_
+            << right << setw(10) << value_at_percentile(h, 99.99) / value_scale_
+            << right << setw(10) << r.sample.median / value_scale_
+            << right << setw(10) << r.sample.mad / value_scale_;
+        // clang-format on
+
+        if (cols_.perf) {
+            put_perf(r.perf);
+        }
+        if (cols_.baseline) {
+            if (r.baseline) {
+                os_ << right << setw(9) << fixed << setprecision(1) << showpos
+                    << change_pct(*r.baseline, r.sample) << '%' << noshowpos;
+                if (r.regression) {
+                    os_ << " REGRESSION";
+                }
+            } else {
+                os_ << right << setw(10) << '-';
+            }
+        }
+        os_ << endl;
+    }
+    void end() override {}
+
+  private:
+    void put_perf(const PerfTotals* perf)
+    {
+        boost::io::ios_all_saver all_saver{os_};
+        os_ << fixed << setprecision(2);
+        for (const auto ev : PerfEvents) {
+            if (perf && perf->has(ev)) {
+                os_ << right << setw(10) << perf->per_iteration(ev);
+            } else {
+                os_ << right << setw(10) << '-';
+            }
+            if (ev == PerfEvent::Instructions) {
+                if (perf && perf->has(PerfEvent::Cycles) && perf->has(PerfEvent::Instructions)) {
+                    os_ << right << setw(10) << ipc(*perf);
+                } else {
+                    os_ << right << setw(10) << '-';
+                }
+            }
+        }
+    }
+
+    ostream& os_;
+    const double value_scale_;
+    ReportColumns cols_;
+};
+
+class JsonReporter final : public Reporter {
+  public:
+    JsonReporter(ostream& os, vector<double> percentiles)
+    : os_{os}
+    , percentiles_{move(percentiles)}
+    {
+    }
+    ~JsonReporter() override = default;
+
+    void begin(const Environment& env, ReportColumns /*cols*/) override
+    {
+        os_ << "{\"context\":{\"version\":";
+        put_json_string(os_, env.version);
+        os_ << ",\"compiler\":";
+        put_json_string(os_, env.compiler);
+        os_ << ",\"build_type\":";
+        put_json_string(os_, env.build_type);
+        os_ << ",\"hostname\":";
+        put_json_string(os_, env.hostname);
+        os_ << ",\"date\":";
+        put_json_string(os_, env.date);
+        os_ << ",\"cpu_model\":";
+        put_json_string(os_, env.cpu_model);
+        os_ << ",\"cpu_count\":" << env.cpu_count;
+        os_ << ",\"governor\":";
+        put_json_string(os_, env.governor);
+        os_ << ",\"isolated_cpus\":";
+        put_json_string(os_, env.isolated_cpus);
+        os_ << ",\"clock\":";
+        put_json_string(os_, env.clock);
+        os_ << ",\"tsc_frequency\":";
+        put_json_number(os_, env.tsc_frequency);
+        os_ << ",\"unit\":\"ns\"},\n\"benchmarks\":[";
+    }
+    void report(const BenchmarkResult& r) override
+    {
+        boost::io::ios_all_saver all_saver{os_};
+        os_ << setprecision(numeric_limits<double>::max_digits10);
+
+        const auto s = summarise(r.hist, percentiles_);
+        os_ << (first_ ? "\n" : ",\n") << "{\"name\":";
+        put_json_string(os_, r.name);
+        os_ << ",\"count\":" << s.total_count //
+            << ",\"min\":" << s.min           //
+            << ",\"max\":" << s.max           //
+            << ",\"mean\":";
+        put_json_number(os_, s.mean);
+        os_ << ",\"stddev\":";
+        put_json_number(os_, s.stddev);
+        os_ << ",\"percentiles\":{";
+        for (size_t i{0}; i < percentiles_.size(); ++i) {
+            os_ << (i == 0 ? "" : ",") << "\"" << setprecision(6) << percentiles_[i]
+                << "\":" << s.values[i];
+        }
+        os_ << setprecision(numeric_limits<double>::max_digits10);
+        os_ << "},\"rate\":";
+        put_json_number(os_, r.rate);
+        os_ << ",\"median\":";
+        put_json_number(os_, r.sample.median);
+        os_ << ",\"mad\":";
+        put_json_number(os_, r.sample.mad);
+        os_ << ",\"repetitions\":" << r.sample.repetitions << ",\"baseline\":";
+        if (r.baseline) {
+            os_ << "{\"median\":";
+            put_json_number(os_, r.baseline->median);
+            os_ << ",\"mad\":";
+            put_json_number(os_, r.baseline->mad);
+            os_ << ",\"repetitions\":" << r.baseline->repetitions << ",\"change_pct\":";
+            put_json_number(os_, change_pct(*r.baseline, r.sample));
+            os_ << ",\"regression\":" << (r.regression ? "true" : "false") << '}';
+        } else {
+            os_ << "null";
+        }
+        os_ << ",\"counters\":";
+        if (r.perf) {
+            // Average counts per iteration.
+            os_ << '{';
+            bool first{true};
+            for (const auto ev : PerfEvents) {
+                if (r.perf->has(ev)) {
+                    os_ << (first ? "\"" : ",\"") << to_string(ev) << "\":";
+                    put_json_number(os_, r.perf->per_iteration(ev));
+                    first = false;
+                }
+            }
+            os_ << '}';
+        } else {
+            os_ << "null";
+        }
+        os_ << '}';
+        first_ = false;
+    }
+    void end() override { os_ << "\n]}" << endl; }
+
+  private:
+    ostream& os_;
+    const vector<double> percentiles_;
+    bool first_{true};
+};
+
+class CsvReporter final : public Reporter {
+  public:
+    CsvReporter(ostream& os, vector<double> percentiles)
+    : os_{os}
+    , percentiles_{move(percentiles)}
+    {
+    }
+    ~CsvReporter() override = default;
+
+    void begin(const Environment& env, ReportColumns cols) override
+    {
+        cols_ = cols;
+        // Metadata is written as comment lines, which most CSV readers can be told to skip.
+        os_ << "# version: " << env.version << '\n'
+            << "# compiler: " << env.compiler << '\n'
+            << "# build_type: " << env.build_type << '\n'
+            << "# hostname: " << env.hostname << '\n'
+            << "# date: " << env.date << '\n'
+            << "# cpu_model: " << env.cpu_model << '\n'
+            << "# cpu_count: " << env.cpu_count << '\n'
+            << "# governor: " << env.governor << '\n'
+            << "# isolated_cpus: " << env.isolated_cpus << '\n'
+            << "# clock: " << env.clock << '\n'
+            << "# tsc_frequency: " << env.tsc_frequency << '\n'
+            << "# unit: ns\n";
+        os_ << "name,count,min,max,mean,stddev";
+        for (const auto pct : percentiles_) {
+            os_ << ",p" << pct;
+        }
+        os_ << ",rate,median,mad,repetitions";
+        if (cols_.perf) {
+            for (const auto ev : PerfEvents) {
+                os_ << ',' << to_string(ev) << "_per_iter";
+            }
+        }
+        if (cols_.baseline) {
+            os_ << ",baseline_median,baseline_mad,change_pct,regression";
+        }
+        os_ << endl;
+    }
+    void report(const BenchmarkResult& r) override
+    {
+        boost::io::ios_all_saver all_saver{os_};
+        os_ << setprecision(numeric_limits<double>::max_digits10);
+
+        const auto s = summarise(r.hist, percentiles_);
+        put_csv_string(os_, r.name);
+        os_ << ',' << s.total_count << ',' << s.min << ',' << s.max << ',' << s.mean << ','
+            << s.stddev;
+        for (const auto v : s.values) {
+            os_ << ',' << v;
+        }
+        os_ << ',' << r.rate << ',' << r.sample.median << ',' << r.sample.mad << ','
+            << r.sample.repetitions;
+        if (cols_.perf) {
+            for (const auto ev : PerfEvents) {
+                os_ << ',';
+                if (r.perf && r.perf->has(ev)) {
+                    os_ << r.perf->per_iteration(ev);
+                }
+            }
+        }
+        if (cols_.baseline) {
+            if (r.baseline) {
+                os_ << ',' << r.baseline->median << ',' << r.baseline->mad << ','
+                    << change_pct(*r.baseline, r.sample) << ',' << (r.regression ? 1 : 0);
+            } else {
+                os_ << ",,,,";
+            }
+        }
+        os_ << endl;
+    }
+    void end() override {}
+
+  private:
+    ostream& os_;
+    const vector<double> percentiles_;
+    ReportColumns cols_;
+};
+
+} // namespace
+
+ReportFormat parse_report_format(string_view sv)
+{
+    if (sv == "text") {
+        return ReportFormat::Text;
+    }
+    if (sv == "json") {
+        return ReportFormat::Json;
+    }
+    if (sv == "csv") {
+        return ReportFormat::Csv;
+    }
+    throw invalid_argument{"invalid report format: " + string{sv}};
+}
+
+Reporter::~Reporter() = default;
+
+unique_ptr<Reporter> make_reporter(ReportFormat format, ostream& os, double value_scale,
+                                   vector<double> percentiles)
+{
+    switch (format) {
+    case ReportFormat::Text:
+        break;
+    case ReportFormat::Json:
+        return make_unique<JsonReporter>(os, move(percentiles));
+    case ReportFormat::Csv:
+        return make_unique<CsvReporter>(os, move(percentiles));
+    }
+    return make_unique<TextReporter>(os, value_scale);
+}
+
+} // namespace toolbox::bm
@@ -0,0 +1,107 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_BM_REPORTER_HPP
+#define TOOLBOX_BM_REPORTER_HPP
+
+#include <toolbox/bm/Stats.hpp>
+
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace toolbox {
+inline namespace hdr {
+class Histogram;
+} // namespace hdr
+} // namespace toolbox
+
+namespace toolbox::bm {
+struct Environment;
+struct PerfTotals;
+
+enum class ReportFormat { Text, Json, Csv };
+
+/// Parses a report format name: "text", "json" or "csv".
+///
+/// \throws std::invalid_argument if the name is not recognised.
+TOOLBOX_API ReportFormat parse_report_format(std::string_view sv);
+
+/// Result of a single benchmark.
+struct BenchmarkResult {
+    const char* name;
+    /// Histogram of samples, in nanoseconds, merged across all repetitions.
+    const Histogram& hist;
+    Sample sample;
+    /// Number of samples recorded per second of measured time.
+    double rate;
+    /// Baseline sample, or null if there is no baseline for this benchmark.
+    const Sample* baseline;
+    /// True if the sample is a significant regression against the baseline.
+    bool regression;
+    /// Hardware counter totals, or null if counters are not enabled.
+    const PerfTotals* perf;
+};
+
+/// Optional columns included in a report.
+struct ReportColumns {
+    /// Comparison with a baseline.
+    bool baseline{false};
+    /// Hardware counters per iteration.
+    bool perf{false};
+};
+
+/// Reporters write benchmark results in a specific format.
+class TOOLBOX_API Reporter {
+  public:
+    Reporter() noexcept = default;
+    virtual ~Reporter();
+
+    // Copy.
+    Reporter(const Reporter&) = delete;
+    Reporter& operator=(const Reporter&) = delete;
+
+    // Move.
+    Reporter(Reporter&&) = delete;
+    Reporter& operator=(Reporter&&) = delete;
+
+    /// Called once before any results are reported.
+    ///
+    /// \param env The environment that the benchmarks are run in.
+    /// \param cols The optional columns included in the report.
+    virtual void begin(const Environment& env, ReportColumns cols) = 0;
+    virtual void report(const BenchmarkResult& result) = 0;
+    /// Called once after all results have been reported.
+    virtual void end() = 0;
+};
+
+/// Create a reporter for the specified format.
+///
+/// The text format is intended for humans, and scales values by value_scale. The JSON and CSV
+/// formats are intended for tools. They include environment metadata and report all values in
+/// nanoseconds.
+///
+/// \param format The report format.
+/// \param os The output stream.
+/// \param value_scale Divisor applied to nanosecond values in the text format.
+/// \param percentiles The percentiles reported by the JSON and CSV formats.
+TOOLBOX_API std::unique_ptr<Reporter> make_reporter(ReportFormat format, std::ostream& os,
+                                                    double value_scale,
+                                                    std::vector<double> percentiles);
+
+} // namespace toolbox::bm
+
+#endif // TOOLBOX_BM_REPORTER_HPP
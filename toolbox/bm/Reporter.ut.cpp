@@ -0,0 +1,51 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Reporter.hpp"
+
+#include <toolbox/bm/Environment.hpp>
+#include <toolbox/bm/Stats.hpp>
+#include <toolbox/hdr/Histogram.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(ReporterSuite)
+
+BOOST_AUTO_TEST_CASE(ReporterJsonEmptyCase)
+{
+    stringstream ss;
+    auto r = bm::make_reporter(bm::ReportFormat::Json, ss, 1.0, {50.0});
+    r->begin(bm::Environment{}, {});
+
+    // The mean and standard deviation of an empty histogram are undefined.
+    const Histogram h{1, 1000, 3};
+    const bm::Sample base{};
+    r->report({"empty", h, bm::Sample{}, 0.0, &base, false, nullptr});
+    r->end();
+
+    const auto json = ss.str();
+    BOOST_CHECK(json.find("\"count\":0") != string::npos);
+    BOOST_CHECK(json.find("\"mean\":null") != string::npos);
+    BOOST_CHECK(json.find("\"stddev\":null") != string::npos);
+    BOOST_CHECK(json.find("nan") == string::npos);
+    BOOST_CHECK(json.find("inf") == string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace toolbox::bm {
+using namespace std;
+namespace {
+// Scale factor that makes the MAD a consistent estimator of the standard deviation for normally
+// distributed data.
+constexpr double MadScale{1.4826};
+} // namespace
+
+double median(vector<double> values)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+    const auto n = values.size();
+    const auto mid = values.begin() + n / 2;
+    nth_element(values.begin(), mid, values.end());
+    if (n % 2 == 1) {
+        return *mid;
+    }
+    // The lower middle element is the maximum of the lower half.
+    return (*max_element(values.begin(), mid) + *mid) / 2.0;
+}
+
+Sample make_sample(const vector<double>& values)
+{
+    Sample s;
+    s.median = median(values);
+    vector<double> devs;
+    devs.reserve(values.size());
+    for (const auto v : values) {
+        devs.push_back(fabs(v - s.median));
+    }
+    s.mad = median(move(devs));
+    s.repetitions = static_cast<int>(values.size());
+    return s;
+}
+
+bool is_regression(const Sample& base, const Sample& cur, double min_change) noexcept
+{
+    const double diff{cur.median - base.median};
+    // Samples are recorded with nanosecond resolution, so a single nanosecond is within the
+    // quantisation error.
+    if (diff <= 1.0 || diff <= base.median * min_change) {
+        return false;
+    }
+    // Standard error of each median, estimated from the scaled MAD. With a single repetition the
+    // MAD is zero, so only the relative threshold applies.
+    const auto var = [](const Sample& s) {
+        const double sigma{MadScale * s.mad};
+        return s.repetitions > 0 ? sigma * sigma / s.repetitions : 0.0;
+    };
+    return diff > 3.0 * sqrt(var(base) + var(cur));
+}
+
+Baseline read_baseline(const string& path)
+{
+    ifstream is{path};
+    if (!is) {
+        throw runtime_error{"could not open baseline file: " + path};
+    }
+    Baseline baseline;
+    string name;
+    Sample s;
+    while (is >> name >> s.median >> s.mad >> s.repetitions) {
+        baseline.insert_or_assign(name, s);
+    }
+    if (!is.eof()) {
+        throw runtime_error{"invalid baseline file: " + path};
+    }
+    return baseline;
+}
+
+void write_baseline(const string& path, const Baseline& baseline)
+{
+    ofstream os{path};
+    if (!os) {
+        throw runtime_error{"could not open baseline file: " + path};
+    }
+    os << setprecision(numeric_limits<double>::max_digits10);
+    for (const auto& [name, s] : baseline) {
+        os << name << ' ' << s.median << ' ' << s.mad << ' ' << s.repetitions << '\n';
+    }
+    if (!os.flush()) {
+        throw runtime_error{"could not write baseline file: " + path};
+    }
+}
+
+} // namespace toolbox::bm
@@ -0,0 +1,63 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_BM_STATS_HPP
+#define TOOLBOX_BM_STATS_HPP
+
+#include <toolbox/Config.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace toolbox::bm {
+
+/// Summary of a benchmark's median latency across repetitions.
+struct Sample {
+    /// Median of the per-repetition medians, in nanoseconds.
+    double median{0.0};
+    /// Median absolute deviation of the per-repetition medians, in nanoseconds.
+    double mad{0.0};
+    int repetitions{0};
+};
+
+/// Returns the median of values, or zero if values is empty.
+TOOLBOX_API double median(std::vector<double> values);
+
+/// Returns the median and median absolute deviation of the per-repetition values.
+TOOLBOX_API Sample make_sample(const std::vector<double>& values);
+
+/// Returns true if cur is slower than base by a statistically significant margin.
+///
+/// The increase in the median must exceed one nanosecond, min_change, expressed as a fraction of
+/// the baseline median, and three times the combined standard error estimated from the
+/// normal-scaled MADs of both samples.
+TOOLBOX_API bool is_regression(const Sample& base, const Sample& cur,
+                               double min_change = 0.05) noexcept;
+
+/// Baseline results, keyed by benchmark name.
+using Baseline = std::map<std::string, Sample, std::less<>>;
+
+/// Reads a baseline file written by write_baseline().
+///
+/// Each line contains a benchmark name followed by the median, MAD and number of repetitions,
+/// separated by whitespace.
+TOOLBOX_API Baseline read_baseline(const std::string& path);
+TOOLBOX_API void write_baseline(const std::string& path, const Baseline& baseline);
+
+} // namespace toolbox::bm
+
+#endif // TOOLBOX_BM_STATS_HPP
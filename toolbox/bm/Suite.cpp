@@ -15,52 +15,123 @@
 
 #include "Suite.hpp"
 
-#include <toolbox/hdr/Utility.hpp>
+#include <toolbox/bm/Environment.hpp>
 
-#include <boost/io/ios_state.hpp>
+#include <toolbox/hdr/Utility.hpp>
 
-#include <iomanip>
+#include <barrier>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
 
 namespace toolbox::bm {
 using namespace std;
 
-BenchmarkSuite::BenchmarkSuite(std::ostream& os, double value_scale)
-: os_{os}
-, value_scale_{value_scale}
+BenchmarkSuite::BenchmarkSuite(std::ostream& os, double value_scale, BenchmarkOptions opts,
+                               const Baseline* baseline)
+: opts_{std::move(opts)}
+, reporter_{make_reporter(opts_.format, os, value_scale, opts_.percentiles)}
+, baseline_{baseline}
 {
-    boost::io::ios_all_saver all_saver{os};
+    if (opts_.repetitions < 1) {
+        throw invalid_argument{"repetitions must be greater than zero"};
+    }
+    if (opts_.perf_counters) {
+        perf_ = make_unique<PerfCounters>();
+        if (!perf_->available()) {
+            // Degrade to timing only.
+            cerr << "warning: hardware counters unavailable: " << perf_->error().message() << endl;
+            perf_.reset();
+        }
+    }
+    reporter_->begin(get_environment(), {.baseline = baseline_ != nullptr, .perf = bool{perf_}});
+}
 
-    // clang-format off
-    os << left << setw(45) << "NAME"
-       << right << setw(15) << "COUNT"
-       << right << setw(10) << "MIN"
-       << right << setw(10) << "%50"
-       << right << setw(10) << "%95"
-       << right << setw(10) << "%99"
-       << right << setw(10) << "%99.9"
-       << right << setw(10) << "%99.99"
-       << endl;
-    // clang-format on
+BenchmarkSuite::~BenchmarkSuite()
+{
+    reporter_->end();
+}
 
-    // Separator.
-    os << setw(120) << setfill('-') << '-' << setfill(' ') << endl;
+void BenchmarkSuite::report(const char* name, const Histogram& h, const Sample& sample,
+                            chrono::nanoseconds elapsed)
+{
+    const Sample* base{nullptr};
+    bool regression{false};
+    if (baseline_) {
+        if (const auto it = baseline_->find(name); it != baseline_->end()) {
+            base = &it->second;
+            regression = is_regression(*base, sample);
+            if (regression) {
+                ++regressions_;
+            }
+        }
+    }
+    const double secs{chrono::duration<double>{elapsed}.count()};
+    const double rate{secs > 0 ? h.total_count() / secs : 0.0};
+    reporter_->report({name, h, sample, rate, base, regression, perf_ ? &perf_->totals() : nullptr});
+    results_.insert_or_assign(name, sample);
 }
 
-void BenchmarkSuite::report(const char* name, Histogram& h)
+void BenchmarkSuite::run_threads(const function<void(Context&)>& fn,
+                                 chrono::milliseconds duration, int64_t iterations,
+                                 BenchmarkParams params)
 {
-    boost::io::ios_all_saver all_saver{os_};
+    const auto n = static_cast<size_t>(params.threads);
+    vector<Histogram> hists;
+    vector<unique_ptr<Context>> ctxs;
+    hists.reserve(n);
+    ctxs.reserve(n);
+    for (size_t i{0}; i < n; ++i) {
+        hists.emplace_back(hist_.lowest_trackable_value(), hist_.highest_trackable_value(),
+                           hist_.significant_figures(), CountsRep::Sparse);
+        ctxs.push_back(
+            make_unique<Context>(hists.back(), iterations, nullptr, params, static_cast<int>(i)));
+    }
+    // Counters only measure the thread that opened them, so the first thread opens its own and
+    // they are added to the suite's totals when it completes.
+    unique_ptr<PerfCounters> perf0;
+    // The calling thread participates in the barrier, so that the alarm is only started once all
+    // threads are ready to run.
+    barrier sync{static_cast<ptrdiff_t>(n + 1)};
+    {
+        vector<jthread> threads;
+        threads.reserve(n);
+        for (size_t i{0}; i < n; ++i) {
+            threads.emplace_back([this, i, iterations, &params, &fn, &sync, &ctxs, &hists,
+                                  &perf0]() {
+                if (i == 0 && perf_) {
+                    perf0 = make_unique<PerfCounters>();
+                    if (perf0->available()) {
+                        // The barrier orders this store before any use by the calling thread.
+                        ctxs[0] = make_unique<Context>(hists[0], iterations, perf0.get(), params, 0);
+                    }
+                }
+                sync.arrive_and_wait();
+                fn(*ctxs[i]);
+            });
+        }
+        sync.arrive_and_wait();
+        if (iterations == 0) {
+            Alarm alarm{duration, [&ctxs]() {
+                            for (auto& ctx : ctxs) {
+                                ctx->stop();
+                            }
+                        }};
+            threads.clear();
+        }
+    }
+    if (perf0 && perf0->available()) {
+        perf_->add_totals(perf0->totals());
+    }
+    for (const auto& h : hists) {
+        hist_.add(h);
+    }
+}
 
-    // clang-format off
-    os_ << left << setw(45) << name
-        << right << setw(15) << h.total_count()
-        << right << setw(10) << h.min() / value_scale_
-        << right << setw(10) << value_at_percentile(h, 50) / value_scale_
-        << right << setw(10) << value_at_percentile(h, 95) / value_scale_
-        << right << setw(10) << value_at_percentile(h, 99) / value_scale_
-        << right << setw(10) << value_at_percentile(h, 99.9) / value_scale_
-        << right << setw(10) << value_at_percentile(h, 99.99) / value_scale_
-        << endl;
-    // clang-format on
+void BenchmarkSuite::end_repetition()
+{
+    medians_.push_back(value_at_percentile(hist_, 50));
+    total_.add(hist_);
 }
 
 } // namespace toolbox::bm
@@ -17,32 +17,130 @@
 #define TOOLBOX_BM_SUITE_HPP
 
 #include <toolbox/bm/Context.hpp>
+#include <toolbox/bm/Counters.hpp>
+#include <toolbox/bm/Reporter.hpp>
+#include <toolbox/bm/Stats.hpp>
 
 #include <toolbox/hdr/Histogram.hpp>
 
+#include <chrono>
+#include <functional>
+#include <memory>
+
 namespace toolbox::bm {
 
+/// Options that control how each benchmark is run.
+struct BenchmarkOptions {
+    /// Time spent running the benchmark, without recording results, before the first repetition.
+    std::chrono::milliseconds warmup{0};
+    /// Duration of each repetition. Ignored if iterations is non-zero.
+    std::chrono::milliseconds duration{3000};
+    /// Number of samples recorded in each repetition. Zero means run for duration.
+    std::int64_t iterations{0};
+    /// Number of measured repetitions.
+    int repetitions{1};
+    /// Report format.
+    ReportFormat format{ReportFormat::Text};
+    /// Percentiles reported by the machine-readable formats.
+    std::vector<double> percentiles{50, 90, 99, 99.9, 99.99};
+    /// Collect hardware performance counters, if permitted by the kernel.
+    bool perf_counters{false};
+};
+
 class TOOLBOX_API BenchmarkSuite {
   public:
-    explicit BenchmarkSuite(std::ostream& os, double value_scale = 1.0);
+    /// Construct BenchmarkSuite.
+    ///
+    /// \param os The output stream for the report.
+    /// \param value_scale Divisor applied to nanosecond values in the report.
+    /// \param opts The run options.
+    /// \param baseline Optional baseline that results are compared against.
+    explicit BenchmarkSuite(std::ostream& os, double value_scale = 1.0, BenchmarkOptions opts = {},
+                            const Baseline* baseline = nullptr);
+    ~BenchmarkSuite();
 
+    // Copy.
+    BenchmarkSuite(const BenchmarkSuite&) = delete;
+    BenchmarkSuite& operator=(const BenchmarkSuite&) = delete;
+
+    // Move.
+    BenchmarkSuite(BenchmarkSuite&&) = delete;
+    BenchmarkSuite& operator=(BenchmarkSuite&&) = delete;
+
+    /// Run a benchmark and report the results.
+    ///
+    /// If params.threads is greater than one, then fn is invoked concurrently on that number of
+    /// threads, which are released together once all have started. Each thread records samples in
+    /// its own histogram, and the histograms are merged at the end of each repetition. Hardware
+    /// counters, if enabled, are only collected on the first thread.
     template <typename FnT>
-    void run(const char* name, FnT fn)
+    void run(const char* name, FnT fn, BenchmarkParams params = {})
     {
-        using namespace std::literals::chrono_literals;
-        constexpr auto duration = 3s;
+        if (opts_.warmup.count() > 0) {
+            hist_.reset();
+            run_once(fn, opts_.warmup, 0, params);
+        }
+        total_.reset();
+        medians_.clear();
+        if (perf_) {
+            perf_->reset_totals();
+        }
+        std::chrono::nanoseconds elapsed{0};
+        for (int i{0}; i < opts_.repetitions; ++i) {
+            hist_.reset();
+            const auto start = std::chrono::steady_clock::now();
+            run_once(fn, opts_.duration, opts_.iterations, params);
+            elapsed += std::chrono::steady_clock::now() - start;
+            end_repetition();
+        }
+        report(name, total_, make_sample(medians_), elapsed);
+    }
+    /// Report the results of a benchmark.
+    ///
+    /// \param name The benchmark name.
+    /// \param hist The histogram of samples.
+    /// \param sample The median and MAD across repetitions.
+    /// \param elapsed The measured time, which is used to calculate the sample rate.
+    void report(const char* name, const Histogram& hist, const Sample& sample,
+                std::chrono::nanoseconds elapsed);
 
-        Histogram hist{1, 1'000'000'000, 5};
-        Context ctx{hist};
+    /// Results for the benchmarks run so far, in the same format as the baseline.
+    const Baseline& results() const noexcept { return results_; }
+    /// Number of benchmarks that regressed against the baseline.
+    int regressions() const noexcept { return regressions_; }
+
+  private:
+    template <typename FnT>
+    void run_once(FnT& fn, std::chrono::milliseconds duration, std::int64_t iterations,
+                  BenchmarkParams params)
+    {
+        if (params.threads > 1) {
+            run_threads(std::ref(fn), duration, iterations, params);
+            return;
+        }
+        Context ctx{hist_, iterations, perf_.get(), params};
+        if (iterations > 0) {
+            fn(ctx);
+            return;
+        }
         Alarm alarm{duration, [&ctx]() { ctx.stop(); }};
         fn(ctx);
-        report(name, hist);
     }
-    void report(const char* name, Histogram& hist);
+    void run_threads(const std::function<void(Context&)>& fn, std::chrono::milliseconds duration,
+                     std::int64_t iterations, BenchmarkParams params);
+    void end_repetition();
 
-  private:
-    std::ostream& os_;
-    double value_scale_;
+    BenchmarkOptions opts_;
+    std::unique_ptr<Reporter> reporter_;
+    std::unique_ptr<PerfCounters> perf_;
+    const Baseline* baseline_;
+    // Benchmark latencies are tightly clustered, so sparse counts arrays avoid allocating and
+    // touching several megabytes per histogram.
+    Histogram hist_{1, 1'000'000'000, 5, CountsRep::Sparse};
+    Histogram total_{1, 1'000'000'000, 5, CountsRep::Sparse};
+    std::vector<double> medians_;
+    Baseline results_;
+    int regressions_{0};
 };
 
 } // namespace toolbox::bm
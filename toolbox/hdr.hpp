@@ -16,6 +16,7 @@
 #ifndef TOOLBOX_HDR_HPP
 #define TOOLBOX_HDR_HPP
 
+#include "hdr/Counts.hpp"
 #include "hdr/Histogram.hpp"
 #include "hdr/Iterator.hpp"
 #include "hdr/Utility.hpp"
@@ -0,0 +1,170 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Counts.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+namespace toolbox {
+inline namespace hdr {
+using namespace std;
+namespace {
+
+// Upper bound on the number of sparse entries, which bounds the cost of an insertion.
+constexpr size_t MaxSparseEntries{4096};
+
+template <typename ValueT>
+bool fits(int64_t value) noexcept
+{
+    return value >= numeric_limits<ValueT>::min() && value <= numeric_limits<ValueT>::max();
+}
+
+template <typename ValueT>
+void copy_sparse(const vector<Counts::Entry>& sparse, vector<ValueT>& dense)
+{
+    for (const auto& e : sparse) {
+        dense[e.index] = static_cast<ValueT>(e.count);
+    }
+}
+
+template <typename FromT, typename ToT>
+void widen(vector<FromT>& from, vector<ToT>& to)
+{
+    to.assign(from.begin(), from.end());
+    vector<FromT>{}.swap(from);
+}
+
+} // namespace
+
+Counts::Counts(int32_t len, CountsRep rep)
+: len_{len}
+, rep_{CountsRep::Sparse}
+{
+    promote(rep);
+}
+
+size_t Counts::capacity_bytes() const noexcept
+{
+    return sparse_.capacity() * sizeof(Entry) + c16_.capacity() * sizeof(int16_t)
+        + c32_.capacity() * sizeof(int32_t) + c64_.capacity() * sizeof(int64_t);
+}
+
+void Counts::clear() noexcept
+{
+    sparse_.clear();
+    fill(c16_.begin(), c16_.end(), 0);
+    fill(c32_.begin(), c32_.end(), 0);
+    fill(c64_.begin(), c64_.end(), 0);
+}
+
+int64_t Counts::sparse_at(int32_t index) const noexcept
+{
+    const auto it = lower_bound(sparse_.begin(), sparse_.end(), index,
+                                [](const Entry& e, int32_t index) { return e.index < index; });
+    return it != sparse_.end() && it->index == index ? it->count : 0;
+}
+
+bool Counts::sparse_add(int32_t index, int64_t value) noexcept
+{
+    const auto it = lower_bound(sparse_.begin(), sparse_.end(), index,
+                                [](const Entry& e, int32_t index) { return e.index < index; });
+    if (it != sparse_.end() && it->index == index) {
+        it->count += value;
+        return true;
+    }
+    // Switch to a dense array once the sparse array would be larger than the 16-bit equivalent, or
+    // when insertions become too expensive.
+    if (sparse_.size() >= MaxSparseEntries
+        || (sparse_.size() + 1) * sizeof(Entry) > len_ * sizeof(int16_t)) {
+        return promote_add(index, value);
+    }
+    try {
+        sparse_.insert(it, Entry{index, value});
+    } catch (const bad_alloc&) {
+        return false;
+    }
+    return true;
+}
+
+bool Counts::promote_add(int32_t index, int64_t value) noexcept
+{
+    const int64_t result{(*this)[index] + value};
+    auto rep = static_cast<CountsRep>(static_cast<int>(rep_) + 1);
+    if (rep == CountsRep::Dense16 && !fits<int16_t>(result)) {
+        rep = CountsRep::Dense32;
+    }
+    if (rep == CountsRep::Dense32 && !fits<int32_t>(result)) {
+        rep = CountsRep::Dense64;
+    }
+    // Allocation is confined to this cold path, so that the caller can report failure instead of
+    // propagating an exception from the recording functions.
+    try {
+        promote(rep);
+    } catch (const bad_alloc&) {
+        return false;
+    }
+    return add(index, value);
+}
+
+void Counts::promote(CountsRep rep)
+{
+    if (rep <= rep_) {
+        return;
+    }
+    if (rep_ == CountsRep::Sparse) {
+        // Promote directly to the narrowest dense array that can hold the existing counts.
+        int64_t max_abs{0};
+        for (const auto& e : sparse_) {
+            max_abs = std::max(max_abs, e.count < 0 ? -e.count : e.count);
+        }
+        if (rep == CountsRep::Dense16 && !fits<int16_t>(max_abs)) {
+            rep = CountsRep::Dense32;
+        }
+        if (rep == CountsRep::Dense32 && !fits<int32_t>(max_abs)) {
+            rep = CountsRep::Dense64;
+        }
+        switch (rep) {
+        case CountsRep::Sparse:
+            break;
+        case CountsRep::Dense16:
+            c16_.resize(len_);
+            copy_sparse(sparse_, c16_);
+            break;
+        case CountsRep::Dense32:
+            c32_.resize(len_);
+            copy_sparse(sparse_, c32_);
+            break;
+        case CountsRep::Dense64:
+            c64_.resize(len_);
+            copy_sparse(sparse_, c64_);
+            break;
+        }
+        vector<Entry>{}.swap(sparse_);
+    } else if (rep_ == CountsRep::Dense16) {
+        if (rep == CountsRep::Dense32) {
+            widen(c16_, c32_);
+        } else {
+            widen(c16_, c64_);
+        }
+    } else {
+        widen(c32_, c64_);
+    }
+    rep_ = rep;
+}
+
+} // namespace hdr
+} // namespace toolbox
@@ -0,0 +1,192 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef TOOLBOX_HDR_COUNTS
+#define TOOLBOX_HDR_COUNTS
+
+#include <toolbox/Config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace toolbox {
+/// A C++ port of HdrHistogram_c written Michael Barker and released to the public domain.
+inline namespace hdr {
+
+/// Storage representation for histogram counts.
+///
+/// The representations are ordered from most to least compact. Storage is promoted to the next
+/// representation when a count overflows the current counter width, or when a sparse array becomes
+/// larger than the equivalent dense array or exceeds a fixed number of entries.
+enum class CountsRep : std::uint8_t {
+    /// Sorted array of (index, count) pairs for non-zero counts only.
+    Sparse,
+    /// Dense array of 16-bit counters.
+    Dense16,
+    /// Dense array of 32-bit counters.
+    Dense32,
+    /// Dense array of 64-bit counters.
+    Dense64
+};
+
+/// Array of histogram counts with a runtime-selectable counter width.
+class TOOLBOX_API Counts {
+  public:
+    struct Entry {
+        std::int32_t index;
+        std::int64_t count;
+    };
+
+    Counts(std::int32_t len, CountsRep rep);
+    ~Counts() = default;
+
+    // Copy.
+    Counts(const Counts&) = default;
+    Counts& operator=(const Counts&) = default;
+
+    // Move.
+    Counts(Counts&&) noexcept = default;
+    Counts& operator=(Counts&&) noexcept = default;
+
+    std::int64_t operator[](std::int32_t index) const noexcept
+    {
+        switch (rep_) {
+        case CountsRep::Sparse:
+            return sparse_at(index);
+        case CountsRep::Dense16:
+            return c16_[index];
+        case CountsRep::Dense32:
+            return c32_[index];
+        case CountsRep::Dense64:
+            break;
+        }
+        return c64_[index];
+    }
+    std::int32_t size() const noexcept { return len_; }
+    CountsRep rep() const noexcept { return rep_; }
+
+    /// Returns the number of bytes currently allocated for the counts.
+    std::size_t capacity_bytes() const noexcept;
+
+    /// Adds value to the count at index, promoting the representation if necessary.
+    ///
+    /// Returns false, leaving the counts unchanged, if memory for the promoted representation could
+    /// not be allocated.
+    bool add(std::int32_t index, std::int64_t value) noexcept
+    {
+        switch (rep_) {
+        case CountsRep::Sparse:
+            return sparse_add(index, value);
+        case CountsRep::Dense16:
+            return dense_add(c16_, index, value) || promote_add(index, value);
+        case CountsRep::Dense32:
+            return dense_add(c32_, index, value) || promote_add(index, value);
+        case CountsRep::Dense64:
+            break;
+        }
+        c64_[index] += value;
+        return true;
+    }
+
+    /// Resets all counts to zero. The current representation is retained.
+    void clear() noexcept;
+
+    /// Invokes fn(index, count) for each non-zero count in ascending index order. Iteration stops
+    /// early if fn returns false.
+    ///
+    /// Dense arrays are scanned in fixed-size blocks, so that runs of zero counts are skipped with
+    /// a single, vectorisable test per block.
+    template <typename FnT>
+    void for_each(FnT fn) const
+    {
+        switch (rep_) {
+        case CountsRep::Sparse:
+            for (const auto& e : sparse_) {
+                if (!fn(e.index, e.count)) {
+                    break;
+                }
+            }
+            break;
+        case CountsRep::Dense16:
+            dense_for_each(c16_, fn);
+            break;
+        case CountsRep::Dense32:
+            dense_for_each(c32_, fn);
+            break;
+        case CountsRep::Dense64:
+            dense_for_each(c64_, fn);
+            break;
+        }
+    }
+
+  private:
+    template <typename ValueT>
+    static bool dense_add(std::vector<ValueT>& counts, std::int32_t index,
+                          std::int64_t value) noexcept
+    {
+        ValueT& ref = counts[index];
+        ValueT result;
+        if (__builtin_add_overflow(ref, value, &result)) [[unlikely]] {
+            return false;
+        }
+        ref = result;
+        return true;
+    }
+
+    template <typename ValueT, typename FnT>
+    static void dense_for_each(const std::vector<ValueT>& counts, FnT& fn)
+    {
+        constexpr std::int32_t Block{64 / sizeof(ValueT)};
+        const auto* const data = counts.data();
+        const auto len = static_cast<std::int32_t>(counts.size());
+        std::int32_t i{0};
+        for (; i + Block <= len; i += Block) {
+            ValueT any{0};
+            for (std::int32_t j{0}; j < Block; ++j) {
+                any |= data[i + j];
+            }
+            if (any == 0) {
+                continue;
+            }
+            for (std::int32_t j{0}; j < Block; ++j) {
+                if (data[i + j] != 0 && !fn(i + j, std::int64_t{data[i + j]})) {
+                    return;
+                }
+            }
+        }
+        for (; i < len; ++i) {
+            if (data[i] != 0 && !fn(i, std::int64_t{data[i]})) {
+                return;
+            }
+        }
+    }
+
+    std::int64_t sparse_at(std::int32_t index) const noexcept;
+    bool sparse_add(std::int32_t index, std::int64_t value) noexcept;
+    bool promote_add(std::int32_t index, std::int64_t value) noexcept;
+    void promote(CountsRep rep);
+
+    std::int32_t len_;
+    CountsRep rep_;
+    std::vector<Entry> sparse_;
+    std::vector<std::int16_t> c16_;
+    std::vector<std::int32_t> c32_;
+    std::vector<std::int64_t> c64_;
+};
+
+} // namespace hdr
+} // namespace toolbox
+
+#endif // TOOLBOX_HDR_COUNTS
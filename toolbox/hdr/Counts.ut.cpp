@@ -0,0 +1,103 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Counts.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(CountsSuite)
+
+BOOST_AUTO_TEST_CASE(CountsDensePromoteCase)
+{
+    Counts c{1024, CountsRep::Dense16};
+    BOOST_CHECK(c.rep() == CountsRep::Dense16);
+    BOOST_CHECK_EQUAL(c.size(), 1024);
+    BOOST_CHECK_EQUAL(c.capacity_bytes(), 1024 * sizeof(int16_t));
+
+    c.add(1, 32767);
+    c.add(2, 2);
+    BOOST_CHECK(c.rep() == CountsRep::Dense16);
+
+    BOOST_CHECK(c.add(1, 1));
+    BOOST_CHECK(c.rep() == CountsRep::Dense32);
+    BOOST_CHECK_EQUAL(c[1], 32768);
+    BOOST_CHECK_EQUAL(c[2], 2);
+
+    BOOST_CHECK(c.add(2, int64_t{1} << 40));
+    BOOST_CHECK(c.rep() == CountsRep::Dense64);
+    BOOST_CHECK_EQUAL(c[1], 32768);
+    BOOST_CHECK_EQUAL(c[2], (int64_t{1} << 40) + 2);
+
+    c.clear();
+    BOOST_CHECK(c.rep() == CountsRep::Dense64);
+    BOOST_CHECK_EQUAL(c[1], 0);
+    BOOST_CHECK_EQUAL(c[2], 0);
+}
+
+BOOST_AUTO_TEST_CASE(CountsSparsePromoteCase)
+{
+    Counts c{64, CountsRep::Sparse};
+    BOOST_CHECK_EQUAL(c.capacity_bytes(), 0U);
+
+    c.add(10, 70000);
+    c.add(5, 1);
+    c.add(10, 1);
+    BOOST_CHECK(c.rep() == CountsRep::Sparse);
+    BOOST_CHECK_EQUAL(c[5], 1);
+    BOOST_CHECK_EQUAL(c[10], 70001);
+    BOOST_CHECK_EQUAL(c[11], 0);
+
+    // Sparse array grows beyond the size of a dense 16-bit array.
+    for (int32_t i{20}; i < 28; ++i) {
+        c.add(i, 1);
+    }
+    BOOST_CHECK(c.rep() == CountsRep::Dense32);
+    BOOST_CHECK_EQUAL(c[5], 1);
+    BOOST_CHECK_EQUAL(c[10], 70001);
+    BOOST_CHECK_EQUAL(c[27], 1);
+}
+
+BOOST_AUTO_TEST_CASE(CountsForEachCase)
+{
+    for (const auto rep : {CountsRep::Sparse, CountsRep::Dense16, CountsRep::Dense32,
+                           CountsRep::Dense64}) {
+        Counts c{1000, rep};
+        c.add(3, 3);
+        c.add(500, 5);
+        c.add(999, 9);
+
+        vector<pair<int32_t, int64_t>> out;
+        c.for_each([&](int32_t index, int64_t count) {
+            out.emplace_back(index, count);
+            return true;
+        });
+        BOOST_CHECK_EQUAL(out.size(), 3U);
+        BOOST_CHECK(out[0] == make_pair(3, int64_t{3}));
+        BOOST_CHECK(out[1] == make_pair(500, int64_t{5}));
+        BOOST_CHECK(out[2] == make_pair(999, int64_t{9}));
+
+        out.clear();
+        c.for_each([&](int32_t index, int64_t count) {
+            out.emplace_back(index, count);
+            return false;
+        });
+        BOOST_CHECK_EQUAL(out.size(), 1U);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
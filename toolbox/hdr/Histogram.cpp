@@ -93,7 +93,7 @@ BucketConfig::BucketConfig(int64_t lowest_trackable_value, int64_t highest_track
     }
 }
 
-Histogram::Histogram(const BucketConfig& config)
+Histogram::Histogram(const BucketConfig& config, CountsRep rep)
 : lowest_trackable_value_{config.lowest_trackable_value}
 , highest_trackable_value_{config.highest_trackable_value}
 , significant_figures_{config.significant_figures}
@@ -107,13 +107,13 @@ Histogram::Histogram(const BucketConfig& config)
 , min_value_{numeric_limits<int64_t>::max()}
 , max_value_{0}
 , total_count_{0}
+, counts_{config.counts_len, rep}
 {
-    counts_.resize(config.counts_len);
 }
 
 Histogram::Histogram(int64_t lowest_trackable_value, int64_t highest_trackable_value,
-                     int significant_figures)
-: Histogram{BucketConfig{lowest_trackable_value, highest_trackable_value, significant_figures}}
+                     int significant_figures, CountsRep rep)
+: Histogram{BucketConfig{lowest_trackable_value, highest_trackable_value, significant_figures}, rep}
 {
 }
 
@@ -201,7 +201,7 @@ void Histogram::reset() noexcept
     min_value_ = numeric_limits<int64_t>::max();
     max_value_ = 0;
     total_count_ = 0;
-    fill(counts_.begin(), counts_.end(), 0);
+    counts_.clear();
 }
 
 bool Histogram::record_value(int64_t value) noexcept
@@ -218,11 +218,25 @@ bool Histogram::record_values(int64_t value, int64_t count) noexcept
     if (counts_index < 0 || counts_len() <= counts_index) {
         return false;
     }
-    counts_inc_normalised(counts_index, count);
+    if (!counts_inc_normalised(counts_index, count)) {
+        return false;
+    }
     update_min_max(value);
     return true;
 }
 
+int64_t Histogram::add(const Histogram& from) noexcept
+{
+    int64_t dropped{0};
+    from.counts().for_each([&](int32_t index, int64_t count) {
+        if (!record_values(from.value_at_index(index), count)) {
+            dropped += count;
+        }
+        return true;
+    });
+    return dropped;
+}
+
 int32_t Histogram::normalize_index(int32_t index) const noexcept
 {
     if (normalizing_index_offset_ == 0) {
@@ -274,11 +288,14 @@ int64_t Histogram::non_zero_min() const noexcept
     return lowest_equivalent_value(min_value_);
 }
 
-void Histogram::counts_inc_normalised(int32_t index, int64_t value) noexcept
+bool Histogram::counts_inc_normalised(int32_t index, int64_t value) noexcept
 {
     const int32_t normalised_index{normalize_index(index)};
-    counts_[normalised_index] += value;
+    if (!counts_.add(normalised_index, value)) {
+        return false;
+    }
     total_count_ += value;
+    return true;
 }
 
 void Histogram::update_min_max(int64_t value) noexcept
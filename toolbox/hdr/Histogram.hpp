@@ -15,10 +15,10 @@
 #ifndef TOOLBOX_HDR_HISTOGRAM
 #define TOOLBOX_HDR_HISTOGRAM
 
+#include <toolbox/hdr/Counts.hpp>
 #include <toolbox/Config.h>
 
 #include <cstdint>
-#include <vector>
 
 namespace toolbox {
 /// A C++ port of HdrHistogram_c written Michael Barker and released to the public domain.
@@ -63,9 +63,14 @@ struct TOOLBOX_API BucketConfig {
 /// A High Dynamic Range (HDR) Histogram.
 class TOOLBOX_API Histogram {
   public:
-    explicit Histogram(const BucketConfig& config);
+    /// Construct Histogram.
+    ///
+    /// \param config The bucket configuration.
+    /// \param rep The initial representation of the counts array. Compact representations are
+    /// promoted automatically, as required, when values are recorded.
+    explicit Histogram(const BucketConfig& config, CountsRep rep = CountsRep::Dense64);
     Histogram(std::int64_t lowest_trackable_value, std::int64_t highest_trackable_value,
-              std::int32_t significant_figures);
+              std::int32_t significant_figures, CountsRep rep = CountsRep::Dense64);
     ~Histogram() noexcept = default;
 
     // Copy.
@@ -83,7 +88,9 @@ class TOOLBOX_API Histogram {
     std::int32_t sub_bucket_count() const noexcept { return sub_bucket_count_; }
     std::int32_t bucket_count() const noexcept { return bucket_count_; }
     std::int64_t total_count() const noexcept { return total_count_; }
-    std::int32_t counts_len() const noexcept { return static_cast<std::int32_t>(counts_.size()); }
+    std::int32_t counts_len() const noexcept { return counts_.size(); }
+    /// Raw counts array, indexed by counts index. Intended for bulk scans.
+    const Counts& counts() const noexcept { return counts_; }
 
     /// Get minimum value from the histogram. Will return 2^63-1 if the histogram is empty.
     std::int64_t min() const noexcept;
@@ -134,7 +141,7 @@ class TOOLBOX_API Histogram {
     ///
     /// \param value Value to add to the histogram.
     /// \return false if the value is larger than the highest_trackable_value and can't be recorded,
-    /// true otherwise.
+    /// or if compact counts could not be widened to hold it, true otherwise.
     bool record_value(std::int64_t value) noexcept;
 
     /// Records count values in the histogram, will round this value of to a precision at or better
@@ -143,9 +150,16 @@ class TOOLBOX_API Histogram {
     /// \param value Value to add to the histogram.
     /// \param count Number of values to add to the histogram.
     /// \return false if any value is larger than the highest_trackable_value and can't be recorded,
-    /// true otherwise.
+    /// or if compact counts could not be widened to hold them, true otherwise.
     bool record_values(std::int64_t value, std::int64_t count) noexcept;
 
+    /// Adds all of the values from another histogram to this one.
+    ///
+    /// \param from The histogram to add values from.
+    /// \return the number of values that were dropped because they were outside the trackable
+    /// range of this histogram.
+    std::int64_t add(const Histogram& from) noexcept;
+
   private:
     std::int32_t normalize_index(std::int32_t index) const noexcept;
     std::int32_t get_bucket_index(std::int64_t value) const noexcept;
@@ -154,7 +168,7 @@ class TOOLBOX_API Histogram {
     std::int32_t counts_index_for(std::int64_t value) const noexcept;
     std::int64_t non_zero_min() const noexcept;
 
-    void counts_inc_normalised(std::int32_t index, std::int64_t value) noexcept;
+    bool counts_inc_normalised(std::int32_t index, std::int64_t value) noexcept;
     void update_min_max(std::int64_t value) noexcept;
 
     std::int64_t lowest_trackable_value_;
@@ -171,7 +185,7 @@ class TOOLBOX_API Histogram {
     std::int64_t min_value_;
     std::int64_t max_value_;
     std::int64_t total_count_;
-    std::vector<std::int64_t> counts_;
+    Counts counts_;
 };
 
 } // namespace hdr
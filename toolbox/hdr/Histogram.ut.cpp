@@ -98,6 +98,47 @@ BOOST_AUTO_TEST_CASE(HistogramTotalCountCase)
     }
 }
 
+BOOST_AUTO_TEST_CASE(HistogramCompactCountsCase)
+{
+    Histogram dense{1, 10000000, 3};
+    Histogram sparse{1, 10000000, 3, CountsRep::Sparse};
+    BOOST_CHECK(sparse.counts().rep() == CountsRep::Sparse);
+    BOOST_CHECK_LT(sparse.counts().capacity_bytes(), dense.counts().capacity_bytes());
+
+    for (int i{0}; i < 100000; ++i) {
+        const auto value = (i % 10) * 1000;
+        BOOST_CHECK(dense.record_value(value));
+        BOOST_CHECK(sparse.record_value(value));
+    }
+    BOOST_CHECK(sparse.counts().rep() == CountsRep::Sparse);
+    BOOST_CHECK_EQUAL(sparse.total_count(), dense.total_count());
+    BOOST_CHECK_EQUAL(sparse.min(), dense.min());
+    BOOST_CHECK_EQUAL(sparse.max(), dense.max());
+    for (int i{0}; i < dense.counts_len(); ++i) {
+        BOOST_CHECK_EQUAL(sparse.count_at_index(i), dense.count_at_index(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(HistogramAddCase)
+{
+    Histogram h1{1, 100000, 3};
+    Histogram h2{1, 100000, 3, CountsRep::Sparse};
+    Histogram h3{1, 1000, 3};
+    for (int i{1}; i <= 1000; ++i) {
+        BOOST_CHECK(h1.record_value(i));
+        BOOST_CHECK(h2.record_value(i * 100));
+    }
+    BOOST_CHECK_EQUAL(h1.add(h2), 0);
+    BOOST_CHECK_EQUAL(h1.total_count(), 2000);
+    BOOST_CHECK_EQUAL(h1.min(), 1);
+    BOOST_CHECK_EQUAL(h1.max(), h2.max());
+    BOOST_CHECK_EQUAL(h1.count_at_value(100000), 1);
+
+    // Values beyond the last bucket cannot be tracked.
+    BOOST_CHECK_EQUAL(h3.add(h2), 980);
+    BOOST_CHECK_EQUAL(h3.total_count(), 20);
+}
+
 BOOST_AUTO_TEST_CASE(HistogramRecordEquivalentValueCase)
 {
     Histogram h{Lowest, Highest, Significant};
@@ -18,7 +18,9 @@
 #include "Histogram.hpp"
 #include "Iterator.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace toolbox {
 inline namespace hdr {
@@ -89,5 +91,63 @@ double stddev(const Histogram& h) noexcept
     return sqrt(geometric_dev_total / total_count);
 }
 
+Summary summarise(const Histogram& h, span<const double> percentiles)
+{
+    Summary s;
+    s.total_count = h.total_count();
+    s.min = h.min();
+    s.max = h.max();
+    s.values.resize(percentiles.size());
+
+    if (s.total_count == 0) {
+        s.mean = s.stddev = numeric_limits<double>::quiet_NaN();
+        return s;
+    }
+
+    // Visit the requested percentiles in ascending order of target count, so that each can be
+    // resolved as the cumulative count passes it.
+    struct Target {
+        int64_t count;
+        size_t pos;
+    };
+    vector<Target> targets;
+    targets.reserve(percentiles.size());
+    for (size_t i{0}; i < percentiles.size(); ++i) {
+        targets.push_back({get_count_at_percentile(h, percentiles[i]), i});
+    }
+    sort(targets.begin(), targets.end(),
+         [](const auto& lhs, const auto& rhs) { return lhs.count < rhs.count; });
+    auto target = targets.begin();
+
+    // Weighted Welford accumulation for the standard deviation. The mean is accumulated exactly.
+    int64_t total{0}, cumulative{0};
+    double welford_mean{0.0}, welford_m2{0.0};
+
+    h.counts().for_each([&](int32_t index, int64_t count) {
+        const int64_t value{h.value_at_index(index)};
+        const int64_t median{h.median_equivalent_value(value)};
+
+        cumulative += count;
+        total += count * median;
+
+        const double delta{median - welford_mean};
+        welford_mean += delta * count / cumulative;
+        welford_m2 += delta * (median - welford_mean) * count;
+
+        if (target != targets.end() && cumulative >= target->count) {
+            const int64_t highest{h.highest_equivalent_value(value)};
+            do {
+                s.values[target->pos] = highest;
+            } while (++target != targets.end() && cumulative >= target->count);
+        }
+        // Stop at the last recorded value.
+        return cumulative < s.total_count;
+    });
+
+    s.mean = double(total) / s.total_count;
+    s.stddev = sqrt(welford_m2 / s.total_count);
+    return s;
+}
+
 } // namespace hdr
 } // namespace toolbox
@@ -23,6 +23,8 @@
 
 #include <cstdint>
 #include <format>
+#include <span>
+#include <vector>
 
 namespace toolbox {
 /// A C++ port of HdrHistogram_c written Michael Barker and released to the public domain.
@@ -51,6 +53,30 @@ TOOLBOX_API double mean(const Histogram& h) noexcept;
 /// \return the standard deviation.
 TOOLBOX_API double stddev(const Histogram& h) noexcept;
 
+/// Summary statistics for a histogram.
+struct Summary {
+    std::int64_t total_count{0};
+    std::int64_t min{0};
+    std::int64_t max{0};
+    double mean{0.0};
+    double stddev{0.0};
+    /// Percentile values, in the same order as the requested percentiles.
+    std::vector<std::int64_t> values;
+};
+
+/// Gets the min, max, mean, standard deviation and a batch of percentile values in a single pass
+/// over the histogram's counts.
+///
+/// Runs of empty buckets are skipped in blocks (see Counts::for_each()) and the scan stops at the
+/// last recorded value, so this is much cheaper than calling value_at_percentile(), mean() and
+/// stddev() individually. The results are equivalent to those functions, although the standard
+/// deviation may differ in the least significant bits.
+///
+/// \param h The histogram.
+/// \param percentiles The percentiles to get values for. These need not be sorted.
+/// \return the summary.
+TOOLBOX_API Summary summarise(const Histogram& h, std::span<const double> percentiles);
+
 struct PutPercentiles {
     const Histogram& h;
     std::int32_t ticks_per_half_distance{5};
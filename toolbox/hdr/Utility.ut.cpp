@@ -81,4 +81,45 @@ BOOST_AUTO_TEST_CASE(StatsCase)
     BOOST_CHECK_EQUAL(stddev(h), 28867.704262911586);
 }
 
+BOOST_AUTO_TEST_CASE(SummaryCase)
+{
+    Histogram h{1, 100000, 4};
+    for (int i{1}; i <= 100000; ++i) {
+        BOOST_CHECK(h.record_value(i));
+    }
+
+    const double pcts[]{99.99, 50, 75, 90, 95, 99, 99.9, 100};
+    const auto s = summarise(h, pcts);
+
+    BOOST_CHECK_EQUAL(s.total_count, 100000);
+    BOOST_CHECK_EQUAL(s.min, 1);
+    BOOST_CHECK_EQUAL(s.max, 100003);
+
+    BOOST_CHECK_EQUAL(s.values.size(), 8U);
+    BOOST_CHECK_EQUAL(s.values[0], 99991);
+    BOOST_CHECK_EQUAL(s.values[1], 50001);
+    BOOST_CHECK_EQUAL(s.values[2], 75003);
+    BOOST_CHECK_EQUAL(s.values[3], 90003);
+    BOOST_CHECK_EQUAL(s.values[4], 95003);
+    BOOST_CHECK_EQUAL(s.values[5], 99003);
+    BOOST_CHECK_EQUAL(s.values[6], 99903);
+    BOOST_CHECK_EQUAL(s.values[7], value_at_percentile(h, 100));
+
+    BOOST_CHECK_EQUAL(s.mean, mean(h));
+    BOOST_CHECK_CLOSE(s.stddev, stddev(h), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(SummaryEmptyCase)
+{
+    Histogram h{1, 100000, 3};
+    const double pcts[]{50, 99};
+    const auto s = summarise(h, pcts);
+
+    BOOST_CHECK_EQUAL(s.total_count, 0);
+    BOOST_CHECK_EQUAL(s.values[0], 0);
+    BOOST_CHECK_EQUAL(s.values[1], 0);
+    BOOST_CHECK(isnan(s.mean));
+    BOOST_CHECK(isnan(s.stddev));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
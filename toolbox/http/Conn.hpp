@@ -61,7 +61,9 @@ class BasicConn
     , ep_{ep}
     , app_{app}
     {
-        sub_ = r.subscribe(*sock_, EpollIn, bind<&BasicConn::on_io_event>(this));
+        // Edge-triggered, so that toggling write interest does not require a system call.
+        sub_ = r.subscribe(*sock_, EpollIn | EpollRdHup | EpollEt,
+                           bind<&BasicConn::on_io_event>(this));
         schedule_timeout(now);
         app.on_http_connect(now, ep_);
     }
@@ -183,8 +185,8 @@ class BasicConn
     {
         auto lock = this->lock_this(now);
         try {
-            if (events & (EpollIn | EpollHup)) {
-                if (!drain_input(now, fd)) {
+            if (events & (EpollIn | EpollRdHup | EpollHup)) {
+                if (!drain_input(now, fd, events & (EpollRdHup | EpollHup))) {
                     this->dispose(now);
                     return;
                 }
@@ -203,16 +205,18 @@ class BasicConn
             this->dispose(now);
         }
     }
-    bool drain_input(CyclTime now, int fd)
+    bool drain_input(CyclTime now, int fd, bool hangup)
     {
         // Limit the number of reads to avoid starvation.
-        for (int i{0}; i < 4; ++i) {
+        bool drained{false};
+        for (int i{0}; i < 4 && !drained; ++i) {
             std::error_code ec;
             const auto buf = in_.prepare(2944);
             const auto size = os::read(fd, buf, ec);
             if (ec) {
                 // No data available in socket buffer.
                 if (ec == std::errc::operation_would_block) {
+                    drained = true;
                     break;
                 }
                 throw std::system_error{ec, "read"};
@@ -226,10 +230,13 @@ class BasicConn
             // Commit actual bytes read.
             in_.commit(size);
             // Assume that the TCP stream has been drained if we read less than the requested
-            // amount.
-            if (static_cast<size_t>(size) < buffer_size(buf)) {
-                break;
-            }
+            // amount, unless the end of the stream is still to be read.
+            drained = !hangup && static_cast<size_t>(size) < buffer_size(buf);
+        }
+        if (!drained) {
+            // Resume reading on the next cycle, because the subscription is edge-triggered. Any
+            // hangup is retained, so that the end of the stream is still read.
+            sub_.set_ready(hangup ? EpollIn | EpollRdHup : EpollIn);
         }
         flush_input(now);
         // Reset timer.
@@ -240,7 +247,16 @@ class BasicConn
     void flush_output(CyclTime now)
     {
         // Attempt to flush buffered data.
-        out_.consume(sock_.write(out_.data()));
+        std::error_code ec;
+        const auto n = sock_.write(out_.data(), ec);
+        if (ec) {
+            // The readiness may have been consumed since it was signalled.
+            if (ec != std::errc::operation_would_block) {
+                throw std::system_error{ec, "write"};
+            }
+        } else {
+            out_.consume(n);
+        }
         if (out_.empty()) {
             if (!in_progress_ && !should_keep_alive()) {
                 this->dispose(now);
@@ -248,12 +264,12 @@ class BasicConn
             }
             if (write_blocked_) {
                 // Restore read-only state after the buffer has been drained.
-                sub_.set_events(EpollIn);
+                sub_.set_events(EpollIn | EpollRdHup | EpollEt);
                 write_blocked_ = false;
             }
         } else if (!write_blocked_) {
             // Set the state to read-write if the entire buffer could not be written.
-            sub_.set_events(EpollIn | EpollOut);
+            sub_.set_events(EpollIn | EpollOut | EpollRdHup | EpollEt);
             write_blocked_ = true;
         }
     }
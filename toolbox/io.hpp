@@ -18,6 +18,9 @@
 #define TOOLBOX_IO_HPP
 
 #include "io/Buffer.hpp"
+#include "io/CompletionQueue.hpp"
+#include "io/Coroutine.hpp"
+#include "io/CycleArena.hpp"
 #include "io/Disposer.hpp"
 #include "io/Epoll.hpp"
 #include "io/Event.hpp"
@@ -26,11 +29,14 @@
 #include "io/Handle.hpp"
 #include "io/Hook.hpp"
 #include "io/Inotify.hpp"
+#include "io/PerfEvent.hpp"
 #include "io/Reactor.hpp"
 #include "io/Runner.hpp"
+#include "io/ShmRing.hpp"
 #include "io/Stream.hpp"
 #include "io/Timer.hpp"
 #include "io/TimerFd.hpp"
 #include "io/Waker.hpp"
+#include "io/Warmup.hpp"
 
 #endif // TOOLBOX_IO_HPP
@@ -16,9 +16,17 @@
 
 #include "Buffer.hpp"
 
+#include <toolbox/sys/Memory.hpp>
+
 namespace toolbox {
 inline namespace io {
 
+void Buffer::prefault(std::size_t capacity)
+{
+    buf_.reserve(capacity);
+    sys::prefault(buf_.data() + buf_.size(), buf_.capacity() - buf_.size());
+}
+
 void Buffer::consume(std::size_t count) noexcept
 {
     enum { ShrinkThreshold = 1024 };
@@ -95,6 +95,9 @@ class TOOLBOX_API Buffer {
 
     /// Reserve storage.
     void reserve(std::size_t capacity) { buf_.reserve(capacity); }
+    /// Reserve storage, and fault-in the unused portion, so that subsequent writes do not incur
+    /// page faults.
+    void prefault(std::size_t capacity);
 
     char* wptr() noexcept { return buf_.data() + wpos_; }
 
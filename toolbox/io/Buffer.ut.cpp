@@ -154,4 +154,18 @@ BOOST_AUTO_TEST_CASE(ShrinkLargeCase)
     BOOST_CHECK_EQUAL(static_cast<const char*>(buf.data().data()), base);
 }
 
+BOOST_AUTO_TEST_CASE(PrefaultCase)
+{
+    Buffer buf;
+    buf.prepare(3);
+    buf.commit(3);
+    buf.prefault(1 << 20);
+    BOOST_CHECK_EQUAL(buf.str().size(), 3U);
+
+    // Writes within the prefaulted capacity do not reallocate.
+    const auto* const wptr = buf.wptr();
+    const auto out = buf.prepare((1 << 20) - 3);
+    BOOST_CHECK_EQUAL(out.data(), wptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
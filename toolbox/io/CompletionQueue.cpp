@@ -0,0 +1,70 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CompletionQueue.hpp"
+
+#include <toolbox/io/EventFd.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace toolbox {
+inline namespace io {
+using namespace std;
+
+struct CompletionQueue::Shared {
+    mutex mtx;
+    vector<unique_ptr<Node>> nodes;
+    EventFd efd{0, EFD_NONBLOCK};
+};
+
+CompletionQueue::CompletionQueue(Reactor& r)
+: shared_{make_shared<Shared>()}
+{
+    sub_ = r.subscribe(shared_->efd.fd(), EpollIn, bind<&CompletionQueue::on_io_event>(this));
+}
+
+CompletionQueue::~CompletionQueue() = default;
+
+void CompletionQueue::post(const shared_ptr<Shared>& shared, unique_ptr<Node> node)
+{
+    bool was_empty;
+    {
+        lock_guard lock{shared->mtx};
+        was_empty = shared->nodes.empty();
+        shared->nodes.push_back(std::move(node));
+    }
+    // The reactor has already been signalled if the queue was not empty.
+    if (was_empty) {
+        error_code ec;
+        shared->efd.write(1, ec);
+    }
+}
+
+void CompletionQueue::on_io_event(CyclTime now, int /*fd*/, unsigned /*events*/)
+{
+    shared_->efd.read();
+    vector<unique_ptr<Node>> nodes;
+    {
+        lock_guard lock{shared_->mtx};
+        nodes.swap(shared_->nodes);
+    }
+    for (auto& node : nodes) {
+        node->run(now);
+    }
+}
+
+} // namespace io
+} // namespace toolbox
@@ -0,0 +1,130 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_IO_COMPLETIONQUEUE_HPP
+#define TOOLBOX_IO_COMPLETIONQUEUE_HPP
+
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/util/ThreadPool.hpp>
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+namespace toolbox {
+inline namespace io {
+
+/// Queue of completion handlers that are posted from other threads, and invoked on a Reactor.
+///
+/// The reactor is only signalled when the queue becomes non-empty, so a burst of completions costs
+/// a single wakeup. Handlers that are still queued when the CompletionQueue is destroyed are
+/// discarded without being invoked.
+class TOOLBOX_API CompletionQueue {
+  public:
+    explicit CompletionQueue(Reactor& r);
+    ~CompletionQueue();
+
+    // Copy.
+    CompletionQueue(const CompletionQueue&) = delete;
+    CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+    // Move.
+    CompletionQueue(CompletionQueue&&) = delete;
+    CompletionQueue& operator=(CompletionQueue&&) = delete;
+
+    /// Posts a handler, which is invoked as fn(now) on the reactor thread. Thread-safe.
+    template <typename FnT>
+    void post(FnT&& fn)
+    {
+        post(shared_, std::make_unique<NodeImpl<std::decay_t<FnT>>>(std::forward<FnT>(fn)));
+    }
+
+    /// Runs work on the thread pool, and then invokes done on the reactor thread with the result.
+    ///
+    /// The done handler is invoked as done(now, result, e), or done(now, e) if work returns void.
+    /// If work throws, then the result is value-initialised and the exception is set. Results of
+    /// work that completes after the CompletionQueue is destroyed are discarded.
+    ///
+    /// \return false if the pool has been stopped.
+    template <typename WorkT, typename DoneT>
+    bool submit(ThreadPool& pool, WorkT work, DoneT done)
+    {
+        return pool.submit([shared = shared_, work = std::move(work),
+                            done = std::move(done)]() mutable {
+            using ResultT = std::invoke_result_t<WorkT&>;
+            std::exception_ptr e;
+            if constexpr (std::is_void_v<ResultT>) {
+                try {
+                    work();
+                } catch (...) {
+                    e = std::current_exception();
+                }
+                post(shared, std::make_unique<NodeImpl<Bound<DoneT>>>(std::move(done), e));
+            } else {
+                ResultT result{};
+                try {
+                    result = work();
+                } catch (...) {
+                    e = std::current_exception();
+                }
+                post(shared,
+                     std::make_unique<NodeImpl<BoundResult<DoneT, ResultT>>>(
+                         std::move(done), std::move(result), e));
+            }
+        });
+    }
+
+  private:
+    struct Node {
+        virtual ~Node() = default;
+        virtual void run(CyclTime now) = 0;
+    };
+    template <typename FnT>
+    struct NodeImpl final : Node {
+        template <typename... ArgsT>
+        explicit NodeImpl(ArgsT&&... args)
+        : fn{std::forward<ArgsT>(args)...}
+        {
+        }
+        void run(CyclTime now) override { fn(now); }
+        FnT fn;
+    };
+    template <typename DoneT>
+    struct Bound {
+        void operator()(CyclTime now) { done(now, e); }
+        DoneT done;
+        std::exception_ptr e;
+    };
+    template <typename DoneT, typename ResultT>
+    struct BoundResult {
+        void operator()(CyclTime now) { done(now, std::move(result), e); }
+        DoneT done;
+        ResultT result;
+        std::exception_ptr e;
+    };
+    struct Shared;
+
+    static void post(const std::shared_ptr<Shared>& shared, std::unique_ptr<Node> node);
+    void on_io_event(CyclTime now, int fd, unsigned events);
+
+    // State shared with pool tasks, which may outlive this object.
+    std::shared_ptr<Shared> shared_;
+    Reactor::Handle sub_;
+};
+
+} // namespace io
+} // namespace toolbox
+
+#endif // TOOLBOX_IO_COMPLETIONQUEUE_HPP
@@ -0,0 +1,100 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CompletionQueue.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <future>
+#include <thread>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(CompletionQueueSuite)
+
+BOOST_AUTO_TEST_CASE(CompletionQueueCase)
+{
+    using namespace chrono_literals;
+    Reactor r{8};
+    CompletionQueue cq{r};
+    int count{0};
+
+    thread t{[&cq, &count]() {
+        for (int i{0}; i < 3; ++i) {
+            cq.post([&count](CyclTime) { ++count; });
+        }
+    }};
+    t.join();
+    BOOST_CHECK_EQUAL(count, 0);
+    // A single wakeup runs all pending handlers.
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK_EQUAL(count, 3);
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CompletionQueueSubmitCase)
+{
+    using namespace chrono_literals;
+    Reactor r{8};
+    CompletionQueue cq{r};
+    ThreadPool pool{2, "worker"s};
+    const auto tid = this_thread::get_id();
+
+    int sum{0}, errors{0}, done{0};
+    for (int i{1}; i <= 10; ++i) {
+        cq.submit(
+            pool, [i]() { return make_unique<int>(i); },
+            [&, tid](CyclTime, unique_ptr<int>&& val, exception_ptr e) {
+                BOOST_CHECK(this_thread::get_id() == tid);
+                BOOST_CHECK(!e);
+                sum += *val;
+                ++done;
+            });
+    }
+    cq.submit(
+        pool, []() { throw runtime_error{"test"}; },
+        [&](CyclTime, exception_ptr e) {
+            errors += e != nullptr;
+            ++done;
+        });
+    while (done < 11) {
+        r.poll(CyclTime::now(), 1s);
+    }
+    BOOST_CHECK_EQUAL(sum, 55);
+    BOOST_CHECK_EQUAL(errors, 1);
+}
+
+BOOST_AUTO_TEST_CASE(CompletionQueueLifetimeCase)
+{
+    ThreadPool pool{1, "worker"s};
+    promise<void> release;
+    auto fut = release.get_future();
+    bool invoked{false};
+    {
+        Reactor r{8};
+        CompletionQueue cq{r};
+        cq.submit(
+            pool, [&fut]() { fut.wait(); }, [&invoked](CyclTime, exception_ptr) { invoked = true; });
+    }
+    // The result is discarded after the queue has been destroyed.
+    release.set_value();
+    promise<void> p;
+    pool.submit([&p]() { p.set_value(); });
+    p.get_future().wait();
+    BOOST_CHECK(!invoked);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,56 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Coroutine.hpp"
+
+#include <toolbox/sys/Log.hpp>
+
+namespace toolbox {
+inline namespace io {
+using namespace std;
+
+void detail::report_detached_error(exception_ptr e) noexcept
+{
+    try {
+        rethrow_exception(e);
+    } catch (const exception& e) {
+        TOOLBOX_ERROR << "exception in detached task: " << e.what();
+    } catch (...) {
+        TOOLBOX_ERROR << "unknown exception in detached task";
+    }
+}
+
+AsyncFd::AsyncFd(Reactor& r, int fd)
+: sub_{r.subscribe(fd, EpollIn | EpollOut | EpollEt, bind<&AsyncFd::on_io_event>(this))}
+{
+}
+
+void AsyncFd::on_io_event(CyclTime /*now*/, int /*fd*/, unsigned events)
+{
+    ready_ |= events;
+    // Take both waiters before resuming either, because a resumed coroutine may destroy this
+    // object.
+    const auto reader = reader_ && take(EpollIn) ? exchange(reader_, nullptr) : nullptr;
+    const auto writer = writer_ && take(EpollOut) ? exchange(writer_, nullptr) : nullptr;
+    if (reader) {
+        reader.resume();
+    }
+    if (writer) {
+        writer.resume();
+    }
+}
+
+} // namespace io
+} // namespace toolbox
@@ -0,0 +1,417 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_IO_COROUTINE_HPP
+#define TOOLBOX_IO_COROUTINE_HPP
+
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/util/Slab.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace toolbox {
+inline namespace io {
+
+template <typename ValueT = void>
+class Task;
+
+namespace detail {
+
+/// Logs an exception that escaped a detached task.
+TOOLBOX_API void report_detached_error(std::exception_ptr e) noexcept;
+
+struct PromiseBase {
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename PromiseT>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> h) noexcept
+        {
+            auto& p = h.promise();
+            if (p.cont) {
+                // Symmetric transfer to the awaiting coroutine.
+                return p.cont;
+            }
+            if (p.detached) {
+                if (p.error) {
+                    report_detached_error(p.error);
+                }
+                h.destroy();
+            }
+            return std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    // Frames are allocated from the calling thread's slab heap.
+    static void* operator new(std::size_t size) { return slab_allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) noexcept
+    {
+        slab_deallocate(ptr, size);
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+
+    void rethrow_if_error() const
+    {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::coroutine_handle<> cont;
+    std::exception_ptr error;
+    bool detached{false};
+};
+
+template <typename ValueT>
+struct Promise : PromiseBase {
+    Task<ValueT> get_return_object() noexcept;
+    template <typename ArgT>
+    void return_value(ArgT&& arg)
+    {
+        value.emplace(std::forward<ArgT>(arg));
+    }
+    ValueT result()
+    {
+        rethrow_if_error();
+        return std::move(*value);
+    }
+    std::optional<ValueT> value;
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void result() const { rethrow_if_error(); }
+};
+
+} // namespace detail
+
+/// Lazily started coroutine, for sequencing multi-step protocols on a Reactor.
+///
+/// A Task does not run until it is awaited, or passed to spawn(). When awaited, control transfers
+/// directly to the task, and back to the awaiting coroutine when it completes, without involving
+/// the reactor. Exceptions propagate to the awaiting coroutine.
+///
+/// Tasks suspend on the awaitables below, which are resumed inline from the reactor's i/o and
+/// timer dispatch, with the same cost as a callback. Destroying a suspended task cancels any
+/// pending subscription or timer.
+template <typename ValueT>
+class [[nodiscard]] Task {
+  public:
+    using promise_type = detail::Promise<ValueT>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle h) noexcept
+    : h_{h}
+    {
+    }
+    Task() noexcept = default;
+    ~Task()
+    {
+        if (h_) {
+            h_.destroy();
+        }
+    }
+
+    // Copy.
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    // Move.
+    Task(Task&& rhs) noexcept
+    : h_{std::exchange(rhs.h_, nullptr)}
+    {
+    }
+    Task& operator=(Task&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            if (h_) {
+                h_.destroy();
+            }
+            h_ = std::exchange(rhs.h_, nullptr);
+        }
+        return *this;
+    }
+
+    bool empty() const noexcept { return !h_; }
+    explicit operator bool() const noexcept { return static_cast<bool>(h_); }
+    bool done() const noexcept { return h_ && h_.done(); }
+    Handle release() noexcept { return std::exchange(h_, nullptr); }
+    /// Runs the task until it first suspends. The caller retains ownership, so destroying the Task
+    /// cancels it.
+    void start()
+    {
+        assert(h_ && !h_.done());
+        h_.resume();
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter {
+            bool await_ready() const noexcept { return h.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> cont) noexcept
+            {
+                h.promise().cont = cont;
+                return h;
+            }
+            ValueT await_resume() { return h.promise().result(); }
+            Handle h;
+        };
+        return Awaiter{h_};
+    }
+
+  private:
+    Handle h_;
+};
+
+namespace detail {
+template <typename ValueT>
+inline Task<ValueT> Promise<ValueT>::get_return_object() noexcept
+{
+    return Task<ValueT>{std::coroutine_handle<Promise>::from_promise(*this)};
+}
+inline Task<void> Promise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<Promise>::from_promise(*this)};
+}
+} // namespace detail
+
+/// Starts a task that runs independently of the caller.
+///
+/// The task runs inline until it first suspends, and its frame is destroyed when it completes.
+/// Exceptions that escape the task are logged. A detached task must not outlive the objects that
+/// it refers to, including the Reactor.
+inline void spawn(Task<void> task)
+{
+    const auto h = task.release();
+    h.promise().detached = true;
+    h.resume();
+}
+
+/// Awaitable that suspends until a timer expires.
+class TOOLBOX_API SleepAwaiter {
+  public:
+    SleepAwaiter(Reactor& r, MonoTime expiry, Priority priority) noexcept
+    : r_{r}
+    , expiry_{expiry}
+    , priority_{priority}
+    {
+    }
+    ~SleepAwaiter() { tmr_.cancel(); }
+
+    // Copy.
+    SleepAwaiter(const SleepAwaiter&) = delete;
+    SleepAwaiter& operator=(const SleepAwaiter&) = delete;
+
+    // Move.
+    SleepAwaiter(SleepAwaiter&&) = delete;
+    SleepAwaiter& operator=(SleepAwaiter&&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        h_ = h;
+        tmr_ = r_.timer(expiry_, priority_, bind<&SleepAwaiter::on_timer>(this));
+    }
+    void await_resume() const noexcept {}
+
+  private:
+    void on_timer(CyclTime /*now*/, Timer& /*tmr*/)
+    {
+        // The timer has already been popped from the queue, so it is released rather than
+        // cancelled before the awaiter is destroyed by the resumed coroutine.
+        tmr_ = nullptr;
+        h_.resume();
+    }
+
+    Reactor& r_;
+    const MonoTime expiry_;
+    const Priority priority_;
+    std::coroutine_handle<> h_;
+    Timer tmr_;
+};
+
+/// Suspends until the expiry time.
+inline SleepAwaiter sleep_until(Reactor& r, MonoTime expiry, Priority priority = Priority::Low)
+{
+    return {r, expiry, priority};
+}
+
+/// Suspends for the duration, relative to the current cycle time.
+inline SleepAwaiter sleep_for(Reactor& r, Duration d, Priority priority = Priority::Low)
+{
+    return {r, CyclTime::current().mono_time() + d, priority};
+}
+
+/// Awaitable that subscribes to a file descriptor, and suspends until one of the events is
+/// signalled. The result is the signalled events.
+///
+/// The descriptor is subscribed and unsubscribed on each wait, so AsyncFd should be preferred for
+/// descriptors that are waited on repeatedly.
+class TOOLBOX_API IoAwaiter {
+  public:
+    IoAwaiter(Reactor& r, int fd, unsigned events) noexcept
+    : r_{r}
+    , fd_{fd}
+    , events_{events}
+    {
+    }
+    ~IoAwaiter() = default;
+
+    // Copy.
+    IoAwaiter(const IoAwaiter&) = delete;
+    IoAwaiter& operator=(const IoAwaiter&) = delete;
+
+    // Move.
+    IoAwaiter(IoAwaiter&&) = delete;
+    IoAwaiter& operator=(IoAwaiter&&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        h_ = h;
+        sub_ = r_.subscribe(fd_, events_, bind<&IoAwaiter::on_io_event>(this));
+    }
+    unsigned await_resume() const noexcept { return events_; }
+
+  private:
+    void on_io_event(CyclTime /*now*/, int /*fd*/, unsigned events)
+    {
+        events_ = events;
+        sub_.reset();
+        h_.resume();
+    }
+
+    Reactor& r_;
+    const int fd_;
+    unsigned events_;
+    std::coroutine_handle<> h_;
+    Reactor::Handle sub_;
+};
+
+/// Suspends until the file descriptor is readable.
+inline IoAwaiter readable(Reactor& r, int fd) noexcept
+{
+    return {r, fd, EpollIn};
+}
+
+/// Suspends until the file descriptor is writable.
+inline IoAwaiter writable(Reactor& r, int fd) noexcept
+{
+    return {r, fd, EpollOut};
+}
+
+/// Edge-triggered subscription for a file descriptor that is read and written by coroutines.
+///
+/// The descriptor is subscribed once for input and output. Readiness is latched when signalled, so
+/// that a coroutine that reads or writes until EAGAIN, and then awaits readable() or writable(),
+/// neither misses an edge nor modifies the subscription. At most one coroutine may await each
+/// direction at a time.
+class TOOLBOX_API AsyncFd {
+    class Awaiter {
+      public:
+        Awaiter(AsyncFd& afd, unsigned events) noexcept
+        : afd_{afd}
+        , events_{events}
+        {
+        }
+        ~Awaiter()
+        {
+            // Clear the waiter if the coroutine is destroyed while suspended. The AsyncFd is not
+            // accessed once the coroutine has been resumed, because it may have been destroyed.
+            if (h_) {
+                auto& waiter = afd_.waiter(events_);
+                if (waiter == h_) {
+                    waiter = nullptr;
+                }
+            }
+        }
+
+        // Copy.
+        Awaiter(const Awaiter&) = delete;
+        Awaiter& operator=(const Awaiter&) = delete;
+
+        // Move.
+        Awaiter(Awaiter&&) = delete;
+        Awaiter& operator=(Awaiter&&) = delete;
+
+        bool await_ready() noexcept { return afd_.take(events_); }
+        void await_suspend(std::coroutine_handle<> h) noexcept
+        {
+            assert(!afd_.waiter(events_));
+            h_ = h;
+            afd_.waiter(events_) = h;
+        }
+        void await_resume() noexcept { h_ = nullptr; }
+
+      private:
+        AsyncFd& afd_;
+        const unsigned events_;
+        std::coroutine_handle<> h_;
+    };
+
+  public:
+    AsyncFd(Reactor& r, int fd);
+    ~AsyncFd() = default;
+
+    // Copy.
+    AsyncFd(const AsyncFd&) = delete;
+    AsyncFd& operator=(const AsyncFd&) = delete;
+
+    // Move.
+    AsyncFd(AsyncFd&&) = delete;
+    AsyncFd& operator=(AsyncFd&&) = delete;
+
+    int fd() const noexcept { return sub_.fd(); }
+
+    /// Suspends until the descriptor is readable, or an error or hangup is signalled. Completes
+    /// immediately if readiness was signalled since the last wait.
+    Awaiter readable() noexcept { return {*this, EpollIn}; }
+    /// Suspends until the descriptor is writable, or an error or hangup is signalled. Completes
+    /// immediately if readiness was signalled since the last wait.
+    Awaiter writable() noexcept { return {*this, EpollOut}; }
+
+  private:
+    std::coroutine_handle<>& waiter(unsigned events) noexcept
+    {
+        return events == EpollIn ? reader_ : writer_;
+    }
+    /// Consumes readiness for events.
+    bool take(unsigned events) noexcept
+    {
+        if ((ready_ & (events | EpollErr | EpollHup)) == 0) {
+            return false;
+        }
+        ready_ &= ~events;
+        return true;
+    }
+    void on_io_event(CyclTime now, int fd, unsigned events);
+
+    Reactor::Handle sub_;
+    unsigned ready_{0};
+    std::coroutine_handle<> reader_, writer_;
+};
+
+} // namespace io
+} // namespace toolbox
+
+#endif // TOOLBOX_IO_COROUTINE_HPP
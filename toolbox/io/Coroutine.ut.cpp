@@ -0,0 +1,217 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Coroutine.hpp"
+
+#include <toolbox/net/IoSock.hpp>
+#include <toolbox/net/Endpoint.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+Task<int> add(int a, int b)
+{
+    co_return a + b;
+}
+
+Task<int> sum(int n)
+{
+    int total{0};
+    for (int i{0}; i < n; ++i) {
+        total += co_await add(i, 1);
+    }
+    co_return total;
+}
+
+Task<> fail()
+{
+    throw runtime_error{"test"};
+    co_return;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(CoroutineSuite)
+
+BOOST_AUTO_TEST_CASE(CoroutineTaskCase)
+{
+    int result{0};
+    string error;
+    spawn([](int& result, string& error) -> Task<> {
+        result = co_await sum(10);
+        try {
+            co_await fail();
+        } catch (const runtime_error& e) {
+            error = e.what();
+        }
+    }(result, error));
+    // No suspension points, so the task completes inline.
+    BOOST_CHECK_EQUAL(result, 55);
+    BOOST_CHECK_EQUAL(error, "test");
+
+    auto t = add(1, 2);
+    BOOST_CHECK(t);
+    BOOST_CHECK(!t.done());
+    t.start();
+    BOOST_CHECK(t.done());
+}
+
+BOOST_AUTO_TEST_CASE(CoroutineSleepCase)
+{
+    using namespace chrono_literals;
+    Reactor r{8};
+    vector<int> order;
+    auto sleeper = [](Reactor& r, Duration d, int id, vector<int>& order) -> Task<> {
+        co_await sleep_for(r, d);
+        order.push_back(id);
+        co_await sleep_for(r, d);
+        order.push_back(id);
+    };
+    spawn(sleeper(r, 2ms, 1, order));
+    spawn(sleeper(r, 1ms, 2, order));
+    BOOST_CHECK(order.empty());
+    while (order.size() < 4) {
+        r.poll(CyclTime::now(), 10ms);
+    }
+    BOOST_CHECK_EQUAL(order[0], 2);
+    BOOST_CHECK_EQUAL(order[3], 1);
+}
+
+BOOST_AUTO_TEST_CASE(CoroutineAsyncFdCase)
+{
+    using namespace chrono_literals;
+    Reactor r{8};
+    auto [tx, rx] = socketpair(UnixStreamProtocol{});
+    rx.set_non_block();
+    AsyncFd afd{r, rx.get()};
+
+    string received;
+    spawn([](AsyncFd& afd, IoSock& rx, string& received) -> Task<> {
+        char buf[64];
+        for (;;) {
+            error_code ec;
+            const auto n = rx.read(buf, sizeof(buf), ec);
+            if (n > 0) {
+                received.append(buf, n);
+            } else if (n == 0) {
+                break;
+            } else if (ec == errc::operation_would_block) {
+                co_await afd.readable();
+            } else {
+                throw system_error{ec, "read"};
+            }
+        }
+    }(afd, rx, received));
+
+    // The socket is writable, which is latched but does not resume the reader.
+    r.poll(CyclTime::now(), 0ms);
+    BOOST_CHECK(received.empty());
+
+    tx.send("foo", 3, 0);
+    r.poll(CyclTime::now(), 0ms);
+    BOOST_CHECK_EQUAL(received, "foo");
+
+    // No event is signalled while the socket remains readable, because the subscription is
+    // edge-triggered.
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 0);
+
+    tx.send("bar", 3, 0);
+    tx.close();
+    r.poll(CyclTime::now(), 0ms);
+    BOOST_CHECK_EQUAL(received, "foobar");
+
+    // The writable edge is consumed without suspending.
+    bool writable{false};
+    spawn([](AsyncFd& afd, bool& writable) -> Task<> {
+        co_await afd.writable();
+        writable = true;
+    }(afd, writable));
+    BOOST_CHECK(writable);
+}
+
+BOOST_AUTO_TEST_CASE(CoroutineAsyncFdDestroyCase)
+{
+    using namespace chrono_literals;
+    Reactor r{8};
+    auto [tx, rx] = socketpair(UnixStreamProtocol{});
+    auto afd = make_unique<AsyncFd>(r, rx.get());
+
+    // The writer is resumed after the reader has destroyed the AsyncFd.
+    bool read{false}, written{false};
+    spawn([](unique_ptr<AsyncFd>& afd, bool& written) -> Task<> {
+        co_await afd->writable();
+        written = true;
+    }(afd, written));
+    spawn([](unique_ptr<AsyncFd>& afd, bool& read) -> Task<> {
+        co_await afd->readable();
+        afd.reset();
+        read = true;
+    }(afd, read));
+
+    tx.send("foo", 3, 0);
+    r.poll(CyclTime::now(), 0ms);
+    BOOST_CHECK(read);
+    BOOST_CHECK(written);
+    BOOST_CHECK(!afd);
+}
+
+BOOST_AUTO_TEST_CASE(CoroutineCancelCase)
+{
+    using namespace chrono_literals;
+    Reactor r{8};
+    auto [tx, rx] = socketpair(UnixStreamProtocol{});
+    bool resumed{false};
+    auto wait = [](Reactor& r, int fd, bool& resumed) -> Task<> {
+        co_await readable(r, fd);
+        resumed = true;
+    };
+
+    auto t = wait(r, rx.get(), resumed);
+    t.start();
+    tx.send("x", 1, 0);
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK(resumed);
+    BOOST_CHECK(t.done());
+
+    // Destroying a suspended task cancels the subscription.
+    resumed = false;
+    t = wait(r, rx.get(), resumed);
+    t.start();
+    t = {};
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 0);
+    BOOST_CHECK(!resumed);
+
+    // And timers.
+    auto s = [](Reactor& r, bool& resumed) -> Task<> {
+        co_await sleep_for(r, 1ms);
+        resumed = true;
+    }(r, resumed);
+    s.start();
+    s = {};
+    this_thread::sleep_for(2ms);
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 0);
+    BOOST_CHECK(!resumed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,31 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CycleArena.hpp"
+
+namespace toolbox {
+inline namespace io {
+
+CycleArena::CycleArena(Reactor& r, std::size_t block_size, Reactor::HookType ht)
+: Arena{block_size}
+, hook_{bind<&CycleArena::on_end_of_cycle>(this)}
+{
+    r.add_hook(hook_, ht);
+}
+
+CycleArena::~CycleArena() = default;
+
+} // namespace io
+} // namespace toolbox
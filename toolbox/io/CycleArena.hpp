@@ -0,0 +1,53 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_IO_CYCLEARENA_HPP
+#define TOOLBOX_IO_CYCLEARENA_HPP
+
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/util/Arena.hpp>
+
+namespace toolbox {
+inline namespace io {
+
+/// Arena that is reset at the end of each Reactor cycle.
+///
+/// Memory allocated from the arena by event handlers is valid until the end of the cycle in which
+/// it was allocated. By default, the arena is reset by an EndOfEventDispatch hook, which runs
+/// after any cycle in which events were dispatched, without preventing the Reactor from blocking.
+class TOOLBOX_API CycleArena : public Arena {
+  public:
+    explicit CycleArena(Reactor& r, std::size_t block_size = 64 * 1024,
+                        Reactor::HookType ht = Reactor::HookType::EndOfEventDispatch);
+    ~CycleArena() override;
+
+    // Copy.
+    CycleArena(const CycleArena&) = delete;
+    CycleArena& operator=(const CycleArena&) = delete;
+
+    // Move.
+    CycleArena(CycleArena&&) = delete;
+    CycleArena& operator=(CycleArena&&) = delete;
+
+  private:
+    void on_end_of_cycle(CyclTime /*now*/) noexcept { reset(); }
+
+    Hook hook_;
+};
+
+} // namespace io
+} // namespace toolbox
+
+#endif // TOOLBOX_IO_CYCLEARENA_HPP
@@ -21,6 +21,7 @@
 #include <toolbox/io/TimerFd.hpp>
 
 #include <sys/epoll.h>
+#include <sys/ioctl.h>
 
 namespace toolbox {
 namespace os {
@@ -107,6 +108,59 @@ inline int epoll_wait(int epfd, epoll_event* events, int maxevents, int timeout)
     return ret;
 }
 
+/// Busy poll parameters of an epoll instance. The layout matches struct epoll_params.
+struct EpollParams {
+    std::uint32_t busy_poll_usecs;
+    std::uint16_t busy_poll_budget;
+    std::uint8_t prefer_busy_poll;
+    std::uint8_t pad;
+};
+static_assert(sizeof(EpollParams) == 8);
+
+// The epoll ioctls were added in Linux 6.9, so they are defined here for older kernel headers.
+constexpr unsigned long EpollIocSetParams{_IOW(0x8A, 0x01, EpollParams)};
+constexpr unsigned long EpollIocGetParams{_IOR(0x8A, 0x02, EpollParams)};
+
+/// Set the busy poll parameters of an epoll instance. Fails with ENOTTY on kernels before 6.9.
+inline void epoll_set_params(int epfd, const EpollParams& params, std::error_code& ec) noexcept
+{
+    const auto ret = ::ioctl(epfd, EpollIocSetParams, &params);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+}
+
+/// Set the busy poll parameters of an epoll instance. Fails with ENOTTY on kernels before 6.9.
+inline void epoll_set_params(int epfd, const EpollParams& params)
+{
+    const auto ret = ::ioctl(epfd, EpollIocSetParams, &params);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "ioctl"};
+    }
+}
+
+/// Get the busy poll parameters of an epoll instance.
+inline EpollParams epoll_get_params(int epfd, std::error_code& ec) noexcept
+{
+    EpollParams params{};
+    const auto ret = ::ioctl(epfd, EpollIocGetParams, &params);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+    return params;
+}
+
+/// Get the busy poll parameters of an epoll instance.
+inline EpollParams epoll_get_params(int epfd)
+{
+    EpollParams params{};
+    const auto ret = ::ioctl(epfd, EpollIocGetParams, &params);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "ioctl"};
+    }
+    return params;
+}
+
 } // namespace os
 inline namespace io {
 
@@ -150,10 +204,35 @@ enum : unsigned {
     /// and no other events will be reported by the epoll interface. The user must call epoll_ctl()
     /// with EPOLL_CTL_MOD to rearm the file descriptor with a new event mask.
     EpollOneShot = EPOLLONESHOT,
+
+    /// Sets an exclusive wakeup mode for the epoll file descriptor that is being attached to the
+    /// target file descriptor. When a wakeup event occurs and multiple epoll file descriptors are
+    /// attached to the same target file using EPOLLEXCLUSIVE, one or more of the epoll file
+    /// descriptors will receive an event with epoll_wait(2). This avoids thundering herds when a
+    /// listening socket is shared by several reactors. EPOLLEXCLUSIVE cannot be used with
+    /// EPOLL_CTL_MOD.
+    EpollExclusive = EPOLLEXCLUSIVE,
 };
 
 using EpollEvent = epoll_event;
 
+/// Busy poll configuration of an epoll instance.
+///
+/// When enabled, a wait with no events available busy polls the device queues of the ready list's
+/// sockets for up to the timeout, instead of sleeping until an interrupt is delivered. Non-blocking
+/// waits also perform a single busy poll pass, so a reactor that spins with a zero timeout drives
+/// the device queues directly. On kernels before 6.9, the net.core.busy_poll sysctl provides a
+/// system-wide equivalent.
+struct BusyPollConfig {
+    /// Busy poll time for each wait, or zero to disable.
+    Micros timeout{0};
+    /// Maximum number of packets processed by each busy poll. Values above 64 require CAP_NET_ADMIN.
+    int budget{8};
+    /// Prefer busy polling over softirq processing. Effective only when the device is configured
+    /// to defer hard interrupts.
+    bool prefer{false};
+};
+
 class Epoll {
   public:
     using Event = EpollEvent;
@@ -222,6 +301,32 @@ class Epoll {
         // Do not block if timer is zero.
         return os::epoll_wait(*epfd_, buf, size, is_zero(timeout) ? 0 : -1, ec);
     }
+    BusyPollConfig busy_poll(std::error_code& ec) const noexcept
+    {
+        const auto params = os::epoll_get_params(*epfd_, ec);
+        return {Micros{params.busy_poll_usecs}, params.busy_poll_budget,
+                params.prefer_busy_poll != 0};
+    }
+    BusyPollConfig busy_poll() const
+    {
+        const auto params = os::epoll_get_params(*epfd_);
+        return {Micros{params.busy_poll_usecs}, params.busy_poll_budget,
+                params.prefer_busy_poll != 0};
+    }
+    void set_busy_poll(const BusyPollConfig& config, std::error_code& ec) noexcept
+    {
+        os::epoll_set_params(*epfd_, make_params(config), ec);
+    }
+    void set_busy_poll(const BusyPollConfig& config)
+    {
+        os::epoll_set_params(*epfd_, make_params(config));
+    }
+    void add(int fd, int sid, unsigned events, std::error_code& ec) noexcept
+    {
+        Event ev;
+        mod(ev, fd, sid, events);
+        os::epoll_ctl(*epfd_, EPOLL_CTL_ADD, fd, ev, ec);
+    }
     void add(int fd, int sid, unsigned events)
     {
         Event ev;
@@ -250,6 +355,12 @@ class Epoll {
     }
 
   private:
+    static os::EpollParams make_params(const BusyPollConfig& config) noexcept
+    {
+        return {static_cast<std::uint32_t>(config.timeout.count()),
+                static_cast<std::uint16_t>(config.budget),
+                static_cast<std::uint8_t>(config.prefer ? 1 : 0), 0};
+    }
     static void mod(Event& ev, int fd, int sid, unsigned events) noexcept
     {
         ev.events = events;
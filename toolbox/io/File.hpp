@@ -24,7 +24,9 @@
 
 #include <fcntl.h>
 #include <stdio.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 
 namespace toolbox {
 namespace os {
@@ -69,6 +71,26 @@ inline FileHandle open(const char* path, int flags)
     return fd;
 }
 
+/// Create an anonymous file.
+inline FileHandle memfd_create(const char* name, unsigned flags, std::error_code& ec) noexcept
+{
+    const auto fd = ::memfd_create(name, flags);
+    if (fd < 0) {
+        ec = make_error(errno);
+    }
+    return fd;
+}
+
+/// Create an anonymous file.
+inline FileHandle memfd_create(const char* name, unsigned flags)
+{
+    const auto fd = ::memfd_create(name, flags);
+    if (fd < 0) {
+        throw std::system_error{make_error(errno), "memfd_create"};
+    }
+    return fd;
+}
+
 inline void rename(const char* oldpath, const char* newpath, std::error_code& ec)
 {
     const auto ret = ::rename(oldpath, newpath);
@@ -223,6 +245,26 @@ inline std::size_t write(int fd, ConstBuffer buf)
     return write(fd, static_cast<const void*>(buf.data()), buffer_size(buf));
 }
 
+/// Write data from multiple buffers to a file descriptor.
+inline ssize_t writev(int fd, const iovec* iov, int iovcnt, std::error_code& ec) noexcept
+{
+    const auto ret = ::writev(fd, iov, iovcnt);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+    return ret;
+}
+
+/// Write data from multiple buffers to a file descriptor.
+inline std::size_t writev(int fd, const iovec* iov, int iovcnt)
+{
+    const auto ret = ::writev(fd, iov, iovcnt);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "writev"};
+    }
+    return ret;
+}
+
 /// File control.
 inline int fcntl(int fd, int cmd, std::error_code& ec) noexcept
 {
@@ -0,0 +1,75 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_IO_PERFEVENT_HPP
+#define TOOLBOX_IO_PERFEVENT_HPP
+
+#include <toolbox/io/Handle.hpp>
+#include <toolbox/sys/Error.hpp>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace toolbox {
+namespace os {
+
+/// Set up performance monitoring.
+inline FileHandle perf_event_open(const perf_event_attr& attr, pid_t pid, int cpu, int group_fd,
+                                  unsigned long flags, std::error_code& ec) noexcept
+{
+    const auto fd = ::syscall(SYS_perf_event_open, &attr, pid, cpu, group_fd, flags);
+    if (fd < 0) {
+        ec = make_error(errno);
+        return {};
+    }
+    return static_cast<int>(fd);
+}
+
+/// Set up performance monitoring.
+inline FileHandle perf_event_open(const perf_event_attr& attr, pid_t pid, int cpu, int group_fd,
+                                  unsigned long flags)
+{
+    const auto fd = ::syscall(SYS_perf_event_open, &attr, pid, cpu, group_fd, flags);
+    if (fd < 0) {
+        throw std::system_error{make_error(errno), "perf_event_open"};
+    }
+    return static_cast<int>(fd);
+}
+
+/// Perform a control operation on a performance monitoring file descriptor.
+inline void perf_event_ioctl(int fd, unsigned long request, unsigned long arg,
+                             std::error_code& ec) noexcept
+{
+    const auto ret = ::ioctl(fd, request, arg);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+}
+
+/// Perform a control operation on a performance monitoring file descriptor.
+inline void perf_event_ioctl(int fd, unsigned long request, unsigned long arg)
+{
+    const auto ret = ::ioctl(fd, request, arg);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "ioctl"};
+    }
+}
+
+} // namespace os
+} // namespace toolbox
+
+#endif // TOOLBOX_IO_PERFEVENT_HPP
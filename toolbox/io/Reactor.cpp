@@ -25,6 +25,15 @@ inline namespace io {
 using namespace std;
 namespace {
 constexpr size_t MaxEvents{128};
+// Readiness events that are latched for edge-triggered subscriptions.
+constexpr unsigned ReadyMask{EpollIn | EpollOut | EpollRdHup | EpollPri | EpollErr | EpollHup};
+
+// Edge-triggered subscriptions are registered for both input and output, so that the interest set
+// can be changed without modifying the registration.
+constexpr unsigned kernel_events(unsigned events) noexcept
+{
+    return (events & EpollEt) ? events | EpollIn | EpollOut : events;
+}
 
 int dispatch_low_priority_timers(CyclTime now, TimerQueue& tq, bool idle_cycle)
 {
@@ -54,6 +63,16 @@ Reactor::~Reactor()
     epoll_.del(notify_.fd());
 }
 
+void Reactor::reserve(std::size_t fds, std::size_t timers)
+{
+    if (fds > data_.size()) {
+        data_.resize(fds);
+    }
+    for (auto& tq : tqs_) {
+        tq.reserve(timers);
+    }
+}
+
 Reactor::Handle Reactor::subscribe(int fd, unsigned events, IoSlot slot)
 {
     assert(fd >= 0);
@@ -61,11 +80,27 @@ Reactor::Handle Reactor::subscribe(int fd, unsigned events, IoSlot slot)
     if (fd >= static_cast<int>(data_.size())) {
         data_.resize(fd + 1);
     }
+    // Each descriptor appears in the ready list at most once, and at most once more if it is
+    // scheduled again while the list is being dispatched, so the list cannot outgrow this.
+    // Likewise, each descriptor appears in the dirty list at most once.
+    if (ready_.capacity() < 2 * data_.size()) {
+        ready_.reserve(2 * data_.size());
+    }
+    if (dirty_.capacity() < data_.size()) {
+        dirty_.reserve(data_.size());
+    }
     auto& ref = data_[fd];
-    epoll_.add(fd, ++ref.sid, events);
+    const auto sid = ref.sid + 1;
+    const auto kevents = kernel_events(events);
+    epoll_.add(fd, sid, kevents);
+    ref.sid = sid;
+    ref.registered = kevents;
     ref.events = events;
     ref.slot = slot;
     ref.priority = Priority::Low;
+    // Readiness is reset for each subscription, so an existing entry in the ready list for this
+    // descriptor will find no events.
+    ref.ready = 0;
     return {*this, fd, ref.sid};
 }
 
@@ -74,9 +109,12 @@ int Reactor::poll(CyclTime now, Duration timeout)
     enum { High = 0, Low = 1 };
     using namespace chrono;
 
+    // Apply deferred changes to the interest list before waiting.
+    flush_updates();
+
     // If timeout is zero then the wait_until time should also be zero to signify no wait.
     MonoTime wait_until{};
-    if (!is_zero(timeout) && end_of_cycle_no_wait_hooks.empty()) {
+    if (!is_zero(timeout) && end_of_cycle_no_wait_hooks.empty() && ready_.empty()) {
         const MonoTime next
             = next_expiry(timeout == NoTimeout ? MonoClock::max() : now.mono_time() + timeout);
         if (next > now.mono_time()) {
@@ -112,6 +150,8 @@ int Reactor::poll(CyclTime now, Duration timeout)
     // I/O events.
     cycle_work_ += dispatch(now, buf, n, Priority::High);
     cycle_work_ += dispatch(now, buf, n, Priority::Low);
+    // Latched readiness of edge-triggered subscriptions.
+    cycle_work_ += dispatch_ready(now);
     // Low priority timers (typically only dispatched during empty cycles).
     cycle_work_ += dispatch_low_priority_timers(now, tqs_[Low], cycle_work_ == 0);
     // End of cycle hooks.
@@ -175,6 +215,8 @@ int Reactor::do_io_priority_poll(WallTime now) noexcept
                 last_time_priority_io_polled_ = WallClock::now();
             });
 
+            flush_updates();
+
             error_code ec;
             Event buf[MaxEvents];
 
@@ -238,7 +280,7 @@ int Reactor::dispatch(CyclTime now, Event* buf, int size, Priority priority)
 
         auto& ev = buf[i];
         const auto fd = Epoll::fd(ev);
-        const auto& ref = data_[fd];
+        auto& ref = data_[fd];
 
         if (ref.priority != priority) {
             continue;
@@ -263,7 +305,15 @@ int Reactor::dispatch(CyclTime now, Event* buf, int size, Priority priority)
         // the events since the call to wait() was made. This would typically happen via a reentrant
         // call into the reactor from an event-handler. N.B. EpollErr and EpollHup are always
         // reported if they occur, regardless of whether they are specified in events.
-        const auto events = ev.events & (ref.events | EpollErr | EpollHup);
+        unsigned events;
+        if (ref.events & EpollEt) {
+            // Latch readiness until it is dispatched to a handler that is interested in it.
+            ref.ready |= ev.events & ReadyMask;
+            events = ref.ready & (ref.events | EpollErr | EpollHup) & ReadyMask;
+            ref.ready &= ~events;
+        } else {
+            events = ev.events & (ref.events | EpollErr | EpollHup);
+        }
         if (!events) {
             continue;
         }
@@ -282,12 +332,18 @@ void Reactor::set_events(int fd, int sid, unsigned events, IoSlot slot, error_co
 {
     auto& ref = data_[fd];
     if (ref.sid == sid) {
+        if (set_events_lazily(fd, sid, events)) {
+            ref.slot = slot;
+            return;
+        }
         if (ref.events != events) {
-            epoll_.mod(fd, sid, events, ec);
+            epoll_.mod(fd, sid, kernel_events(events), ec);
             if (ec) {
                 return;
             }
             ref.events = events;
+            ref.registered = kernel_events(events);
+            ref.ready = 0;
         }
         ref.slot = slot;
     }
@@ -297,9 +353,15 @@ void Reactor::set_events(int fd, int sid, unsigned events, IoSlot slot)
 {
     auto& ref = data_[fd];
     if (ref.sid == sid) {
+        if (set_events_lazily(fd, sid, events)) {
+            ref.slot = slot;
+            return;
+        }
         if (ref.events != events) {
-            epoll_.mod(fd, sid, events);
+            epoll_.mod(fd, sid, kernel_events(events));
             ref.events = events;
+            ref.registered = kernel_events(events);
+            ref.ready = 0;
         }
         ref.slot = slot;
     }
@@ -307,22 +369,32 @@ void Reactor::set_events(int fd, int sid, unsigned events, IoSlot slot)
 
 void Reactor::set_events(int fd, int sid, unsigned events, error_code& ec) noexcept
 {
+    if (set_events_lazily(fd, sid, events)) {
+        return;
+    }
     auto& ref = data_[fd];
     if (ref.sid == sid && ref.events != events) {
-        epoll_.mod(fd, sid, events, ec);
+        epoll_.mod(fd, sid, kernel_events(events), ec);
         if (ec) {
             return;
         }
         ref.events = events;
+        ref.registered = kernel_events(events);
+        ref.ready = 0;
     }
 }
 
 void Reactor::set_events(int fd, int sid, unsigned events)
 {
+    if (set_events_lazily(fd, sid, events)) {
+        return;
+    }
     auto& ref = data_[fd];
     if (ref.sid == sid && ref.events != events) {
-        epoll_.mod(fd, sid, events);
+        epoll_.mod(fd, sid, kernel_events(events));
         ref.events = events;
+        ref.registered = kernel_events(events);
+        ref.ready = 0;
     }
 }
 
@@ -330,13 +402,132 @@ void Reactor::unsubscribe(int fd, int sid) noexcept
 {
     auto& ref = data_[fd];
     if (ref.sid == sid) {
+        // Removals are never deferred, because the caller may close the descriptor immediately
+        // afterwards. The registration belongs to the open file description, so it would outlive
+        // the descriptor if the file was shared by dup(), fork() or SCM_RIGHTS.
         epoll_.del(fd);
+        ref.registered = 0;
         ref.events = 0;
         ref.slot.reset();
         ref.priority = Priority::Low;
+        ref.ready = 0;
+    }
+}
+
+bool Reactor::set_events_lazily(int fd, int sid, unsigned events) noexcept
+{
+    auto& ref = data_[fd];
+    if (ref.sid != sid) {
+        return false;
+    }
+    if ((ref.events & events & EpollEt) && kernel_events(events) == ref.registered) {
+        // Only the interest set changes, so the registration is not modified. Events outside the
+        // registration, such as EpollRdHup or EpollPri, still require the registration to change.
+        ref.events = events;
+        if (ref.ready & (ref.events | EpollErr | EpollHup)) {
+            schedule_ready(fd);
+        }
+        return true;
+    }
+    if (deferred_) {
+        if (ref.events != events) {
+            ref.events = events;
+            ref.ready = 0;
+            mark_dirty(fd);
+        }
+        return true;
+    }
+    return false;
+}
+
+void Reactor::set_deferred_updates(bool enabled) noexcept
+{
+    if (deferred_ && !enabled) {
+        flush_updates();
+    }
+    deferred_ = enabled;
+}
+
+void Reactor::mark_dirty(int fd) noexcept
+{
+    auto& ref = data_[fd];
+    if (!ref.dirty) {
+        ref.dirty = true;
+        // Capacity is reserved by subscribe().
+        dirty_.push_back(fd);
+    }
+}
+
+void Reactor::flush_updates() noexcept
+{
+    for (const auto fd : dirty_) {
+        auto& ref = data_[fd];
+        ref.dirty = false;
+        // Only the final state is applied, so changes that cancel out require no system call.
+        // Descriptors that were unsubscribed in the meantime have already been removed.
+        const auto events = kernel_events(ref.events);
+        if (!ref.slot || events == ref.registered) {
+            continue;
+        }
+        error_code ec;
+        epoll_.mod(fd, ref.sid, events, ec);
+        if (ec) {
+            // The previous registration remains in effect.
+            TOOLBOX_ERROR << "failed to modify i/o subscription for fd " << fd << ": " << ec
+                          << " [" << ec.message() << ']';
+            continue;
+        }
+        ref.registered = events;
+    }
+    dirty_.clear();
+}
+
+void Reactor::set_ready(int fd, int sid, unsigned events) noexcept
+{
+    auto& ref = data_[fd];
+    if (ref.sid == sid && (ref.events & EpollEt)) {
+        ref.ready |= events & ReadyMask;
+        if (ref.ready & (ref.events | EpollErr | EpollHup)) {
+            schedule_ready(fd);
+        }
     }
 }
 
+void Reactor::schedule_ready(int fd) noexcept
+{
+    auto& ref = data_[fd];
+    if (!ref.scheduled) {
+        ref.scheduled = true;
+        // Capacity is reserved by subscribe().
+        ready_.push_back(fd);
+    }
+}
+
+int Reactor::dispatch_ready(CyclTime now)
+{
+    // Descriptors that are scheduled by these handlers are dispatched on the next cycle.
+    const auto n = ready_.size();
+    int work{0};
+    for (size_t i{0}; i < n; ++i) {
+        const auto fd = ready_[i];
+        auto& ref = data_[fd];
+        ref.scheduled = false;
+        const auto events = ref.ready & (ref.events | EpollErr | EpollHup) & ReadyMask;
+        if (!ref.slot || !events) {
+            continue;
+        }
+        ref.ready &= ~events;
+        try {
+            ref.slot(now, fd, events);
+        } catch (const std::exception& e) {
+            TOOLBOX_ERROR << "exception in i/o event handler: " << e.what();
+        }
+        ++work;
+    }
+    ready_.erase(ready_.begin(), ready_.begin() + n);
+    return work;
+}
+
 void Reactor::set_io_priority(int fd, int sid, Priority priority) noexcept
 {
     auto& ref = data_[fd];
@@ -125,6 +125,15 @@ class TOOLBOX_API Reactor : public Waker {
             reactor_->set_io_priority(fd_, sid_, priority);
         }
 
+        /// Latch readiness for events on an edge-triggered subscription, so that the handler is
+        /// invoked again on the next cycle if it is interested in them. This is used by handlers
+        /// that stop reading before EAGAIN, for example to avoid starving other descriptors.
+        void set_ready(unsigned events) noexcept
+        {
+            assert(reactor_);
+            reactor_->set_ready(fd_, sid_, events);
+        }
+
       private:
         Reactor* reactor_{nullptr};
         int fd_{-1}, sid_{0};
@@ -142,6 +151,18 @@ class TOOLBOX_API Reactor : public Waker {
     Reactor& operator=(Reactor&&) = delete;
 
     // clang-format off
+    /// Subscribe to I/O events.
+    ///
+    /// If events includes EpollEt, then the descriptor is registered once for both input and
+    /// output, and the reactor latches readiness until it is dispatched to a handler that is
+    /// interested in it. Changing the interest set with set_events(), while retaining EpollEt, then
+    /// requires no system call, and readiness already latched for newly added events is dispatched
+    /// on the next cycle. As with any edge-triggered subscription, handlers must read or write
+    /// until EAGAIN, or call set_ready(), and must tolerate readiness that has since been consumed.
+    ///
+    /// If events includes EpollExclusive, then only one of the epoll instances that share the
+    /// descriptor is woken for each event. Exclusive subscriptions cannot be modified, except for
+    /// the interest set of an edge-triggered subscription.
     [[nodiscard]] Handle subscribe(int fd, unsigned events, IoSlot slot);
 
     /// Throws std::bad_alloc only.
@@ -167,6 +188,10 @@ class TOOLBOX_API Reactor : public Waker {
             break;
         }
     }
+    /// Pre-sizes and prefaults the file descriptor table for fds descriptors, and the timer queues
+    /// and pool for the given number of timers, so that they do not allocate or incur page faults
+    /// when first used.
+    void reserve(std::size_t fds, std::size_t timers);
     /// Poll for I/O and timer events.
     /// The thread-local cycle time is unconditionally updated after the call to epoll() returns.
     /// \param timeout is ignored when immediate mode is used.
@@ -175,6 +200,32 @@ class TOOLBOX_API Reactor : public Waker {
 
     void yield() noexcept;
 
+    /// Returns the busy poll configuration of the underlying epoll instance.
+    BusyPollConfig busy_poll(std::error_code& ec) const noexcept { return epoll_.busy_poll(ec); }
+    BusyPollConfig busy_poll() const { return epoll_.busy_poll(); }
+
+    /// Configure busy polling of the device queues of subscribed sockets. Busy polling complements
+    /// the busy cycles of a ReactorRunner: each non-blocking poll then also polls the device queues,
+    /// so that packets are received without waiting for an interrupt.
+    void set_busy_poll(const BusyPollConfig& config, std::error_code& ec) noexcept
+    {
+        epoll_.set_busy_poll(config, ec);
+    }
+    void set_busy_poll(const BusyPollConfig& config) { epoll_.set_busy_poll(config); }
+
+    /// Returns true if changes to the interest list are deferred until the next poll.
+    bool deferred_updates() const noexcept { return deferred_; }
+    /// Defer changes to the interest list until the next poll.
+    ///
+    /// When enabled, set_events() records the change in a dirty list, and only the final state of
+    /// each descriptor is applied before the next wait. A handler that toggles interest several
+    /// times in a cycle then pays for at most one system call. Errors are logged when the changes
+    /// are applied, rather than reported to the caller, and the previous registration remains in
+    /// effect. Subscriptions and removals are always applied immediately, so that a descriptor may
+    /// be closed as soon as it is unsubscribed. Pending changes are applied when deferral is
+    /// disabled.
+    void set_deferred_updates(bool enabled) noexcept;
+
     void set_high_priority_poll_threshold(Micros thresh) { priority_io_poll_threshold_ = thresh; }
 
     void set_user_high_priority_hook(PollSlot slot) { priority_poll_user_hook_ = slot; }
@@ -195,6 +246,12 @@ class TOOLBOX_API Reactor : public Waker {
     void set_events(int fd, int sid, unsigned events);
     void unsubscribe(int fd, int sid) noexcept;
     void set_io_priority(int fd, int sid, Priority priority) noexcept;
+    bool set_events_lazily(int fd, int sid, unsigned events) noexcept;
+    void set_ready(int fd, int sid, unsigned events) noexcept;
+    void schedule_ready(int fd) noexcept;
+    void mark_dirty(int fd) noexcept;
+    void flush_updates() noexcept;
+    int dispatch_ready(CyclTime now);
     int do_io_priority_poll(WallTime now) noexcept;
     int do_user_priority_poll(WallTime now) noexcept;
 
@@ -203,10 +260,22 @@ class TOOLBOX_API Reactor : public Waker {
         unsigned events{};
         IoSlot slot;
         Priority priority = Priority::Low;
+        /// Latched readiness of an edge-triggered subscription.
+        unsigned ready{};
+        /// True if the descriptor is in the ready list.
+        bool scheduled{false};
+        /// True if the descriptor is in the dirty list.
+        bool dirty{false};
+        /// Events registered with the epoll instance.
+        unsigned registered{};
     };
 
     Epoll epoll_;
     std::vector<Data> data_;
+    /// Edge-triggered descriptors with latched readiness to be dispatched on the next cycle.
+    std::vector<int> ready_;
+    /// Descriptors with interest changes to be applied before the next wait.
+    std::vector<int> dirty_;
     EventFd notify_{0, EFD_NONBLOCK};
     static_assert(static_cast<int>(Priority::High) == 0);
     static_assert(static_cast<int>(Priority::Low) == 1);
@@ -220,6 +289,7 @@ class TOOLBOX_API Reactor : public Waker {
     PollSlot priority_poll_user_hook_;
     int cycle_work_{0};
     bool currently_handling_priority_events_{false};
+    bool deferred_{false};
 };
 
 } // namespace io
@@ -16,6 +16,9 @@
 
 #include "Reactor.hpp"
 
+#include "CycleArena.hpp"
+#include "Warmup.hpp"
+
 #include <toolbox/net/Endpoint.hpp>
 #include <toolbox/net/IoSock.hpp>
 #include <toolbox/util/RefCount.hpp>
@@ -41,6 +44,16 @@ struct TestHandler : RefCount<TestHandler, ThreadUnsafePolicy> {
     int matches{};
 };
 
+struct EventHandler {
+    void on_event(CyclTime /*now*/, int /*fd*/, unsigned events)
+    {
+        last = events;
+        ++count;
+    }
+    unsigned last{};
+    int count{};
+};
+
 } // namespace
 
 BOOST_AUTO_TEST_SUITE(ReactorSuite)
@@ -77,6 +90,32 @@ BOOST_AUTO_TEST_CASE(ReactorLevelCase)
     BOOST_CHECK_EQUAL(h->matches, 3);
 }
 
+BOOST_AUTO_TEST_CASE(ReactorBusyPollCase)
+{
+    Reactor r{1024};
+    error_code ec;
+    r.set_busy_poll({50us, 16, false}, ec);
+    // Per-instance busy poll parameters require Linux 6.9.
+    if (ec == errc::inappropriate_io_control_operation) {
+        return;
+    }
+    BOOST_REQUIRE(!ec);
+    const auto config = r.busy_poll();
+    BOOST_CHECK_EQUAL(config.timeout.count(), 50);
+    BOOST_CHECK_EQUAL(config.budget, 16);
+    BOOST_CHECK(!config.prefer);
+
+    auto h = make_intrusive<TestHandler>();
+    auto socks = socketpair(UnixStreamProtocol{});
+    const auto sub = r.subscribe(*socks.second, EpollIn, bind<&TestHandler::on_input>(h.get()));
+    socks.first.send("foo", 4, 0);
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK_EQUAL(h->matches, 1);
+
+    r.set_busy_poll({});
+    BOOST_CHECK_EQUAL(r.busy_poll().timeout.count(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(ReactorSocketPriority)
 {
     using namespace literals::chrono_literals;
@@ -431,6 +470,185 @@ BOOST_AUTO_TEST_CASE(ReactorEdgeCase)
     BOOST_CHECK_EQUAL(h->matches, 3);
 }
 
+BOOST_AUTO_TEST_CASE(ReactorEdgeInterestCase)
+{
+    using namespace literals::chrono_literals;
+
+    Reactor r{1024};
+    EventHandler h;
+
+    auto socks = socketpair(UnixStreamProtocol{});
+    auto sub = r.subscribe(*socks.second, EpollIn | EpollEt, bind<&EventHandler::on_event>(&h));
+
+    // The socket is writable, but output is not in the interest set.
+    const auto now = CyclTime::now();
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h.count, 0);
+
+    // The latched output readiness is dispatched without a further edge from the kernel.
+    sub.set_events(EpollIn | EpollOut | EpollEt);
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h.count, 1);
+    BOOST_CHECK_EQUAL(h.last, EpollOut);
+
+    // Readiness is consumed by dispatch.
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h.count, 1);
+
+    sub.set_events(EpollIn | EpollEt);
+    socks.first.send("foo", 4, 0);
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h.count, 2);
+    BOOST_CHECK_EQUAL(h.last & (EpollIn | EpollOut), EpollIn);
+
+    // Input readiness has been consumed, although the data has not been read.
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h.count, 2);
+
+    // Events outside the registration, such as EpollRdHup, require the registration to change.
+    sub.set_events(EpollIn | EpollRdHup | EpollEt);
+    os::shutdown(socks.first.get(), SHUT_WR);
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h.count, 3);
+    BOOST_CHECK(h.last & EpollRdHup);
+}
+
+BOOST_AUTO_TEST_CASE(ReactorSetReadyCase)
+{
+    using namespace literals::chrono_literals;
+
+    Reactor r{1024};
+    auto h = make_intrusive<TestHandler>();
+
+    auto socks = socketpair(UnixStreamProtocol{});
+    auto sub = r.subscribe(*socks.second, EpollIn | EpollEt, bind<&TestHandler::on_input>(h.get()));
+
+    socks.first.send("foo", 4, 0);
+    socks.first.send("foo", 4, 0);
+    const auto now = CyclTime::now();
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h->matches, 1);
+
+    // The handler stopped before EAGAIN, so request another dispatch.
+    sub.set_ready(EpollIn);
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h->matches, 2);
+
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h->matches, 2);
+
+    // Stale readiness is discarded when the subscription is reset.
+    sub.set_ready(EpollIn);
+    sub.reset();
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h->matches, 2);
+}
+
+BOOST_AUTO_TEST_CASE(ReactorExclusiveCase)
+{
+    using namespace literals::chrono_literals;
+
+    Reactor r{1024};
+    EventHandler h1, h2;
+
+    // Exclusive registrations cannot be modified by the kernel.
+    auto socks = socketpair(UnixStreamProtocol{});
+    auto sub1
+        = r.subscribe(*socks.first, EpollIn | EpollExclusive, bind<&EventHandler::on_event>(&h1));
+    error_code ec;
+    sub1.set_events(EpollOut | EpollExclusive, ec);
+    BOOST_CHECK(ec == errc::invalid_argument);
+    sub1.reset();
+
+    // But the interest set of an edge-triggered subscription can be changed without modifying
+    // the registration.
+    auto sub2 = r.subscribe(*socks.second, EpollIn | EpollEt | EpollExclusive,
+                            bind<&EventHandler::on_event>(&h2));
+    BOOST_CHECK_NO_THROW(sub2.set_events(EpollIn | EpollOut | EpollEt | EpollExclusive));
+
+    socks.first.send("foo", 4, 0);
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK_EQUAL(h1.count, 0);
+    BOOST_CHECK_EQUAL(h2.count, 1);
+    BOOST_CHECK_EQUAL(h2.last, EpollIn | EpollOut);
+}
+
+BOOST_AUTO_TEST_CASE(ReactorDeferredCase)
+{
+    using namespace literals::chrono_literals;
+
+    Reactor r{1024};
+    r.set_deferred_updates(true);
+    BOOST_CHECK(r.deferred_updates());
+    EventHandler h;
+
+    auto socks = socketpair(UnixStreamProtocol{});
+    auto sub = r.subscribe(*socks.second, EpollIn, bind<&EventHandler::on_event>(&h));
+
+    // Only the final state is applied.
+    sub.set_events(EpollIn | EpollOut);
+    sub.set_events(EpollIn);
+    const auto now = CyclTime::now();
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h.count, 0);
+
+    sub.set_events(EpollIn | EpollOut);
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h.count, 1);
+    BOOST_CHECK_EQUAL(h.last, EpollOut);
+
+    // Removals are applied immediately.
+    socks.first.send("foo", 4, 0);
+    sub.reset();
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h.count, 1);
+
+    // Resubscribe with a change pending.
+    sub = r.subscribe(*socks.second, EpollOut, bind<&EventHandler::on_event>(&h));
+    sub.set_events(EpollIn);
+    sub.reset();
+    sub = r.subscribe(*socks.second, EpollIn | EpollOut, bind<&EventHandler::on_event>(&h));
+    sub.reset();
+    sub = r.subscribe(*socks.second, EpollIn, bind<&EventHandler::on_event>(&h));
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h.count, 2);
+    BOOST_CHECK_EQUAL(h.last, EpollIn);
+
+    // Pending changes are applied when deferral is disabled.
+    sub.set_events(EpollOut);
+    r.set_deferred_updates(false);
+    BOOST_CHECK(!r.deferred_updates());
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h.count, 3);
+    BOOST_CHECK_EQUAL(h.last, EpollOut);
+}
+
+BOOST_AUTO_TEST_CASE(ReactorDeferredExclusiveCase)
+{
+    using namespace literals::chrono_literals;
+
+    Reactor r{1024};
+    r.set_deferred_updates(true);
+    EventHandler h;
+
+    auto socks = socketpair(UnixStreamProtocol{});
+    auto sub
+        = r.subscribe(*socks.first, EpollIn | EpollExclusive, bind<&EventHandler::on_event>(&h));
+
+    // The failure to modify an exclusive registration is logged when the change is applied.
+    BOOST_CHECK_NO_THROW(sub.set_events(EpollOut | EpollExclusive));
+    const auto now = CyclTime::now();
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 0);
+    BOOST_CHECK_EQUAL(h.count, 0);
+
+    // The previous registration remains in effect, so restoring the events requires no change.
+    sub.set_events(EpollIn | EpollExclusive);
+    socks.second.send("foo", 4, 0);
+    BOOST_CHECK_EQUAL(r.poll(now, 0ms), 1);
+    BOOST_CHECK_EQUAL(h.count, 1);
+    BOOST_CHECK_EQUAL(h.last, EpollIn);
+}
+
 BOOST_AUTO_TEST_CASE(ReactorHookCase)
 {
     int i{0};
@@ -445,6 +663,51 @@ BOOST_AUTO_TEST_CASE(ReactorHookCase)
     BOOST_CHECK_EQUAL(i, 1);
 }
 
+BOOST_AUTO_TEST_CASE(ReactorCycleArenaCase)
+{
+    Reactor r{1024};
+    CycleArena arena{r, 1024};
+
+    size_t size{0};
+    auto fn = [&arena, &size](CyclTime, Timer&) {
+        pmr::vector<int> v{&arena};
+        v.resize(16);
+        size = arena.size();
+    };
+
+    // The arena is not reset when no events are dispatched.
+    arena.allocate(8);
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 0);
+    BOOST_CHECK_EQUAL(arena.size(), 8U);
+
+    auto t = r.timer(CyclTime::now().mono_time(), Priority::High, bind(&fn));
+    r.poll(CyclTime::now(), 0ms);
+    BOOST_CHECK_GE(size, 8U + 16 * sizeof(int));
+    BOOST_CHECK_EQUAL(arena.size(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(ReactorWarmUpCase)
+{
+    Reactor r{1024};
+    WarmupOptions opts;
+    opts.fds = 4096;
+    opts.timers = 1000;
+    opts.stack_size = 64 * 1024;
+    const auto report = warm_up(r, opts);
+    BOOST_CHECK_GE(report.after.minor, report.before.minor);
+
+    // Timers are allocated from the reserved pool.
+    const auto before = page_faults();
+    auto fn = [](CyclTime, Timer&) {};
+    vector<Timer> ts;
+    ts.reserve(1000);
+    const auto now = CyclTime::now();
+    for (int i{0}; i < 1000; ++i) {
+        ts.push_back(r.timer(now.mono_time() + 1s, Priority::High, bind(&fn)));
+    }
+    BOOST_CHECK_LT(page_faults().minor - before.minor, 8);
+}
+
 BOOST_AUTO_TEST_CASE(ReactorLowPriorityProgress)
 {
     Reactor r{1024};
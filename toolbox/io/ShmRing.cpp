@@ -0,0 +1,268 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ShmRing.hpp"
+
+#include <toolbox/io/File.hpp>
+#include <toolbox/sys/Memory.hpp>
+#include <toolbox/util/Math.hpp>
+
+#include <climits>
+#include <utility>
+
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace toolbox {
+inline namespace io {
+using namespace std;
+namespace {
+
+// The futex is not private, because the ring is mapped by more than one process.
+int futex_wait(atomic<uint32_t>& word, uint32_t val, Duration timeout) noexcept
+{
+    const auto ts = to_timespec(timeout);
+    return syscall(SYS_futex, &word, FUTEX_WAIT, val, &ts, nullptr, 0);
+}
+
+int futex_wake(atomic<uint32_t>& word) noexcept
+{
+    return syscall(SYS_futex, &word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+size_t slot_stride(size_t slot_size) noexcept
+{
+    return ceil_cache_line(16 + slot_size);
+}
+
+} // namespace
+
+ShmRing ShmRing::create(const char* path, size_t capacity, size_t slot_size, ShmRingMode mode)
+{
+    capacity = next_pow2(capacity);
+    auto fh = os::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    struct stat st;
+    os::fstat(fh.get(), st);
+    if (st.st_size >= static_cast<off_t>(sizeof(Header))) {
+        auto* const addr = os::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                                    fh.get(), 0);
+        ShmRing ring{move(fh), addr, static_cast<size_t>(st.st_size)};
+        const auto* const hdr = ring.hdr_;
+        if (hdr->magic.load(memory_order_acquire) == Magic && hdr->version == Version) {
+            if (hdr->capacity != capacity || hdr->slot_size != slot_size || hdr->mode != mode) {
+                throw runtime_error{"shm ring exists with different geometry"};
+            }
+            return ring;
+        }
+        // The ring was left partially initialised, so start again.
+        fh = move(ring.fh_);
+    }
+    return init(move(fh), capacity, slot_size, mode);
+}
+
+ShmRing ShmRing::create_memfd(const char* name, size_t capacity, size_t slot_size,
+                              ShmRingMode mode)
+{
+    return init(os::memfd_create(name, MFD_CLOEXEC), next_pow2(capacity), slot_size, mode);
+}
+
+ShmRing ShmRing::open(const char* path)
+{
+    return open(os::open(path, O_RDWR | O_CLOEXEC));
+}
+
+ShmRing ShmRing::open(FileHandle fh)
+{
+    struct stat st;
+    os::fstat(fh.get(), st);
+    if (st.st_size < static_cast<off_t>(sizeof(Header))) {
+        throw runtime_error{"shm ring not initialised"};
+    }
+    auto* const addr
+        = os::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fh.get(), 0);
+    ShmRing ring{move(fh), addr, static_cast<size_t>(st.st_size)};
+    const auto* const hdr = ring.hdr_;
+    if (hdr->magic.load(memory_order_acquire) != Magic) {
+        throw runtime_error{"shm ring not initialised"};
+    }
+    if (hdr->version != Version) {
+        throw runtime_error{"shm ring version mismatch"};
+    }
+    if (hdr->capacity == 0 || (hdr->capacity & (hdr->capacity - 1)) != 0
+        || hdr->stride != slot_stride(hdr->slot_size)
+        || ring.size_ < DataOffset + hdr->capacity * hdr->stride) {
+        throw runtime_error{"shm ring header is corrupt"};
+    }
+    return ring;
+}
+
+ShmRing::ShmRing(FileHandle fh, void* addr, size_t size) noexcept
+: fh_{move(fh)}
+, hdr_{static_cast<Header*>(addr)}
+, size_{size}
+{
+}
+
+ShmRing::~ShmRing()
+{
+    if (hdr_) {
+        error_code ec;
+        os::munmap(hdr_, size_, ec);
+    }
+}
+
+ShmRing::ShmRing(ShmRing&& rhs) noexcept
+: fh_{move(rhs.fh_)}
+, hdr_{exchange(rhs.hdr_, nullptr)}
+, size_{exchange(rhs.size_, 0)}
+{
+}
+
+ShmRing& ShmRing::operator=(ShmRing&& rhs) noexcept
+{
+    if (this != &rhs) {
+        ShmRing tmp{move(*this)};
+        fh_ = move(rhs.fh_);
+        hdr_ = exchange(rhs.hdr_, nullptr);
+        size_ = exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+bool ShmRing::writer_alive(WallTime now, Duration timeout) const noexcept
+{
+    const auto pid = writer_pid();
+    if (pid <= 0 || (::kill(pid, 0) < 0 && errno != EPERM)) {
+        return false;
+    }
+    return now - heartbeat() <= timeout;
+}
+
+ShmRing ShmRing::init(FileHandle fh, size_t capacity, size_t slot_size, ShmRingMode mode)
+{
+    if (slot_size == 0 || slot_size > UINT32_MAX) {
+        throw invalid_argument{"invalid slot size"};
+    }
+    const auto stride = slot_stride(slot_size);
+    const auto size = DataOffset + capacity * stride;
+    // Truncating to zero first ensures that any previous contents are zero-filled.
+    os::ftruncate(fh.get(), 0);
+    os::ftruncate(fh.get(), size);
+    auto* const addr = os::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fh.get(), 0);
+    ShmRing ring{move(fh), addr, size};
+    auto* const hdr = ring.hdr_;
+    hdr->version = Version;
+    hdr->capacity = capacity;
+    hdr->slot_size = slot_size;
+    hdr->stride = stride;
+    hdr->mode = mode;
+    // Publish the header only when it has been fully initialised.
+    hdr->magic.store(Magic, memory_order_release);
+    return ring;
+}
+
+void ShmRing::wake(int notify_fd) noexcept
+{
+    // Order the publication of the message before the load of the sleeping flag. The reader's
+    // arm() has the opposite order, so at least one side will see the other's store.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (hdr_->sleeping.load(memory_order_relaxed) != 0
+        && hdr_->sleeping.exchange(0, memory_order_relaxed) != 0) {
+        hdr_->futex.fetch_add(1, memory_order_release);
+        futex_wake(hdr_->futex);
+        if (notify_fd >= 0) {
+            const uint64_t val{1};
+            error_code ec;
+            os::write(notify_fd, &val, sizeof(val), ec);
+        }
+    }
+}
+
+ShmWriter::ShmWriter(ShmRing& ring) noexcept
+: ring_{&ring}
+, wpos_{ring.head()}
+, rpos_cache_{ring.hdr_->rpos.load(memory_order_acquire)}
+{
+    ring.hdr_->writer_pid.store(::getpid(), memory_order_relaxed);
+}
+
+ShmReader::ShmReader(ShmRing& ring) noexcept
+: ring_{&ring}
+, seq_{ring.mode() == ShmRingMode::Spsc ? ring.hdr_->rpos.load(memory_order_acquire)
+                                        : ring.head()}
+{
+}
+
+ShmReader::Status ShmReader::read(MutableBuffer buf, size_t& size) noexcept
+{
+    auto& slot = ring_->slot(seq_);
+    const auto expect = seq_ * 2 + 2;
+    const auto before = slot.seq.load(memory_order_acquire);
+    if (before != expect) {
+        // The slot has not been written yet, or is being written for this sequence number.
+        if (before < expect) {
+            return Status::Empty;
+        }
+        return overrun();
+    }
+    // The size is clamped, because it may be torn by a concurrent writer in broadcast mode.
+    size = min<size_t>({slot.size, ring_->slot_size(), buf.size()});
+    memcpy(buf.data(), slot.data(), size);
+    atomic_thread_fence(memory_order_acquire);
+    if (slot.seq.load(memory_order_relaxed) != before) {
+        return overrun();
+    }
+    ++seq_;
+    if (ring_->mode() == ShmRingMode::Spsc) {
+        ring_->hdr_->rpos.store(seq_, memory_order_release);
+    }
+    return Status::Ok;
+}
+
+bool ShmReader::arm() noexcept
+{
+    ring_->hdr_->sleeping.store(1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    return empty();
+}
+
+bool ShmReader::wait(Duration timeout) noexcept
+{
+    auto& futex = ring_->hdr_->futex;
+    const auto val = futex.load(memory_order_acquire);
+    if (!arm()) {
+        return true;
+    }
+    futex_wait(futex, val, timeout);
+    return !empty();
+}
+
+ShmReader::Status ShmReader::overrun() noexcept
+{
+    // Skip to the oldest message that has not yet been overwritten.
+    const auto head = ring_->head();
+    const auto cap = ring_->capacity();
+    const auto next = head > cap ? head - cap + 1 : 0;
+    if (next > seq_) {
+        dropped_ += next - seq_;
+        seq_ = next;
+    }
+    return Status::Overrun;
+}
+
+} // namespace io
+} // namespace toolbox
@@ -0,0 +1,282 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_IO_SHMRING_HPP
+#define TOOLBOX_IO_SHMRING_HPP
+
+#include <toolbox/io/Buffer.hpp>
+#include <toolbox/io/Handle.hpp>
+#include <toolbox/sys/Limits.hpp>
+#include <toolbox/sys/Time.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace toolbox {
+inline namespace io {
+
+enum class ShmRingMode : std::uint32_t {
+    /// Single reader. The writer waits for the reader when the ring is full.
+    Spsc = 1,
+    /// Many readers. The writer never waits, and readers that are lapped skip ahead.
+    Broadcast = 2
+};
+
+/// Ring of fixed-size message slots in shared memory, for low-latency messaging between processes
+/// on the same host.
+///
+/// The ring is backed by a file, typically in /dev/shm, or by an anonymous memfd whose descriptor
+/// is inherited or passed to the reader. Like RingBuffer, positions increase monotonically and are
+/// masked by the power-of-two capacity. Each slot carries the sequence number of the message that
+/// it holds, and is guarded by a sequence lock in broadcast mode.
+///
+/// The header is initialised before the magic number is published, so that readers never attach
+/// to a partially initialised ring. The writer records its pid and a heartbeat, so that readers
+/// can detect a writer that has died.
+class TOOLBOX_API ShmRing {
+    friend class ShmWriter;
+    friend class ShmReader;
+
+  public:
+    static constexpr std::uint32_t Magic{0x52534254}; // "TBSR".
+    static constexpr std::uint32_t Version{1};
+
+    /// Creates a ring at path, or re-attaches to an existing ring with the same geometry.
+    ///
+    /// \param capacity Number of slots, rounded up to a power of two.
+    /// \param slot_size Maximum message size.
+    static ShmRing create(const char* path, std::size_t capacity, std::size_t slot_size,
+                          ShmRingMode mode);
+    /// Creates a ring in an anonymous memfd.
+    static ShmRing create_memfd(const char* name, std::size_t capacity, std::size_t slot_size,
+                                ShmRingMode mode);
+    /// Attaches to an existing ring.
+    static ShmRing open(const char* path);
+    /// Attaches to an existing ring, taking ownership of the file descriptor.
+    static ShmRing open(FileHandle fh);
+
+    ShmRing() noexcept = default;
+    ~ShmRing();
+
+    // Copy.
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    // Move.
+    ShmRing(ShmRing&& rhs) noexcept;
+    ShmRing& operator=(ShmRing&& rhs) noexcept;
+
+    int fd() const noexcept { return fh_.get(); }
+    std::size_t capacity() const noexcept { return hdr_->capacity; }
+    std::size_t slot_size() const noexcept { return hdr_->slot_size; }
+    ShmRingMode mode() const noexcept { return hdr_->mode; }
+    /// Returns the sequence number of the next message to be written.
+    std::uint64_t head() const noexcept { return hdr_->wpos.load(std::memory_order_acquire); }
+    /// Returns the time of the writer's last heartbeat.
+    WallTime heartbeat() const noexcept
+    {
+        return WallTime{Duration{hdr_->heartbeat.load(std::memory_order_relaxed)}};
+    }
+    pid_t writer_pid() const noexcept { return hdr_->writer_pid.load(std::memory_order_relaxed); }
+    /// Returns true if the writer process exists and has sent a heartbeat within timeout.
+    bool writer_alive(WallTime now, Duration timeout) const noexcept;
+
+  private:
+    struct Header {
+        std::atomic<std::uint32_t> magic;
+        std::uint32_t version;
+        std::uint64_t capacity;
+        std::uint64_t slot_size;
+        std::uint64_t stride;
+        ShmRingMode mode;
+        std::atomic<pid_t> writer_pid;
+        std::atomic<std::int64_t> heartbeat;
+        alignas(CacheLineSize) std::atomic<std::uint64_t> wpos;
+        alignas(CacheLineSize) std::atomic<std::uint64_t> rpos;
+        /// Futex word, incremented when sleeping readers are woken.
+        alignas(CacheLineSize) std::atomic<std::uint32_t> futex;
+        /// Non-zero if a reader is waiting for a wakeup.
+        std::atomic<std::uint32_t> sleeping;
+    };
+    struct Slot {
+        std::atomic<std::uint64_t> seq;
+        std::uint32_t size;
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+    };
+    static_assert(sizeof(Slot) == 16);
+    static constexpr std::size_t DataOffset{ceil_cache_line(sizeof(Header))};
+
+    ShmRing(FileHandle fh, void* addr, std::size_t size) noexcept;
+    static ShmRing init(FileHandle fh, std::size_t capacity, std::size_t slot_size,
+                        ShmRingMode mode);
+
+    Slot& slot(std::uint64_t pos) const noexcept
+    {
+        auto* const base = reinterpret_cast<char*>(hdr_) + DataOffset;
+        return *reinterpret_cast<Slot*>(base + (pos & (hdr_->capacity - 1)) * hdr_->stride);
+    }
+    void wake(int notify_fd) noexcept;
+
+    FileHandle fh_;
+    Header* hdr_{nullptr};
+    std::size_t size_{0};
+};
+
+/// The single writer of a ShmRing.
+class TOOLBOX_API ShmWriter {
+  public:
+    /// Resumes from the ring's current head, and records the calling process as the writer.
+    explicit ShmWriter(ShmRing& ring) noexcept;
+    ~ShmWriter() = default;
+
+    // Copy.
+    ShmWriter(const ShmWriter&) = delete;
+    ShmWriter& operator=(const ShmWriter&) = delete;
+
+    // Move.
+    ShmWriter(ShmWriter&&) noexcept = default;
+    ShmWriter& operator=(ShmWriter&&) noexcept = default;
+
+    /// Wake sleeping readers when messages are published. Readers are woken through the shared
+    /// futex and, if notify_fd is not -1, by writing to the eventfd notify_fd, which must be shared
+    /// with the readers by inheritance or descriptor passing. Wakeups add a full memory fence to
+    /// each write.
+    void enable_wakeup(int notify_fd = -1) noexcept
+    {
+        wakeup_ = true;
+        notify_fd_ = notify_fd;
+    }
+    void heartbeat(WallTime now) noexcept
+    {
+        ring_->hdr_->heartbeat.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    /// Copies msg into the next slot. Returns false if the ring is full in SPSC mode.
+    /// Throws std::length_error if the message is larger than the slot size.
+    bool write(ConstBuffer msg)
+    {
+        if (msg.size() > ring_->slot_size()) {
+            throw std::length_error{"message larger than slot"};
+        }
+        return try_write([msg](MutableBuffer buf) {
+            std::memcpy(buf.data(), msg.data(), msg.size());
+            return msg.size();
+        });
+    }
+    /// Invokes fn with the next slot, so that the message can be written in place. The function
+    /// returns the size of the message, which is published when fn returns. Returns false if the
+    /// ring is full in SPSC mode.
+    template <typename FnT>
+    bool try_write(FnT fn)
+    {
+        auto* const hdr = ring_->hdr_;
+        const auto pos = wpos_;
+        if (hdr->mode == ShmRingMode::Spsc && pos - rpos_cache_ >= hdr->capacity) {
+            rpos_cache_ = hdr->rpos.load(std::memory_order_acquire);
+            if (pos - rpos_cache_ >= hdr->capacity) {
+                return false;
+            }
+        }
+        auto& slot = ring_->slot(pos);
+        // An odd value marks the slot as being written.
+        slot.seq.store(pos * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.size = static_cast<std::uint32_t>(fn(MutableBuffer{slot.data(), hdr->slot_size}));
+        slot.seq.store(pos * 2 + 2, std::memory_order_release);
+        hdr->wpos.store(++wpos_, std::memory_order_release);
+        if (wakeup_) {
+            ring_->wake(notify_fd_);
+        }
+        return true;
+    }
+
+  private:
+    ShmRing* ring_;
+    std::uint64_t wpos_;
+    std::uint64_t rpos_cache_;
+    bool wakeup_{false};
+    int notify_fd_{-1};
+};
+
+/// A reader of a ShmRing.
+class TOOLBOX_API ShmReader {
+  public:
+    enum class Status { Ok, Empty, Overrun };
+
+    /// In SPSC mode, the reader resumes from the last position consumed. In broadcast mode, the
+    /// reader starts at the writer's current position.
+    explicit ShmReader(ShmRing& ring) noexcept;
+    ~ShmReader() = default;
+
+    // Copy.
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    // Move.
+    ShmReader(ShmReader&&) noexcept = default;
+    ShmReader& operator=(ShmReader&&) noexcept = default;
+
+    /// Returns the sequence number of the next message to be read.
+    std::uint64_t sequence() const noexcept { return seq_; }
+    /// Returns the number of messages skipped due to overruns.
+    std::uint64_t dropped() const noexcept { return dropped_; }
+    bool empty() const noexcept { return ring_->head() <= seq_; }
+
+    /// Copies the next message into buf, which should be at least slot_size() bytes, and sets size
+    /// to the message size. If the reader was lapped by the writer, then it skips to the oldest
+    /// message still available, and Overrun is returned.
+    Status read(MutableBuffer buf, std::size_t& size) noexcept;
+
+    /// SPSC only. Invokes fn with the next message in place. The slot is released when fn
+    /// returns. Returns false if the ring is empty.
+    template <typename FnT>
+    bool try_read(FnT fn)
+    {
+        assert(ring_->mode() == ShmRingMode::Spsc);
+        auto& slot = ring_->slot(seq_);
+        if (slot.seq.load(std::memory_order_acquire) != seq_ * 2 + 2) {
+            return false;
+        }
+        fn(ConstBuffer{slot.data(), slot.size});
+        ring_->hdr_->rpos.store(++seq_, std::memory_order_release);
+        return true;
+    }
+
+    /// Requests a wakeup when the next message is published. Returns false if a message is already
+    /// available, in which case no wakeup is requested.
+    ///
+    /// This is intended for readers that subscribe the writer's notify descriptor to a Reactor: the
+    /// reader drains the ring and then arms it before returning to the Reactor.
+    bool arm() noexcept;
+
+    /// Blocks on the shared futex until a message is available or the timeout expires. Returns
+    /// true if a message is available.
+    bool wait(Duration timeout) noexcept;
+
+  private:
+    Status overrun() noexcept;
+
+    ShmRing* ring_;
+    std::uint64_t seq_;
+    std::uint64_t dropped_{0};
+};
+
+} // namespace io
+} // namespace toolbox
+
+#endif // TOOLBOX_IO_SHMRING_HPP
@@ -0,0 +1,241 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ShmRing.hpp"
+
+#include "EventFd.hpp"
+#include "Reactor.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+struct ShmPath {
+    ShmPath()
+    : path{"/dev/shm/tb-shmring-test-" + to_string(getpid())}
+    {
+        ::unlink(path.c_str());
+    }
+    ~ShmPath() { ::unlink(path.c_str()); }
+    const char* c_str() const noexcept { return path.c_str(); }
+    string path;
+};
+
+ConstBuffer str_buf(string_view s) noexcept
+{
+    return {s.data(), s.size()};
+}
+
+string_view read_str(ShmReader& r, char* buf, size_t len, ShmReader::Status expect = {})
+{
+    size_t size{0};
+    BOOST_CHECK(r.read({buf, len}, size) == expect);
+    return {buf, size};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ShmRingSuite)
+
+BOOST_AUTO_TEST_CASE(ShmRingSpscCase)
+{
+    ShmPath path;
+    auto tx_ring = ShmRing::create(path.c_str(), 3, 16, ShmRingMode::Spsc);
+    BOOST_CHECK_EQUAL(tx_ring.capacity(), 4U);
+    BOOST_CHECK_EQUAL(tx_ring.slot_size(), 16U);
+
+    // The reader maps the same file separately, as another process would.
+    auto rx_ring = ShmRing::open(path.c_str());
+    BOOST_CHECK(rx_ring.mode() == ShmRingMode::Spsc);
+    ShmWriter w{tx_ring};
+    ShmReader r{rx_ring};
+    char buf[16];
+
+    BOOST_CHECK(r.empty());
+    read_str(r, buf, sizeof(buf), ShmReader::Status::Empty);
+    for (int i{0}; i < 4; ++i) {
+        BOOST_CHECK(w.write(str_buf(to_string(i))));
+    }
+    // The writer waits for the reader when the ring is full.
+    BOOST_CHECK(!w.write(str_buf("4"sv)));
+    BOOST_CHECK_THROW(w.write(str_buf(string(17, 'x'))), length_error);
+
+    BOOST_CHECK_EQUAL(read_str(r, buf, sizeof(buf)), "0");
+    BOOST_CHECK(w.write(str_buf("4"sv)));
+    for (int i{1}; i < 5; ++i) {
+        BOOST_CHECK(r.try_read([i](ConstBuffer msg) {
+            BOOST_CHECK_EQUAL(
+                string_view(static_cast<const char*>(msg.data()), msg.size()), to_string(i));
+        }));
+    }
+    BOOST_CHECK(!r.try_read([](ConstBuffer) {}));
+    BOOST_CHECK_EQUAL(r.sequence(), 5U);
+
+    // A new writer and reader resume from the shared positions.
+    BOOST_CHECK(ShmWriter{rx_ring}.write(str_buf("5"sv)));
+    ShmReader r2{tx_ring};
+    BOOST_CHECK_EQUAL(r2.sequence(), 5U);
+    BOOST_CHECK_EQUAL(read_str(r2, buf, sizeof(buf)), "5");
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingBroadcastCase)
+{
+    auto ring = ShmRing::create_memfd("tb-shmring-test", 4, 8, ShmRingMode::Broadcast);
+    ShmWriter w{ring};
+    ShmReader r1{ring};
+    char buf[8];
+
+    BOOST_CHECK(w.write(str_buf("a"sv)));
+    ShmReader r2{ring};
+    // The writer never waits in broadcast mode.
+    for (const auto* s : {"b", "c", "d", "e"}) {
+        BOOST_CHECK(w.write(str_buf(string_view{s})));
+    }
+    BOOST_CHECK_EQUAL(ring.head(), 5U);
+
+    // The first reader has been lapped, and skips to the oldest message.
+    read_str(r1, buf, sizeof(buf), ShmReader::Status::Overrun);
+    BOOST_CHECK_EQUAL(r1.dropped(), 2U);
+    BOOST_CHECK_EQUAL(read_str(r1, buf, sizeof(buf)), "c");
+
+    BOOST_CHECK_EQUAL(read_str(r2, buf, sizeof(buf)), "b");
+    BOOST_CHECK_EQUAL(read_str(r2, buf, sizeof(buf)), "c");
+    BOOST_CHECK_EQUAL(read_str(r2, buf, sizeof(buf)), "d");
+    BOOST_CHECK_EQUAL(read_str(r2, buf, sizeof(buf)), "e");
+    read_str(r2, buf, sizeof(buf), ShmReader::Status::Empty);
+    BOOST_CHECK_EQUAL(r2.dropped(), 0U);
+
+    // The descriptor can be passed to another process, which attaches to the same ring.
+    auto other = ShmRing::open(FileHandle{::dup(ring.fd())});
+    ShmReader r3{other};
+    BOOST_CHECK_EQUAL(r3.sequence(), 5U);
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingHeaderCase)
+{
+    ShmPath path;
+    {
+        auto ring = ShmRing::create(path.c_str(), 4, 8, ShmRingMode::Spsc);
+        ShmWriter w{ring};
+        BOOST_CHECK(w.write(str_buf("x"sv)));
+    }
+    // Creating the ring again attaches to the existing ring.
+    auto ring = ShmRing::create(path.c_str(), 4, 8, ShmRingMode::Spsc);
+    BOOST_CHECK_EQUAL(ring.head(), 1U);
+    BOOST_CHECK_THROW(ShmRing::create(path.c_str(), 8, 8, ShmRingMode::Spsc), runtime_error);
+
+    // An uninitialised file is rejected by readers.
+    os::ftruncate(ring.fd(), 0);
+    BOOST_CHECK_THROW(ShmRing::open(path.c_str()), runtime_error);
+    os::ftruncate(ring.fd(), 4096);
+    BOOST_CHECK_THROW(ShmRing::open(path.c_str()), runtime_error);
+
+    // But is reinitialised by the writer.
+    auto ring2 = ShmRing::create(path.c_str(), 4, 8, ShmRingMode::Spsc);
+    BOOST_CHECK_EQUAL(ring2.head(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingHeartbeatCase)
+{
+    using namespace chrono_literals;
+    auto ring = ShmRing::create_memfd("tb-shmring-test", 4, 8, ShmRingMode::Spsc);
+    const auto now = WallClock::now();
+    BOOST_CHECK(!ring.writer_alive(now, 1s));
+
+    ShmWriter w{ring};
+    BOOST_CHECK_EQUAL(ring.writer_pid(), getpid());
+    w.heartbeat(now);
+    BOOST_CHECK(ring.heartbeat() == now);
+    BOOST_CHECK(ring.writer_alive(now + 1s, 1s));
+    BOOST_CHECK(!ring.writer_alive(now + 2s, 1s));
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingWaitCase)
+{
+    using namespace chrono_literals;
+    auto ring = ShmRing::create_memfd("tb-shmring-test", 64, 8, ShmRingMode::Spsc);
+    ShmReader r{ring};
+    BOOST_CHECK(!r.wait(1ms));
+
+    constexpr int N{1000};
+    thread t{[&ring]() {
+        ShmWriter w{ring};
+        w.enable_wakeup();
+        for (int i{0}; i < N;) {
+            if (w.write({&i, sizeof(i)})) {
+                ++i;
+            } else {
+                this_thread::yield();
+            }
+        }
+    }};
+    int expect{0};
+    while (expect < N) {
+        if (!r.wait(1s)) {
+            continue;
+        }
+        while (r.try_read([&expect](ConstBuffer msg) {
+            int i;
+            memcpy(&i, msg.data(), sizeof(i));
+            BOOST_CHECK_EQUAL(i, expect);
+            ++expect;
+        })) {
+        }
+    }
+    t.join();
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingReactorCase)
+{
+    using namespace chrono_literals;
+    auto ring = ShmRing::create_memfd("tb-shmring-test", 4, 8, ShmRingMode::Spsc);
+    EventFd ef{0, EFD_NONBLOCK};
+    ShmWriter w{ring};
+    w.enable_wakeup(ef.fd());
+    ShmReader r{ring};
+
+    Reactor reactor{8};
+    int count{0};
+    auto fn = [&](CyclTime, int, unsigned) {
+        ef.read();
+        while (r.try_read([&count](ConstBuffer) { ++count; })) {
+        }
+        // Request the next wakeup before returning to the reactor.
+        BOOST_CHECK(r.arm());
+    };
+    auto sub = reactor.subscribe(ef.fd(), EpollIn, bind(&fn));
+    BOOST_CHECK(r.arm());
+
+    BOOST_CHECK(w.write(str_buf("a"sv)));
+    // The flag is cleared, so the next write does not signal the eventfd.
+    BOOST_CHECK(w.write(str_buf("b"sv)));
+    BOOST_CHECK_EQUAL(reactor.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK_EQUAL(count, 2);
+    BOOST_CHECK_EQUAL(reactor.poll(CyclTime::now(), 0ms), 0);
+
+    BOOST_CHECK(w.write(str_buf("c"sv)));
+    BOOST_CHECK_EQUAL(reactor.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK_EQUAL(count, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,7 @@
 #include "Timer.hpp"
 
 #include <toolbox/sys/Log.hpp>
+#include <toolbox/sys/Memory.hpp>
 
 #include <string>
 
@@ -24,11 +25,6 @@ namespace toolbox {
 inline namespace io {
 using namespace std;
 namespace {
-// Number of entries per 4K slab, assuming that malloc overhead is no more than 16 bytes.
-constexpr size_t Overhead = 16;
-constexpr size_t PageSize = 4096;
-constexpr size_t SlabSize = (PageSize - Overhead) / sizeof(Timer::Impl);
-
 bool is_after(const Timer& lhs, const Timer& rhs)
 {
     return lhs.expiry() > rhs.expiry();
@@ -36,30 +32,11 @@ bool is_after(const Timer& lhs, const Timer& rhs)
 
 } // namespace
 
-Timer::Impl* TimerPool::allocate()
+void TimerQueue::reserve(size_t n)
 {
-    Timer::Impl* impl;
-
-    if (free_) {
-
-        // Pop next free timer from stack.
-        impl = free_;
-        free_ = free_->next;
-
-    } else {
-
-        // Add new slab of timers to stack.
-        SlabPtr slab{new Timer::Impl[SlabSize]};
-        impl = &slab[0];
-
-        for (size_t i{1}; i < SlabSize; ++i) {
-            slab[i].next = free_;
-            free_ = &slab[i];
-        }
-        slabs_.push_back(std::move(slab));
-    }
-
-    return impl;
+    pool_.reserve(n);
+    heap_.reserve(n);
+    prefault(heap_.data(), heap_.capacity() * sizeof(Timer));
 }
 
 Timer TimerQueue::insert(MonoTime expiry, Duration interval, TimerSlot slot)
@@ -99,16 +76,7 @@ int TimerQueue::dispatch(CyclTime now, int max_work)
 
 Timer TimerQueue::allocate(MonoTime expiry, Duration interval, TimerSlot slot)
 {
-    Timer::Impl* impl{pool_.allocate()};
-
-    impl->tq = this;
-    impl->ref_count = 1;
-    impl->id = ++max_id_;
-    impl->expiry = expiry;
-    impl->interval = interval;
-    impl->slot = slot;
-
-    return Timer{impl};
+    return Timer{pool_.construct(this, 1, ++max_id_, expiry, interval, slot)};
 }
 
 void TimerQueue::cancel() noexcept
@@ -191,7 +159,7 @@ void intrusive_ptr_release(Timer::Impl* impl) noexcept
             impl->tq->cancel();
         }
     } else if (impl->ref_count == 0) {
-        impl->tq->pool_.deallocate(impl);
+        impl->tq->pool_.destroy(impl);
     }
 }
 
@@ -19,6 +19,7 @@
 
 #include <limits>
 #include <toolbox/sys/Time.hpp>
+#include <toolbox/util/ObjectPool.hpp>
 #include <toolbox/util/Slot.hpp>
 
 #include <toolbox/Config.h>
@@ -39,11 +40,7 @@ class TOOLBOX_API Timer {
 
   public:
     struct Impl {
-        union {
-            /// Singly-linked free-list.
-            Impl* next;
-            TimerQueue* tq;
-        };
+        TimerQueue* tq;
         int ref_count;
         long id;
         MonoTime expiry;
@@ -99,34 +96,7 @@ class TOOLBOX_API Timer {
     boost::intrusive_ptr<Timer::Impl> impl_;
 };
 
-class TOOLBOX_API TimerPool {
-    using SlabPtr = std::unique_ptr<Timer::Impl[]>;
-
-  public:
-    TimerPool() = default;
-    ~TimerPool() noexcept = default;
-
-    // Copy.
-    TimerPool(const TimerPool&) = delete;
-    TimerPool& operator=(const TimerPool&) = delete;
-
-    // Move.
-    TimerPool(TimerPool&&) = delete;
-    TimerPool& operator=(TimerPool&&) = delete;
-
-    Timer::Impl* allocate();
-    void deallocate(Timer::Impl* impl) noexcept
-    {
-        assert(impl);
-        impl->next = free_;
-        free_ = impl;
-    }
-
-  private:
-    std::vector<SlabPtr> slabs_;
-    /// Head of free-list.
-    Timer::Impl* free_{nullptr};
-};
+using TimerPool = ObjectPool<Timer::Impl>;
 
 class TOOLBOX_API TimerQueue {
     friend class Timer;
@@ -154,6 +124,8 @@ class TOOLBOX_API TimerQueue {
 
     std::size_t size() const noexcept { return heap_.size() - cancelled_; }
     bool empty() const noexcept { return size() == 0; }
+    /// Reserves and prefaults capacity for n timers in the queue and its pool.
+    void reserve(std::size_t n);
     const Timer& front() const { return heap_.front(); }
 
     // clang-format off
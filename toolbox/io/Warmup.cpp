@@ -0,0 +1,42 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Warmup.hpp"
+
+namespace toolbox {
+inline namespace io {
+
+WarmupReport warm_up(Reactor& r, const WarmupOptions& opts)
+{
+    WarmupReport report;
+    report.before = page_faults(RUSAGE_SELF);
+    if (opts.lock_memory) {
+        // Lock first, so that the memory allocated below is also locked.
+        int flags{MCL_CURRENT | MCL_FUTURE};
+        if (opts.lock_on_fault) {
+            flags |= MCL_ONFAULT;
+        }
+        os::mlockall(flags);
+    }
+    r.reserve(opts.fds, opts.timers);
+    if (opts.stack_size > 0) {
+        prefault_stack(opts.stack_size);
+    }
+    report.after = page_faults(RUSAGE_SELF);
+    return report;
+}
+
+} // namespace io
+} // namespace toolbox
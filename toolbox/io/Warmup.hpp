@@ -0,0 +1,56 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_IO_WARMUP_HPP
+#define TOOLBOX_IO_WARMUP_HPP
+
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/sys/Memory.hpp>
+
+namespace toolbox {
+inline namespace io {
+
+struct WarmupOptions {
+    /// Number of file descriptors for which the Reactor's table is pre-sized.
+    std::size_t fds{0};
+    /// Number of timers pre-allocated in the Reactor's timer pool and queues.
+    std::size_t timers{0};
+    /// Number of bytes of the calling thread's stack to prefault.
+    std::size_t stack_size{0};
+    /// Lock current and future mappings into memory with mlockall().
+    bool lock_memory{false};
+    /// Lock pages as they are faulted-in (MCL_ONFAULT), rather than populating all mappings when
+    /// they are locked.
+    bool lock_on_fault{false};
+};
+
+/// Process-wide page-fault counts before and after warm-up.
+struct WarmupReport {
+    PageFaults before;
+    PageFaults after;
+};
+
+/// Prepares the calling thread and its Reactor for latency-sensitive work, so that the first
+/// events processed do not pay for page faults or allocation.
+///
+/// This should be called from the Reactor's thread, after the thread has been bound to its CPU, so
+/// that memory is faulted-in on the local NUMA node. Application buffers can be warmed with
+/// Buffer::prefault() or prefault().
+TOOLBOX_API WarmupReport warm_up(Reactor& r, const WarmupOptions& opts);
+
+} // namespace io
+} // namespace toolbox
+
+#endif // TOOLBOX_IO_WARMUP_HPP
@@ -17,20 +17,27 @@
 #ifndef TOOLBOX_NET_HPP
 #define TOOLBOX_NET_HPP
 
+#include "net/AsyncConnect.hpp"
+#include "net/AsyncResolver.hpp"
+#include "net/DgramBatch.hpp"
+#include "net/DgramReader.hpp"
 #include "net/DgramSock.hpp"
 #include "net/Endian.hpp"
 #include "net/Endpoint.hpp"
 #include "net/Error.hpp"
 #include "net/Frame.hpp"
+#include "net/FramedConn.hpp"
 #include "net/IoSock.hpp"
 #include "net/IpAddr.hpp"
 #include "net/McastSock.hpp"
 #include "net/Protocol.hpp"
 #include "net/RateLimit.hpp"
+#include "net/ReconnectingConnector.hpp"
 #include "net/Resolver.hpp"
 #include "net/Socket.hpp"
 #include "net/StreamAcceptor.hpp"
 #include "net/StreamConnector.hpp"
 #include "net/StreamSock.hpp"
+#include "net/Timestamp.hpp"
 
 #endif // TOOLBOX_NET_HPP
@@ -0,0 +1,44 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AsyncConnect.hpp"
+
+namespace toolbox {
+inline namespace net {
+
+Task<StreamSockClnt> async_connect(Reactor& r, StreamEndpoint ep)
+{
+    StreamSockClnt sock{ep.protocol()};
+    sock.set_non_block();
+    if (sock.is_ip_family()) {
+        set_tcp_no_delay(sock.get(), true);
+    }
+    std::error_code ec;
+    sock.connect(ep, ec);
+    if (ec) {
+        if (ec != std::errc::operation_in_progress) {
+            throw std::system_error{ec, "connect"};
+        }
+        co_await writable(r, sock.get());
+        ec = sock.get_error();
+        if (ec) {
+            throw std::system_error{ec, "connect"};
+        }
+    }
+    co_return std::move(sock);
+}
+
+} // namespace net
+} // namespace toolbox
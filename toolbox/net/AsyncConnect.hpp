@@ -0,0 +1,32 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_ASYNCCONNECT_HPP
+#define TOOLBOX_NET_ASYNCCONNECT_HPP
+
+#include <toolbox/io/Coroutine.hpp>
+#include <toolbox/net/StreamSock.hpp>
+
+namespace toolbox {
+inline namespace net {
+
+/// Connects a non-blocking stream socket to the endpoint, and suspends until the connection is
+/// established. TCP_NODELAY is set on IP sockets. Throws std::system_error if the connection fails.
+TOOLBOX_API Task<StreamSockClnt> async_connect(Reactor& r, StreamEndpoint ep);
+
+} // namespace net
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_ASYNCCONNECT_HPP
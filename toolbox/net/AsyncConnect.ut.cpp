@@ -0,0 +1,64 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AsyncConnect.hpp"
+
+#include "Endpoint.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(AsyncConnectSuite)
+
+BOOST_AUTO_TEST_CASE(AsyncConnectCase)
+{
+    using namespace chrono_literals;
+    Reactor r{8};
+
+    auto ep = parse_stream_endpoint("tcp4://127.0.0.1:0");
+    StreamSockServ serv{ep.protocol()};
+    serv.bind(ep);
+    serv.get_sock_name(ep);
+    serv.listen(SOMAXCONN);
+
+    bool connected{false};
+    spawn([](Reactor& r, StreamEndpoint ep, bool& connected) -> Task<> {
+        const auto sock = co_await async_connect(r, ep);
+        connected = !sock.empty();
+    }(r, ep, connected));
+    for (int i{0}; i < 100 && !connected; ++i) {
+        r.poll(CyclTime::now(), 10ms);
+    }
+    BOOST_CHECK(connected);
+
+    // The listening socket is closed, so the connection is refused.
+    serv.close();
+    string error;
+    spawn([](Reactor& r, StreamEndpoint ep, string& error) -> Task<> {
+        try {
+            co_await async_connect(r, ep);
+        } catch (const system_error& e) {
+            error = e.code().message();
+        }
+    }(r, ep, error));
+    for (int i{0}; i < 100 && error.empty(); ++i) {
+        r.poll(CyclTime::now(), 10ms);
+    }
+    BOOST_CHECK(!error.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
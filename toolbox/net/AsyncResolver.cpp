@@ -0,0 +1,184 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AsyncResolver.hpp"
+
+#include <toolbox/io/EventFd.hpp>
+#include <toolbox/util/Finally.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace toolbox {
+inline namespace net {
+using namespace std;
+namespace {
+
+// Socket type and URI.
+string make_key(string_view uri, int type)
+{
+    string key;
+    key.reserve(uri.size() + 1);
+    key += static_cast<char>(type);
+    key += uri;
+    return key;
+}
+
+} // namespace
+
+struct AsyncResolver::Shared {
+    mutex mtx;
+    vector<Completion> done;
+    EventFd efd{0, EFD_NONBLOCK};
+};
+
+// Posts the outcome of a lookup to the reactor. The lookup is completed with an error if the
+// resolver task is destroyed without running, for example because the Resolver was cleared, so
+// that later requests do not join a lookup that will never complete.
+struct AsyncResolver::Lookup {
+    Lookup(shared_ptr<Shared> shared, string key) noexcept
+    : shared{std::move(shared)}
+    , key{std::move(key)}
+    {
+    }
+    ~Lookup()
+    {
+        if (shared) {
+            const system_error e{make_error_code(errc::operation_canceled), "resolve"};
+            post({nullptr, make_exception_ptr(e)});
+        }
+    }
+
+    // Copy.
+    Lookup(const Lookup&) = delete;
+    Lookup& operator=(const Lookup&) = delete;
+
+    // Move.
+    Lookup(Lookup&&) = delete;
+    Lookup& operator=(Lookup&&) = delete;
+
+    void post(ResolveResult result)
+    {
+        {
+            lock_guard lock{shared->mtx};
+            shared->done.push_back({std::move(key), std::move(result)});
+        }
+        std::error_code ec;
+        shared->efd.write(1, ec);
+        shared.reset();
+    }
+    shared_ptr<Shared> shared;
+    string key;
+};
+
+AsyncResolver::AsyncResolver(Reactor& r, Resolver& res, Duration ttl, size_t capacity)
+: res_{res}
+, ttl_{ttl}
+, capacity_{capacity}
+, shared_{make_shared<Shared>()}
+{
+    sub_ = r.subscribe(shared_->efd.fd(), EpollIn, bind<&AsyncResolver::on_io_event>(this));
+}
+
+AsyncResolver::~AsyncResolver() = default;
+
+bool AsyncResolver::resolve(CyclTime now, string_view uri, int type, ResolveSlot slot)
+{
+    auto key = make_key(uri, type);
+    if (const auto it = cache_.find(key); it != cache_.end()) {
+        if (now.mono_time() < it->second->expiry) {
+            // Most recently used.
+            lru_.splice(lru_.begin(), lru_, it->second);
+            slot(now, uri, it->second->result);
+            return true;
+        }
+        lru_.erase(it->second);
+        cache_.erase(it);
+    }
+    auto [it, inserted] = pending_.try_emplace(key);
+    it->second.push_back(slot);
+    if (inserted) {
+        // Coalesce with any later requests until the lookup completes.
+        auto lookup = make_shared<Lookup>(shared_, std::move(key));
+        res_.resolve(string{uri}, type, [lookup](AddrInfoPtr&& ai, exception_ptr e) {
+            lookup->post({std::move(ai), e});
+        });
+    }
+    return false;
+}
+
+void AsyncResolver::cancel(ResolveSlot slot) noexcept
+{
+    for (auto& [key, slots] : pending_) {
+        slots.erase(remove(slots.begin(), slots.end(), slot), slots.end());
+    }
+    if (completing_) {
+        // Cleared rather than erased, because complete() is iterating over the slots.
+        replace(completing_->begin(), completing_->end(), slot, ResolveSlot{});
+    }
+}
+
+void AsyncResolver::clear() noexcept
+{
+    cache_.clear();
+    lru_.clear();
+}
+
+void AsyncResolver::on_io_event(CyclTime now, int /*fd*/, unsigned /*events*/)
+{
+    shared_->efd.read();
+    vector<Completion> done;
+    {
+        lock_guard lock{shared_->mtx};
+        done.swap(shared_->done);
+    }
+    for (auto& c : done) {
+        complete(now, c);
+    }
+}
+
+void AsyncResolver::complete(CyclTime now, Completion& c)
+{
+    if (c.result) {
+        lru_.push_front({c.key, c.result, now.mono_time() + ttl_});
+        if (const auto it = cache_.find(c.key); it != cache_.end()) {
+            lru_.erase(it->second);
+            it->second = lru_.begin();
+        } else {
+            cache_.emplace(c.key, lru_.begin());
+        }
+        if (cache_.size() > capacity_) {
+            cache_.erase(lru_.back().key);
+            lru_.pop_back();
+        }
+    }
+    auto node = pending_.extract(c.key);
+    if (node.empty()) {
+        return;
+    }
+    // A slot may cancel the others while they are being invoked.
+    auto& slots = node.mapped();
+    completing_ = &slots;
+    const auto reset = make_finally([this]() noexcept { completing_ = nullptr; });
+    const string_view uri{c.key.data() + 1, c.key.size() - 1};
+    for (size_t i{0}; i < slots.size(); ++i) {
+        if (const auto slot = slots[i]) {
+            slot(now, uri, c.result);
+        }
+    }
+}
+
+} // namespace net
+} // namespace toolbox
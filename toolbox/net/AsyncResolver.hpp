@@ -0,0 +1,126 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_ASYNCRESOLVER_HPP
+#define TOOLBOX_NET_ASYNCRESOLVER_HPP
+
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/net/Resolver.hpp>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace toolbox {
+inline namespace net {
+
+/// Outcome of a resolution: either the address list or the exception is set.
+struct ResolveResult {
+    std::shared_ptr<const addrinfo> ai;
+    std::exception_ptr error;
+
+    explicit operator bool() const noexcept { return ai != nullptr; }
+    /// Converts each address to an endpoint, or rethrows the exception.
+    template <typename EndpointT>
+    std::vector<EndpointT> endpoints() const
+    {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return get_endpoints<EndpointT>(ai.get());
+    }
+};
+
+using ResolveSlot = BasicSlot<void(CyclTime, std::string_view, const ResolveResult&)>;
+
+/// Resolves socket URIs on a Resolver thread, and completes on the requesting reactor.
+///
+/// Results are cached for a fixed time-to-live, because getaddrinfo() does not report the TTL of
+/// DNS records, and the least recently used result is evicted when the cache is full. Concurrent
+/// requests for the same URI share a single lookup, so that a storm of reconnects does not become a
+/// storm of DNS queries. Failures are not cached.
+class TOOLBOX_API AsyncResolver {
+  public:
+    /// \param r The reactor on which callbacks are invoked.
+    /// \param res The resolver, which must be run on another thread.
+    /// \param ttl The time for which results are cached.
+    /// \param capacity The maximum number of cached results.
+    AsyncResolver(Reactor& r, Resolver& res, Duration ttl = 60s, std::size_t capacity = 1024);
+    ~AsyncResolver();
+
+    // Copy.
+    AsyncResolver(const AsyncResolver&) = delete;
+    AsyncResolver& operator=(const AsyncResolver&) = delete;
+
+    // Move.
+    AsyncResolver(AsyncResolver&&) = delete;
+    AsyncResolver& operator=(AsyncResolver&&) = delete;
+
+    /// Returns the number of cached results, including any that have expired.
+    std::size_t size() const noexcept { return cache_.size(); }
+    /// Returns the number of lookups in progress.
+    std::size_t pending() const noexcept { return pending_.size(); }
+
+    /// Resolves a socket URI.
+    ///
+    /// If a result is cached, the slot is invoked before the function returns. Otherwise, the slot
+    /// is invoked from the reactor when the lookup completes. If the lookup is discarded by the
+    /// Resolver without running, then it completes with an operation_canceled error.
+    ///
+    /// \return true if the slot was invoked synchronously from the cache.
+    bool resolve(CyclTime now, std::string_view uri, int type, ResolveSlot slot);
+
+    /// Cancels any pending callbacks to the slot.
+    void cancel(ResolveSlot slot) noexcept;
+
+    /// Discards all cached results.
+    void clear() noexcept;
+
+  private:
+    struct Completion {
+        std::string key;
+        ResolveResult result;
+    };
+    struct Shared;
+    struct Lookup;
+    struct CacheEntry {
+        std::string key;
+        ResolveResult result;
+        MonoTime expiry;
+    };
+    using CacheList = std::list<CacheEntry>;
+
+    void on_io_event(CyclTime now, int fd, unsigned events);
+    void complete(CyclTime now, Completion& c);
+
+    Resolver& res_;
+    const Duration ttl_;
+    const std::size_t capacity_;
+    // State shared with resolver callbacks, which may outlive this object.
+    std::shared_ptr<Shared> shared_;
+    Reactor::Handle sub_;
+    CacheList lru_;
+    std::unordered_map<std::string, CacheList::iterator> cache_;
+    std::unordered_map<std::string, std::vector<ResolveSlot>> pending_;
+    // Slots being invoked by complete(), which cancel() also clears.
+    std::vector<ResolveSlot>* completing_{nullptr};
+};
+
+} // namespace net
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_ASYNCRESOLVER_HPP
@@ -0,0 +1,197 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AsyncResolver.hpp"
+
+#include "Endpoint.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+struct Client {
+    void on_resolve(CyclTime /*now*/, string_view uri, const ResolveResult& result)
+    {
+        uris.emplace_back(uri);
+        results.push_back(result);
+    }
+    ResolveSlot slot() { return bind<&Client::on_resolve>(this); }
+    vector<string> uris;
+    vector<ResolveResult> results;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(AsyncResolverSuite)
+
+BOOST_AUTO_TEST_CASE(AsyncResolverCoalesceCase)
+{
+    const auto uri = "tcp4://192.168.1.3:443"s;
+    Reactor r;
+    Resolver res;
+    AsyncResolver ar{r, res};
+    Client a, b;
+
+    const auto now = CyclTime::now();
+    BOOST_CHECK(!ar.resolve(now, uri, SOCK_STREAM, a.slot()));
+    BOOST_CHECK(!ar.resolve(now, uri, SOCK_STREAM, b.slot()));
+    // A different socket type is a different lookup.
+    BOOST_CHECK(!ar.resolve(now, "udp4://192.168.1.3:443", SOCK_DGRAM, b.slot()));
+    BOOST_CHECK_EQUAL(ar.pending(), 2U);
+
+    // Execute the lookups, then complete them on the reactor.
+    BOOST_CHECK(res.run());
+    BOOST_CHECK(res.run());
+    r.poll(CyclTime::now(), 0s);
+    BOOST_CHECK_EQUAL(ar.pending(), 0U);
+    BOOST_CHECK_EQUAL(ar.size(), 2U);
+
+    BOOST_REQUIRE_EQUAL(a.results.size(), 1U);
+    BOOST_CHECK_EQUAL(a.uris[0], uri);
+    BOOST_CHECK(a.results[0]);
+    const auto eps = a.results[0].endpoints<StreamEndpoint>();
+    BOOST_REQUIRE_EQUAL(eps.size(), 1U);
+    BOOST_CHECK_EQUAL(to_string(eps[0]), uri);
+    BOOST_REQUIRE_EQUAL(b.results.size(), 2U);
+    // Both requests share the same result.
+    BOOST_CHECK(a.results[0].ai == b.results[0].ai);
+
+    // Cache hit.
+    Client c;
+    BOOST_CHECK(ar.resolve(CyclTime::now(), uri, SOCK_STREAM, c.slot()));
+    BOOST_REQUIRE_EQUAL(c.results.size(), 1U);
+    BOOST_CHECK(c.results[0].ai == a.results[0].ai);
+    BOOST_CHECK_EQUAL(ar.pending(), 0U);
+
+    ar.clear();
+    BOOST_CHECK_EQUAL(ar.size(), 0U);
+    BOOST_CHECK(!ar.resolve(CyclTime::now(), uri, SOCK_STREAM, c.slot()));
+}
+
+BOOST_AUTO_TEST_CASE(AsyncResolverExpiryCase)
+{
+    const auto uri1 = "tcp4://192.168.1.3:443"s;
+    const auto uri2 = "tcp4://192.168.1.4:443"s;
+    Reactor r;
+    Resolver res;
+    AsyncResolver ar{r, res, 50ms, 1};
+    Client a;
+
+    const auto now = CyclTime::now();
+    BOOST_CHECK(!ar.resolve(now, uri1, SOCK_STREAM, a.slot()));
+    BOOST_CHECK(res.run());
+    r.poll(now, 0s);
+    BOOST_CHECK(ar.resolve(now, uri1, SOCK_STREAM, a.slot()));
+
+    // Least recently used result is evicted.
+    BOOST_CHECK(!ar.resolve(now, uri2, SOCK_STREAM, a.slot()));
+    BOOST_CHECK(res.run());
+    r.poll(now, 0s);
+    BOOST_CHECK_EQUAL(ar.size(), 1U);
+    BOOST_CHECK(ar.resolve(now, uri2, SOCK_STREAM, a.slot()));
+
+    // Expired.
+    this_thread::sleep_for(50ms);
+    BOOST_CHECK(!ar.resolve(CyclTime::now(), uri2, SOCK_STREAM, a.slot()));
+    BOOST_CHECK_EQUAL(ar.size(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncResolverErrorCase)
+{
+    Reactor r;
+    Resolver res;
+    AsyncResolver ar{r, res};
+    Client a, b;
+
+    const auto now = CyclTime::now();
+    BOOST_CHECK(!ar.resolve(now, "bad://foo", SOCK_STREAM, a.slot()));
+    BOOST_CHECK(!ar.resolve(now, "tcp4://192.168.1.3:443", SOCK_STREAM, b.slot()));
+    ar.cancel(b.slot());
+    BOOST_CHECK(res.run());
+    BOOST_CHECK(res.run());
+    r.poll(now, 0s);
+
+    BOOST_REQUIRE_EQUAL(a.results.size(), 1U);
+    BOOST_CHECK(!a.results[0]);
+    BOOST_CHECK_THROW(a.results[0].endpoints<StreamEndpoint>(), invalid_argument);
+    // Cancelled.
+    BOOST_CHECK(b.results.empty());
+    // Failures are not cached.
+    BOOST_CHECK_EQUAL(ar.size(), 1U);
+    BOOST_CHECK(!ar.resolve(now, "bad://foo", SOCK_STREAM, a.slot()));
+}
+
+BOOST_AUTO_TEST_CASE(AsyncResolverDiscardCase)
+{
+    const auto uri = "tcp4://192.168.1.3:443"s;
+    Reactor r;
+    Resolver res;
+    AsyncResolver ar{r, res};
+    Client a;
+
+    // The lookup is discarded without running.
+    const auto now = CyclTime::now();
+    BOOST_CHECK(!ar.resolve(now, uri, SOCK_STREAM, a.slot()));
+    res.clear();
+    r.poll(now, 0s);
+    BOOST_CHECK_EQUAL(ar.pending(), 0U);
+    BOOST_REQUIRE_EQUAL(a.results.size(), 1U);
+    BOOST_CHECK(!a.results[0]);
+    BOOST_REQUIRE(a.results[0].error);
+    try {
+        rethrow_exception(a.results[0].error);
+    } catch (const system_error& e) {
+        BOOST_CHECK(e.code() == errc::operation_canceled);
+    }
+
+    // Later requests start a new lookup.
+    BOOST_CHECK(!ar.resolve(now, uri, SOCK_STREAM, a.slot()));
+    BOOST_CHECK(res.run());
+    r.poll(now, 0s);
+    BOOST_REQUIRE_EQUAL(a.results.size(), 2U);
+    BOOST_CHECK(a.results[1]);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncResolverCancelCase)
+{
+    const auto uri = "tcp4://192.168.1.3:443"s;
+    Reactor r;
+    Resolver res;
+    AsyncResolver ar{r, res};
+    Client b;
+
+    // The first slot cancels the second while the lookup completes.
+    int calls{0};
+    auto fn = [&](CyclTime /*now*/, string_view /*uri*/, const ResolveResult& /*result*/) {
+        ++calls;
+        ar.cancel(b.slot());
+    };
+    const auto now = CyclTime::now();
+    BOOST_CHECK(!ar.resolve(now, uri, SOCK_STREAM, bind(&fn)));
+    BOOST_CHECK(!ar.resolve(now, uri, SOCK_STREAM, b.slot()));
+    BOOST_CHECK(res.run());
+    r.poll(now, 0s);
+    BOOST_CHECK_EQUAL(calls, 1);
+    BOOST_CHECK(b.results.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_DGRAMBATCH_HPP
+#define TOOLBOX_NET_DGRAMBATCH_HPP
+
+#include <toolbox/io/Buffer.hpp>
+#include <toolbox/net/Endpoint.hpp>
+
+#include <sys/socket.h>
+
+#include <cassert>
+#include <vector>
+
+namespace toolbox {
+inline namespace net {
+
+/// Preallocated array of datagrams and endpoints for use with recvmmsg() and sendmmsg().
+///
+/// The message headers are built once at construction and reused for every call, so that a batch
+/// of datagrams can be received or sent with a single system call and without allocation. Each
+/// receive slot has a fixed-size buffer; longer datagrams are truncated.
+template <typename EndpointT>
+class BasicDgramBatch {
+  public:
+    using Endpoint = EndpointT;
+
+    /// Construct BasicDgramBatch.
+    ///
+    /// \param capacity The maximum number of datagrams in the batch.
+    /// \param max_size The size of each receive buffer.
+    BasicDgramBatch(std::size_t capacity, std::size_t max_size)
+    : max_size_{max_size}
+    , buf_(capacity * max_size)
+    , eps_(capacity)
+    , iovs_(capacity)
+    , msgs_(capacity)
+    {
+        for (std::size_t i{0}; i < capacity; ++i) {
+            msgs_[i].msg_hdr.msg_iov = &iovs_[i];
+            msgs_[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+    ~BasicDgramBatch() = default;
+
+    // Copy.
+    BasicDgramBatch(const BasicDgramBatch&) = delete;
+    BasicDgramBatch& operator=(const BasicDgramBatch&) = delete;
+
+    // Move.
+    BasicDgramBatch(BasicDgramBatch&&) noexcept = default;
+    BasicDgramBatch& operator=(BasicDgramBatch&&) noexcept = default;
+
+    std::size_t capacity() const noexcept { return msgs_.size(); }
+    std::size_t max_size() const noexcept { return max_size_; }
+    /// Returns the number of datagrams received or queued for sending.
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == msgs_.size(); }
+
+    /// Returns the payload of a received datagram.
+    ConstBuffer data(std::size_t i) const noexcept
+    {
+        assert(i < size_);
+        return {iovs_[i].iov_base, msgs_[i].msg_len};
+    }
+    /// Returns the source address of a received datagram, or the destination of a queued one.
+    const Endpoint& endpoint(std::size_t i) const noexcept
+    {
+        assert(i < size_);
+        return eps_[i];
+    }
+    /// Returns true if a received datagram was larger than max_size() and was truncated.
+    bool truncated(std::size_t i) const noexcept
+    {
+        assert(i < size_);
+        return (msgs_[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    }
+
+    void clear() noexcept { size_ = 0; }
+
+    /// Queue a datagram for sending to the specified endpoint. The payload is not copied, so it
+    /// must remain valid until the batch has been sent.
+    ///
+    /// \return false if the batch is full.
+    bool push_back(ConstBuffer buf, const Endpoint& ep) noexcept
+    {
+        if (full()) {
+            return false;
+        }
+        eps_[size_] = ep;
+        set_msg(size_, buf, eps_[size_].data(), eps_[size_].size());
+        ++size_;
+        return true;
+    }
+    /// Queue a datagram for sending on a connected socket.
+    ///
+    /// \return false if the batch is full.
+    bool push_back(ConstBuffer buf) noexcept
+    {
+        if (full()) {
+            return false;
+        }
+        set_msg(size_, buf, nullptr, 0);
+        ++size_;
+        return true;
+    }
+
+    /// Resets every slot for receiving, and returns the message headers for recvmmsg().
+    mmsghdr* prepare_recv() noexcept
+    {
+        auto* const base = buf_.data();
+        for (std::size_t i{0}; i < msgs_.size(); ++i) {
+            set_msg(i, {base + i * max_size_, max_size_}, eps_[i].data(), eps_[i].capacity());
+        }
+        size_ = 0;
+        return msgs_.data();
+    }
+    /// Completes a receive of n datagrams into the slots returned by prepare_recv().
+    void commit_recv(std::size_t n) noexcept
+    {
+        assert(n <= msgs_.size());
+        for (std::size_t i{0}; i < n; ++i) {
+            eps_[i].resize(msgs_[i].msg_hdr.msg_namelen);
+        }
+        size_ = n;
+    }
+    /// Returns the message headers of the queued datagrams for sendmmsg().
+    mmsghdr* msgs() noexcept { return msgs_.data(); }
+
+  private:
+    void set_msg(std::size_t i, ConstBuffer buf, const void* name, std::size_t namelen) noexcept
+    {
+        iovs_[i].iov_base = const_cast<void*>(buf.data());
+        iovs_[i].iov_len = buf.size();
+        auto& hdr = msgs_[i].msg_hdr;
+        hdr.msg_name = const_cast<void*>(name);
+        hdr.msg_namelen = namelen;
+        hdr.msg_control = nullptr;
+        hdr.msg_controllen = 0;
+        hdr.msg_flags = 0;
+        msgs_[i].msg_len = 0;
+    }
+
+    std::size_t max_size_;
+    std::vector<char> buf_;
+    std::vector<Endpoint> eps_;
+    std::vector<iovec> iovs_;
+    std::vector<mmsghdr> msgs_;
+    std::size_t size_{0};
+};
+
+using DgramBatch = BasicDgramBatch<DgramEndpoint>;
+using UdpBatch = BasicDgramBatch<UdpEndpoint>;
+
+} // namespace net
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_DGRAMBATCH_HPP
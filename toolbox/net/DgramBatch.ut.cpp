@@ -0,0 +1,190 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DgramBatch.hpp"
+#include "DgramReader.hpp"
+#include "Frame.hpp"
+#include "Test.ut.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+using toolbox::test::make_bound_sock;
+
+namespace {
+
+struct Reader : DgramReader<Reader> {
+    Reader(Reactor& r, DgramSock&& sock)
+    : DgramReader<Reader>{r, std::move(sock), 4, 16}
+    {
+    }
+    void on_dgram(CyclTime /*now*/, ConstBuffer buf, const Endpoint& /*ep*/)
+    {
+        msgs.emplace_back(static_cast<const char*>(buf.data()), buf.size());
+    }
+    void on_dgram_error(CyclTime /*now*/, const std::system_error& /*e*/) { ++errors; }
+    vector<string> msgs;
+    int errors{0};
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(DgramBatchSuite)
+
+BOOST_AUTO_TEST_CASE(DgramBatchSendRecvCase)
+{
+    DgramEndpoint rx_ep, tx_ep;
+    auto rx = make_bound_sock(rx_ep);
+    auto tx = make_bound_sock(tx_ep);
+
+    DgramBatch out{4, 0};
+    BOOST_CHECK(out.push_back({"foo", 3}, rx_ep));
+    BOOST_CHECK(out.push_back({"barbaz", 6}, rx_ep));
+    BOOST_CHECK(out.push_back({"0123456789", 10}, rx_ep));
+    BOOST_CHECK_EQUAL(out.size(), 3U);
+    BOOST_CHECK_EQUAL(tx.sendmmsg(out, 0), 3U);
+
+    DgramBatch in{8, 8};
+    BOOST_CHECK_EQUAL(rx.recvmmsg(in, MSG_DONTWAIT), 3U);
+    BOOST_CHECK_EQUAL(in.size(), 3U);
+
+    const auto str = [&in](size_t i) {
+        return string{static_cast<const char*>(in.data(i).data()), in.data(i).size()};
+    };
+    BOOST_CHECK_EQUAL(str(0), "foo");
+    BOOST_CHECK_EQUAL(str(1), "barbaz");
+    // Truncated to the slot size.
+    BOOST_CHECK_EQUAL(str(2), "01234567");
+    BOOST_CHECK(!in.truncated(0));
+    BOOST_CHECK(in.truncated(2));
+    BOOST_CHECK_EQUAL(in.endpoint(0), tx_ep);
+
+    error_code ec;
+    BOOST_CHECK_EQUAL(rx.recvmmsg(in, MSG_DONTWAIT, ec), -1);
+    BOOST_CHECK(ec == errc::operation_would_block);
+}
+
+BOOST_AUTO_TEST_CASE(DgramBatchFullCase)
+{
+    DgramBatch batch{2, 0};
+    const DgramEndpoint ep{parse_dgram_endpoint("udp4://127.0.0.1:80")};
+    BOOST_CHECK(batch.push_back({"a", 1}, ep));
+    BOOST_CHECK(batch.push_back({"b", 1}, ep));
+    BOOST_CHECK(batch.full());
+    BOOST_CHECK(!batch.push_back({"c", 1}, ep));
+    batch.clear();
+    BOOST_CHECK(batch.empty());
+}
+
+BOOST_AUTO_TEST_CASE(DgramReaderCase)
+{
+    using namespace literals::chrono_literals;
+
+    Reactor r{1024};
+    DgramEndpoint rx_ep, tx_ep;
+    Reader reader{r, make_bound_sock(rx_ep)};
+    auto tx = make_bound_sock(tx_ep);
+
+    for (int i{0}; i < 6; ++i) {
+        const auto msg = to_string(i);
+        tx.sendto(msg.data(), msg.size(), 0, rx_ep);
+    }
+    // The first readiness event drains a full batch of four datagrams.
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK_EQUAL(reader.msgs.size(), 4U);
+    // The remainder are drained on the next cycle.
+    BOOST_CHECK_EQUAL(r.poll(CyclTime::now(), 0ms), 1);
+    BOOST_CHECK_EQUAL(reader.msgs.size(), 6U);
+    BOOST_CHECK_EQUAL(reader.msgs[0], "0");
+    BOOST_CHECK_EQUAL(reader.msgs[5], "5");
+    BOOST_CHECK_EQUAL(reader.errors, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DgramGsoGroCase)
+{
+    DgramEndpoint rx_ep, tx_ep;
+    auto rx = make_bound_sock(rx_ep);
+    auto tx = make_bound_sock(tx_ep);
+
+    error_code ec;
+    rx.set_udp_gro(true, ec);
+    if (ec) {
+        BOOST_TEST_MESSAGE("udp gro not supported: " << ec.message());
+        return;
+    }
+    // Ten segments of 100 bytes followed by a short segment of 50 bytes.
+    string out;
+    for (int i{0}; i < 11; ++i) {
+        out.append(i < 10 ? 100 : 50, static_cast<char>('a' + i));
+    }
+    tx.sendto_gso({out.data(), out.size()}, 100, 0, rx_ep, ec);
+    if (ec) {
+        BOOST_TEST_MESSAGE("udp gso not supported: " << ec.message());
+        return;
+    }
+
+    // Datagrams may or may not be coalesced, depending on the path, so receive until all have
+    // been accounted for.
+    vector<string> segs;
+    char buf[4096];
+    while (segs.size() < 11) {
+        DgramEndpoint ep;
+        size_t seg_size{0};
+        const auto n = rx.recvfrom_gro({buf, sizeof(buf)}, 0, ep, seg_size);
+        BOOST_CHECK_EQUAL(ep, tx_ep);
+        for_each_segment({buf, n}, seg_size, [&segs](ConstBuffer seg) {
+            segs.emplace_back(static_cast<const char*>(seg.data()), buffer_size(seg));
+        });
+    }
+    BOOST_CHECK_EQUAL(segs.size(), 11U);
+    BOOST_CHECK_EQUAL(segs[0], string(100, 'a'));
+    BOOST_CHECK_EQUAL(segs[9], string(100, 'j'));
+    BOOST_CHECK_EQUAL(segs[10], string(50, 'k'));
+}
+
+BOOST_AUTO_TEST_CASE(DgramGroTruncatedCase)
+{
+    DgramEndpoint rx_ep, tx_ep;
+    auto rx = make_bound_sock(rx_ep);
+    auto tx = make_bound_sock(tx_ep);
+
+    error_code ec;
+    rx.set_udp_gro(true, ec);
+    if (ec) {
+        BOOST_TEST_MESSAGE("udp gro not supported: " << ec.message());
+        return;
+    }
+    // The timestamp does not fit in the control buffer, so the control data is truncated and the
+    // segment size is unknown.
+    int optval{1};
+    os::setsockopt(rx.get(), SOL_SOCKET, SO_TIMESTAMP, &optval, sizeof(optval));
+
+    char buf[64];
+    DgramEndpoint ep;
+    size_t seg_size{0};
+    tx.sendto({"foobar", 6}, 0, rx_ep);
+    BOOST_CHECK_EQUAL(rx.recvfrom_gro({buf, sizeof(buf)}, 0, ep, seg_size, ec), -1);
+    BOOST_CHECK(ec == errc::message_size);
+    BOOST_CHECK_EQUAL(seg_size, 0U);
+
+    tx.sendto({"foobar", 6}, 0, rx_ep);
+    BOOST_CHECK_THROW(rx.recvfrom_gro({buf, sizeof(buf)}, 0, ep, seg_size), system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
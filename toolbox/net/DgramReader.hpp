@@ -0,0 +1,91 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_DGRAMREADER_HPP
+#define TOOLBOX_NET_DGRAMREADER_HPP
+
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/net/DgramSock.hpp>
+
+namespace toolbox {
+inline namespace net {
+
+/// Reactor-driven datagram reader.
+///
+/// Each readiness event is serviced with a single recvmmsg() call, which drains up to batch_size
+/// datagrams into a preallocated batch that is reused for every event. The derived class is then
+/// notified of each datagram in turn. Datagrams that remain in the socket's receive queue are read
+/// on the next reactor cycle, because the subscription is level-triggered.
+///
+/// The derived class must implement the following member functions:
+///
+///     void on_dgram(CyclTime now, ConstBuffer buf, const Endpoint& ep);
+///     void on_dgram_error(CyclTime now, const std::system_error& e);
+///
+/// Datagrams longer than max_size are truncated.
+template <typename DerivedT, typename SockT = DgramSock>
+class DgramReader {
+  public:
+    using Sock = SockT;
+    using Endpoint = typename SockT::Endpoint;
+    using Batch = BasicDgramBatch<Endpoint>;
+
+    DgramReader(Reactor& r, SockT&& sock, std::size_t batch_size = 64, std::size_t max_size = 2048)
+    : sock_{std::move(sock)}
+    , batch_{batch_size, max_size}
+    {
+        sock_.set_non_block();
+        sub_ = r.subscribe(*sock_, EpollIn, bind<&DgramReader::on_io_event>(this));
+    }
+
+    // Copy.
+    DgramReader(const DgramReader&) = delete;
+    DgramReader& operator=(const DgramReader&) = delete;
+
+    // Move.
+    DgramReader(DgramReader&&) = delete;
+    DgramReader& operator=(DgramReader&&) = delete;
+
+    const SockT& sock() const noexcept { return sock_; }
+    SockT& sock() noexcept { return sock_; }
+
+  protected:
+    ~DgramReader() = default;
+
+  private:
+    void on_io_event(CyclTime now, int /*fd*/, unsigned /*events*/)
+    {
+        std::error_code ec;
+        sock_.recvmmsg(batch_, 0, ec);
+        if (ec) {
+            if (ec != std::errc::operation_would_block) {
+                static_cast<DerivedT*>(this)->on_dgram_error(now, std::system_error{ec, "recvmmsg"});
+            }
+            return;
+        }
+        for (std::size_t i{0}; i < batch_.size(); ++i) {
+            static_cast<DerivedT*>(this)->on_dgram(now, batch_.data(i), batch_.endpoint(i));
+        }
+    }
+
+    SockT sock_;
+    Batch batch_;
+    Reactor::Handle sub_;
+};
+
+} // namespace net
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_DGRAMREADER_HPP
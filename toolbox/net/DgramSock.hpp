@@ -17,8 +17,10 @@
 #ifndef TOOLBOX_NET_DGRAMSOCK_HPP
 #define TOOLBOX_NET_DGRAMSOCK_HPP
 
+#include <toolbox/net/DgramBatch.hpp>
 #include <toolbox/net/Endpoint.hpp>
 #include <toolbox/net/IoSock.hpp>
+#include <toolbox/net/Timestamp.hpp>
 
 namespace toolbox {
 inline namespace net {
@@ -91,6 +93,88 @@ struct DgramSock : IoSock {
     {
         return os::sendto(get(), buf, flags, ep);
     }
+
+    void set_udp_segment(std::uint16_t size, std::error_code& ec) noexcept
+    {
+        toolbox::set_udp_segment(get(), size, ec);
+    }
+    void set_udp_segment(std::uint16_t size) { toolbox::set_udp_segment(get(), size); }
+
+    void set_udp_gro(bool enabled, std::error_code& ec) noexcept
+    {
+        toolbox::set_udp_gro(get(), enabled, ec);
+    }
+    void set_udp_gro(bool enabled) { toolbox::set_udp_gro(get(), enabled); }
+
+    /// Send a buffer as a series of datagrams of segment_size bytes using UDP GSO.
+    ssize_t sendto_gso(ConstBuffer buf, std::uint16_t segment_size, int flags, const Endpoint& ep,
+                       std::error_code& ec) noexcept
+    {
+        return os::sendto_gso(get(), buf, segment_size, flags, ep, ec);
+    }
+    std::size_t sendto_gso(ConstBuffer buf, std::uint16_t segment_size, int flags,
+                           const Endpoint& ep)
+    {
+        return os::sendto_gso(get(), buf, segment_size, flags, ep);
+    }
+
+    /// Receive a datagram, or a series of datagrams coalesced by UDP GRO. Use for_each_segment() to
+    /// split the buffer back into datagrams.
+    ssize_t recvfrom_gro(MutableBuffer buf, int flags, Endpoint& ep, std::size_t& segment_size,
+                         std::error_code& ec) noexcept
+    {
+        return os::recvfrom_gro(get(), buf, flags, ep, segment_size, ec);
+    }
+    std::size_t recvfrom_gro(MutableBuffer buf, int flags, Endpoint& ep, std::size_t& segment_size)
+    {
+        return os::recvfrom_gro(get(), buf, flags, ep, segment_size);
+    }
+
+    /// Receive a datagram together with its kernel or NIC receive timestamps.
+    ssize_t recvfrom(MutableBuffer buf, int flags, Endpoint& ep, PacketTimestamps& ts,
+                     std::error_code& ec) noexcept
+    {
+        return os::recvfrom(get(), buf, flags, ep, ts, ec);
+    }
+    std::size_t recvfrom(MutableBuffer buf, int flags, Endpoint& ep, PacketTimestamps& ts)
+    {
+        return os::recvfrom(get(), buf, flags, ep, ts);
+    }
+
+    /// Read a transmit timestamp from the error queue without blocking. Returns false if the queue
+    /// is empty.
+    bool recv_tx_timestamp(TxTimestamp& tx, std::error_code& ec) noexcept
+    {
+        return os::recv_tx_timestamp(get(), tx, ec);
+    }
+    bool recv_tx_timestamp(TxTimestamp& tx) { return os::recv_tx_timestamp(get(), tx); }
+
+    /// Receive up to batch.capacity() datagrams with a single system call.
+    int recvmmsg(DgramBatch& batch, int flags, std::error_code& ec) noexcept
+    {
+        const auto n = os::recvmmsg(get(), batch.prepare_recv(), batch.capacity(), flags, ec);
+        if (n > 0) {
+            batch.commit_recv(n);
+        }
+        return n;
+    }
+    std::size_t recvmmsg(DgramBatch& batch, int flags)
+    {
+        const auto n = os::recvmmsg(get(), batch.prepare_recv(), batch.capacity(), flags);
+        batch.commit_recv(n);
+        return n;
+    }
+
+    /// Send the queued datagrams with a single system call. Returns the number of datagrams sent,
+    /// which may be fewer than batch.size().
+    int sendmmsg(DgramBatch& batch, int flags, std::error_code& ec) noexcept
+    {
+        return os::sendmmsg(get(), batch.msgs(), batch.size(), flags, ec);
+    }
+    std::size_t sendmmsg(DgramBatch& batch, int flags)
+    {
+        return os::sendmmsg(get(), batch.msgs(), batch.size(), flags);
+    }
 };
 
 } // namespace net
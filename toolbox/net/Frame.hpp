@@ -19,7 +19,11 @@
 
 #include <toolbox/io/Buffer.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <stdexcept>
 
 namespace toolbox {
 inline namespace net {
@@ -102,6 +106,130 @@ inline void put_length(MutableBuffer buf, std::uint16_t len, std::endian net_byt
     put_length(static_cast<char*>(buf.data()), len, net_byte_order);
 }
 
+/// Reads a binary-encoded 4 byte integer from the input buffer.
+///
+/// \param buf The input buffer, which must be at least 4 bytes in length.
+/// \param net_byte_order Endianness used for network byte order decoding.
+/// \return the decoded 4 byte integer.
+constexpr std::uint32_t get_length32(const char* buf, std::endian net_byte_order) noexcept
+{
+    std::uint32_t len{0};
+    // Most significant byte first.
+    for (int i{0}; i < 4; ++i) {
+        const int j{net_byte_order == std::endian::little ? 3 - i : i};
+        len = (len << 8) | (buf[j] & 0xff);
+    }
+    return len;
+}
+
+/// Writes a binary-encoded 4 byte integer to the output buffer.
+///
+/// \param buf The output buffer, which must be at least 4 bytes in length.
+/// \param len The length to be encoded.
+/// \param net_byte_order Endianness used for network byte order encoding.
+inline void put_length32(char* buf, std::uint32_t len, std::endian net_byte_order) noexcept
+{
+    // Least significant byte first.
+    for (int i{0}; i < 4; ++i) {
+        const int j{net_byte_order == std::endian::little ? i : 3 - i};
+        buf[j] = static_cast<char>(len & 0xff);
+        len >>= 8;
+    }
+}
+
+/// Maximum size of a base 128 varint encoding of a 64-bit integer.
+constexpr std::size_t MaxVarintSize{10};
+
+/// Writes a base 128 varint to the output buffer, least significant group first.
+///
+/// \param buf The output buffer, which must be at least MaxVarintSize bytes in length.
+/// \param val The value to be encoded.
+/// \return the number of bytes written.
+inline std::size_t put_varint(char* buf, std::uint64_t val) noexcept
+{
+    std::size_t n{0};
+    while (val >= 0x80) {
+        buf[n++] = static_cast<char>((val & 0x7f) | 0x80);
+        val >>= 7;
+    }
+    buf[n++] = static_cast<char>(val);
+    return n;
+}
+
+/// Reads a base 128 varint from the input buffer.
+///
+/// \param buf The input buffer.
+/// \param val The decoded value.
+/// \return the number of bytes consumed, zero if the buffer does not contain a complete varint, or
+/// -1 if the varint is longer than MaxVarintSize bytes.
+inline int get_varint(ConstBuffer buf, std::uint64_t& val) noexcept
+{
+    const auto* data = static_cast<const unsigned char*>(buf.data());
+    const auto size = std::min(buffer_size(buf), MaxVarintSize);
+    std::uint64_t res{0};
+    for (std::size_t i{0}; i < size; ++i) {
+        res |= std::uint64_t{data[i] & 0x7fU} << (7 * i);
+        if (!(data[i] & 0x80)) {
+            val = res;
+            return static_cast<int>(i + 1);
+        }
+    }
+    return size == MaxVarintSize ? -1 : 0;
+}
+
+/// Length prefix encodings of a frame.
+enum class FrameLength : std::uint8_t {
+    /// 2 byte length of the frame, including the prefix.
+    Fixed16,
+    /// 4 byte length of the frame, including the prefix.
+    Fixed32,
+    /// Base 128 varint length of the payload, excluding the prefix.
+    Varint
+};
+
+/// Maximum size of a frame's length prefix.
+constexpr std::size_t MaxFrameHeader{MaxVarintSize};
+
+/// Returns the maximum payload size that can be encoded in a frame.
+constexpr std::size_t max_frame_payload(FrameLength len) noexcept
+{
+    switch (len) {
+    case FrameLength::Fixed16:
+        return 0xffff - sizeof(std::uint16_t);
+    case FrameLength::Fixed32:
+        return 0xffffffff - sizeof(std::uint32_t);
+    case FrameLength::Varint:
+        break;
+    }
+    return 0xffffffff;
+}
+
+/// Writes the length prefix of a frame to the output buffer.
+///
+/// \param buf The output buffer, which must be at least MaxFrameHeader bytes in length.
+/// \param payload_size The size of the payload, which must not exceed max_frame_payload().
+/// \param len The length prefix encoding.
+/// \param net_byte_order Endianness used for network byte order encoding of fixed lengths.
+/// \return the size of the length prefix.
+inline std::size_t put_frame_header(char* buf, std::size_t payload_size, FrameLength len,
+                                    std::endian net_byte_order) noexcept
+{
+    assert(payload_size <= max_frame_payload(len));
+    switch (len) {
+    case FrameLength::Fixed16:
+        put_length(buf, static_cast<std::uint16_t>(payload_size + sizeof(std::uint16_t)),
+                   net_byte_order);
+        return sizeof(std::uint16_t);
+    case FrameLength::Fixed32:
+        put_length32(buf, static_cast<std::uint32_t>(payload_size + sizeof(std::uint32_t)),
+                     net_byte_order);
+        return sizeof(std::uint32_t);
+    case FrameLength::Varint:
+        break;
+    }
+    return put_varint(buf, payload_size);
+}
+
 /// Calls the function object for each message encapsulated in a length-prefixed frame.
 ///
 /// \tparam FnT The type of the function object.
@@ -143,6 +271,82 @@ std::size_t parse_frame(std::string_view buf, FnT fn, std::endian net_byte_order
     return parse_frame(ConstBuffer{buf.data(), buf.size()}, fn, net_byte_order);
 }
 
+/// Calls the function object for each message encapsulated in a length-prefixed frame.
+///
+/// \tparam FnT The type of the function object.
+/// \param buf The input buffer.
+/// \param fn The function object that is called for each complete message.
+/// \param len The length prefix encoding.
+/// \param net_byte_order Endianness used for network byte order decoding of fixed lengths.
+/// \return the total number of consumed bytes.
+/// \throw std::runtime_error if a length prefix is malformed.
+template <typename FnT>
+std::size_t parse_frame(ConstBuffer buf, FnT fn, FrameLength len, std::endian net_byte_order)
+{
+    if (len == FrameLength::Fixed16) {
+        return parse_frame(buf, fn, net_byte_order);
+    }
+    std::size_t consumed{0};
+    for (;;) {
+        const auto* data = static_cast<const char*>(buf.data());
+        const std::size_t size = buffer_size(buf);
+        std::size_t header, total;
+        if (len == FrameLength::Fixed32) {
+            if (size < sizeof(std::uint32_t)) {
+                break;
+            }
+            header = sizeof(std::uint32_t);
+            total = get_length32(data, net_byte_order);
+            if (total < header) {
+                throw std::runtime_error{"invalid frame length"};
+            }
+        } else {
+            std::uint64_t payload_size;
+            const int n{get_varint(buf, payload_size)};
+            if (n == 0) {
+                break;
+            }
+            if (n < 0 || payload_size > max_frame_payload(len)) {
+                throw std::runtime_error{"invalid frame length"};
+            }
+            header = n;
+            total = header + payload_size;
+        }
+        if (size < total) {
+            break;
+        }
+        fn(ConstBuffer{data + header, total - header});
+        buf = advance(buf, total);
+        consumed += total;
+    }
+    return consumed;
+}
+
+/// Calls the function object for each datagram in a buffer of coalesced datagrams, such as one
+/// received with UDP GRO or sent with UDP GSO.
+///
+/// \tparam FnT The type of the function object.
+/// \param buf The input buffer.
+/// \param segment_size The size of each datagram, except the last, which may be shorter. A size of
+/// zero is treated as a single datagram spanning the whole buffer.
+/// \param fn The function object that is called for each datagram.
+/// \return the number of datagrams.
+template <typename FnT>
+std::size_t for_each_segment(ConstBuffer buf, std::size_t segment_size, FnT fn)
+{
+    if (segment_size == 0) {
+        segment_size = buffer_size(buf);
+    }
+    std::size_t n{0};
+    while (buffer_size(buf) > 0) {
+        const auto size = std::min(buffer_size(buf), segment_size);
+        fn(ConstBuffer{buf.data(), size});
+        buf = advance(buf, size);
+        ++n;
+    }
+    return n;
+}
+
 } // namespace net
 } // namespace toolbox
 
@@ -18,6 +18,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
+#include <string>
+#include <vector>
+
 using namespace std;
 using namespace toolbox;
 
@@ -97,4 +101,99 @@ BOOST_AUTO_TEST_CASE(ParseFrameCase)
                       "Baz");
 }
 
+BOOST_AUTO_TEST_CASE(PutLength32Case)
+{
+    constexpr uint32_t Length{0x01020304};
+    char buf[4]{};
+    put_length32(buf, Length, endian::little);
+    BOOST_CHECK_EQUAL(string_view(buf, 4), "\x04\x03\x02\x01"sv);
+    BOOST_CHECK_EQUAL(get_length32(buf, endian::little), Length);
+
+    put_length32(buf, Length, endian::big);
+    BOOST_CHECK_EQUAL(string_view(buf, 4), "\x01\x02\x03\x04"sv);
+    BOOST_CHECK_EQUAL(get_length32(buf, endian::big), Length);
+}
+
+BOOST_AUTO_TEST_CASE(VarintCase)
+{
+    char buf[MaxVarintSize];
+    uint64_t val{};
+
+    BOOST_CHECK_EQUAL(put_varint(buf, 0), 1U);
+    BOOST_CHECK_EQUAL(get_varint({buf, 1}, val), 1);
+    BOOST_CHECK_EQUAL(val, 0U);
+
+    BOOST_CHECK_EQUAL(put_varint(buf, 300), 2U);
+    BOOST_CHECK_EQUAL(string_view(buf, 2), "\xac\x02"sv);
+    BOOST_CHECK_EQUAL(get_varint({buf, 2}, val), 2);
+    BOOST_CHECK_EQUAL(val, 300U);
+    // Incomplete.
+    BOOST_CHECK_EQUAL(get_varint({buf, 1}, val), 0);
+
+    BOOST_CHECK_EQUAL(put_varint(buf, numeric_limits<uint64_t>::max()), MaxVarintSize);
+    BOOST_CHECK_EQUAL(get_varint({buf, MaxVarintSize}, val), 10);
+    BOOST_CHECK_EQUAL(val, numeric_limits<uint64_t>::max());
+
+    // Too long.
+    fill(begin(buf), end(buf), '\x80');
+    BOOST_CHECK_EQUAL(get_varint({buf, MaxVarintSize}, val), -1);
+}
+
+BOOST_AUTO_TEST_CASE(ParseFrameLengthCase)
+{
+    const string big(300, 'x');
+    for (const auto len : {FrameLength::Fixed16, FrameLength::Fixed32, FrameLength::Varint}) {
+        string frames;
+        for (const auto msg : {"foo"sv, ""sv, string_view{big}}) {
+            char header[MaxFrameHeader];
+            const auto n = put_frame_header(header, msg.size(), len, endian::big);
+            frames.append(header, n);
+            frames.append(msg);
+        }
+        vector<string> msgs;
+        const auto fn = [&](ConstBuffer msg) {
+            msgs.emplace_back(static_cast<const char*>(msg.data()), msg.size());
+        };
+        // Partial frame.
+        BOOST_CHECK_EQUAL(parse_frame({frames.data(), 4}, fn, len, endian::big),
+                          len == FrameLength::Varint ? 4U : 0U);
+        msgs.clear();
+        BOOST_CHECK_EQUAL(parse_frame({frames.data(), frames.size()}, fn, len, endian::big),
+                          frames.size());
+        BOOST_REQUIRE_EQUAL(msgs.size(), 3U);
+        BOOST_CHECK_EQUAL(msgs[0], "foo");
+        BOOST_CHECK(msgs[1].empty());
+        BOOST_CHECK_EQUAL(msgs[2], big);
+    }
+    const char bad[]{0, 0, 0, 1};
+    BOOST_CHECK_THROW(parse_frame({bad, sizeof(bad)}, [](ConstBuffer) {}, FrameLength::Fixed32,
+                                  endian::big),
+                      runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ForEachSegmentCase)
+{
+    vector<string> segs;
+    auto fn = [&segs](ConstBuffer buf) {
+        segs.emplace_back(static_cast<const char*>(buf.data()), buffer_size(buf));
+    };
+    const auto data = "FooBarBazQu"sv;
+    BOOST_CHECK_EQUAL(for_each_segment({data.data(), data.size()}, 3, fn), 4U);
+    BOOST_CHECK_EQUAL(segs.size(), 4U);
+    BOOST_CHECK_EQUAL(segs[0], "Foo");
+    BOOST_CHECK_EQUAL(segs[2], "Baz");
+    // The last segment may be shorter.
+    BOOST_CHECK_EQUAL(segs[3], "Qu");
+
+    segs.clear();
+    BOOST_CHECK_EQUAL(for_each_segment({data.data(), 0}, 3, fn), 0U);
+    BOOST_CHECK(segs.empty());
+
+    // A zero segment size yields the whole buffer.
+    BOOST_CHECK_EQUAL(for_each_segment({data.data(), data.size()}, 0, fn), 1U);
+    BOOST_CHECK_EQUAL(segs.size(), 1U);
+    BOOST_CHECK_EQUAL(segs[0], data);
+    BOOST_CHECK_EQUAL(for_each_segment({data.data(), 0}, 0, fn), 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,309 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_FRAMEDCONN_HPP
+#define TOOLBOX_NET_FRAMEDCONN_HPP
+
+#include <toolbox/io/Reactor.hpp>
+#include <toolbox/net/Frame.hpp>
+#include <toolbox/net/IoSock.hpp>
+
+#include <cstring>
+#include <optional>
+
+namespace toolbox {
+inline namespace net {
+
+/// Stream connection that exchanges length-prefixed frames.
+///
+/// The DerivedT type must provide the following member functions:
+///
+/// - on_frame(CyclTime now, ConstBuffer payload) for each frame received;
+/// - on_conn_disconnect(CyclTime now) when the peer closes the connection;
+/// - on_conn_error(CyclTime now, const std::system_error& e) when an I/O error occurs.
+///
+/// The connection is unsubscribed from the reactor before either of the last two functions is
+/// called, so that DerivedT may destroy the connection from within them. It must not be destroyed
+/// from within on_frame().
+///
+/// DerivedT may also provide on_zerocopy_complete(CyclTime now, const ZeroCopyCompletion& zc) to
+/// be notified when the payloads of send_zerocopy() may be reused.
+template <typename DerivedT>
+class FramedConn {
+  public:
+    /// Constructs a framed connection on a connected, non-blocking socket; for example, one passed
+    /// to StreamConnector::on_sock_connect() or StreamAcceptor::on_sock_accept().
+    ///
+    /// \param r The reactor.
+    /// \param sock The connected socket.
+    /// \param len The length prefix encoding.
+    /// \param net_byte_order Endianness used for network byte order encoding of fixed lengths.
+    FramedConn(Reactor& r, IoSock&& sock, FrameLength len, std::endian net_byte_order)
+    : sock_{std::move(sock)}
+    , len_{len}
+    , net_byte_order_{net_byte_order}
+    {
+        // Edge-triggered, so that waiting for the socket to become writable does not require a
+        // system call.
+        sub_ = r.subscribe(*sock_, EpollIn | EpollRdHup | EpollEt,
+                           bind<&FramedConn::on_io_event>(this));
+    }
+
+    // Copy.
+    FramedConn(const FramedConn&) = delete;
+    FramedConn& operator=(const FramedConn&) = delete;
+
+    // Move.
+    FramedConn(FramedConn&&) = delete;
+    FramedConn& operator=(FramedConn&&) = delete;
+
+    const IoSock& sock() const noexcept { return sock_; }
+    FrameLength frame_length() const noexcept { return len_; }
+    /// Returns true while the connection is subscribed to the reactor.
+    bool connected() const noexcept { return static_cast<bool>(sub_); }
+    /// Returns the number of bytes waiting for the socket to become writable.
+    std::size_t pending() const noexcept { return out_.size(); }
+
+    /// Sends a frame.
+    ///
+    /// When no output is pending, the header and payload are written directly from the caller's
+    /// buffer with a single writev() call. Any part that cannot be written immediately is copied to
+    /// the output buffer and flushed when the socket becomes writable.
+    ///
+    /// \throw std::invalid_argument if the payload exceeds the maximum frame size.
+    /// \throw std::system_error on I/O error.
+    void send(ConstBuffer payload)
+    {
+        char header[MaxFrameHeader];
+        const auto header_size = put_header(header, payload);
+        if (!out_.empty()) {
+            write_rest({header, header_size}, payload, 0);
+            return;
+        }
+        const iovec iov[]{{header, header_size},
+                          {const_cast<void*>(payload.data()), buffer_size(payload)}};
+        std::error_code ec;
+        auto n = sock_.writev(iov, 2, ec);
+        if (ec) {
+            if (ec != std::errc::operation_would_block) {
+                throw std::system_error{ec, "writev"};
+            }
+            n = 0;
+        }
+        write_rest({header, header_size}, payload, n);
+    }
+
+    /// Sends a frame with MSG_ZEROCOPY, which avoids copying the payload into the kernel.
+    ///
+    /// Zero-copy must first be enabled on the socket with Sock::set_zerocopy(). The page pinning
+    /// and completion notification costs are only likely to be recovered for payloads of more than
+    /// about 10KB. The payload must not be modified or released until on_zerocopy_complete()
+    /// reports the returned sequence number.
+    ///
+    /// The payload is copied instead when output is already pending, or when the kernel cannot
+    /// accept a zero-copy send; the same applies to any part of the payload that cannot be sent
+    /// immediately.
+    ///
+    /// \return the sequence number of the zero-copy send, or std::nullopt if the payload was
+    /// copied and may be reused immediately.
+    /// \throw std::invalid_argument if the payload exceeds the maximum frame size.
+    /// \throw std::system_error on I/O error.
+    std::optional<std::uint32_t> send_zerocopy(ConstBuffer payload)
+    {
+        char header[MaxFrameHeader];
+        const auto header_size = put_header(header, payload);
+        if (!out_.empty()) {
+            write_rest({header, header_size}, payload, 0);
+            return std::nullopt;
+        }
+        // The kernel references pinned user pages until the send completes, so the header, which
+        // is a temporary, is sent separately with a regular copy.
+        std::error_code ec;
+        auto n = sock_.send(header, header_size, MSG_MORE, ec);
+        if (ec) {
+            if (ec != std::errc::operation_would_block) {
+                throw std::system_error{ec, "send"};
+            }
+            n = 0;
+        }
+        if (static_cast<std::size_t>(n) < header_size) {
+            write_rest({header, header_size}, payload, n);
+            return std::nullopt;
+        }
+        n = sock_.send(payload, MSG_ZEROCOPY, ec);
+        if (ec) {
+            // ENOBUFS is returned when the socket's optmem limit is exceeded by pinned pages.
+            if (ec != std::errc::operation_would_block && ec != std::errc::no_buffer_space) {
+                throw std::system_error{ec, "send"};
+            }
+            write_rest({}, payload, 0);
+            return std::nullopt;
+        }
+        write_rest({}, payload, n);
+        return zerocopy_seq_++;
+    }
+
+  protected:
+    ~FramedConn() = default;
+
+    void on_zerocopy_complete(CyclTime /*now*/, const ZeroCopyCompletion& /*zc*/) noexcept {}
+
+  private:
+    std::size_t put_header(char* header, ConstBuffer payload) const
+    {
+        if (buffer_size(payload) > max_frame_payload(len_)) {
+            throw std::invalid_argument{"frame payload too large"};
+        }
+        return put_frame_header(header, buffer_size(payload), len_, net_byte_order_);
+    }
+    void append(ConstBuffer buf)
+    {
+        const auto size = buffer_size(buf);
+        if (size > 0) {
+            std::memcpy(out_.prepare(size).data(), buf.data(), size);
+            out_.commit(size);
+        }
+    }
+    /// Buffers the part of the header and payload that was not written.
+    void write_rest(ConstBuffer header, ConstBuffer payload, std::size_t written)
+    {
+        const auto header_size = buffer_size(header);
+        if (written < header_size) {
+            append(advance(header, written));
+            written = 0;
+        } else {
+            written -= header_size;
+        }
+        append(advance(payload, written));
+        if (!out_.empty() && !write_blocked_ && sub_) {
+            sub_.set_events(EpollIn | EpollOut | EpollRdHup | EpollEt);
+            write_blocked_ = true;
+        }
+    }
+    void on_io_event(CyclTime now, int /*fd*/, unsigned events)
+    {
+        try {
+            if (events & EpollErr) {
+                drain_errqueue(now);
+            }
+            if (events & EpollOut) {
+                flush_output();
+            }
+            if (events & (EpollIn | EpollRdHup | EpollHup)) {
+                if (!drain_input(now, events & (EpollRdHup | EpollHup))) {
+                    sub_.reset();
+                    static_cast<DerivedT*>(this)->on_conn_disconnect(now);
+                }
+            }
+        } catch (const std::system_error& e) {
+            sub_.reset();
+            static_cast<DerivedT*>(this)->on_conn_error(now, e);
+        }
+    }
+    void drain_errqueue(CyclTime now)
+    {
+        ZeroCopyCompletion zc;
+        bool any{false};
+        while (sock_.recv_zerocopy_completion(zc)) {
+            static_cast<DerivedT*>(this)->on_zerocopy_complete(now, zc);
+            any = true;
+        }
+        if (!any) {
+            // The error was not a queued notification, so it must be a pending socket error.
+            if (const auto ec = sock_.get_error(); ec) {
+                throw std::system_error{ec, "socket"};
+            }
+        }
+    }
+    void flush_output()
+    {
+        if (!out_.empty()) {
+            std::error_code ec;
+            const auto n = sock_.write(out_.data(), ec);
+            if (ec) {
+                // The readiness may have been consumed since it was signalled.
+                if (ec != std::errc::operation_would_block) {
+                    throw std::system_error{ec, "write"};
+                }
+                return;
+            }
+            out_.consume(n);
+        }
+        if (out_.empty() && write_blocked_) {
+            // Restore read-only state after the buffer has been drained.
+            sub_.set_events(EpollIn | EpollRdHup | EpollEt);
+            write_blocked_ = false;
+        }
+    }
+    bool drain_input(CyclTime now, bool hangup)
+    {
+        // Limit the number of reads to avoid starvation.
+        bool drained{false}, eof{false};
+        for (int i{0}; i < 4 && !drained; ++i) {
+            std::error_code ec;
+            const auto buf = in_.prepare(4096);
+            const auto size = sock_.read(buf, ec);
+            if (ec) {
+                // No data available in socket buffer.
+                if (ec == std::errc::operation_would_block) {
+                    drained = true;
+                    break;
+                }
+                throw std::system_error{ec, "read"};
+            }
+            if (size == 0) {
+                // Deliver any complete frames that were read with the end of the stream.
+                eof = true;
+                break;
+            }
+            in_.commit(size);
+            // Assume that the TCP stream has been drained if we read less than the requested
+            // amount, unless the end of the stream is still to be read.
+            drained = !hangup && static_cast<std::size_t>(size) < buffer_size(buf);
+        }
+        if (!drained && !eof) {
+            // Resume reading on the next cycle, because the subscription is edge-triggered. Any
+            // hangup is retained, so that the end of the stream is still read.
+            sub_.set_ready(hangup ? EpollIn | EpollRdHup : EpollIn);
+        }
+        try {
+            in_.consume(parse_frame(
+                in_.data(),
+                [this, now](ConstBuffer payload) {
+                    static_cast<DerivedT*>(this)->on_frame(now, payload);
+                },
+                len_, net_byte_order_));
+        } catch (const std::system_error&) {
+            throw;
+        } catch (const std::runtime_error& e) {
+            // Malformed length prefix.
+            throw std::system_error{std::make_error_code(std::errc::bad_message), e.what()};
+        }
+        return !eof;
+    }
+
+    IoSock sock_;
+    const FrameLength len_;
+    const std::endian net_byte_order_;
+    Reactor::Handle sub_;
+    Buffer in_, out_;
+    std::uint32_t zerocopy_seq_{0};
+    bool write_blocked_{false};
+};
+
+} // namespace net
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_FRAMEDCONN_HPP
@@ -0,0 +1,201 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FramedConn.hpp"
+
+#include "Endpoint.hpp"
+#include "StreamSock.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+struct Conn : FramedConn<Conn> {
+    Conn(Reactor& r, IoSock&& sock, FrameLength len)
+    : FramedConn<Conn>{r, std::move(sock), len, endian::big}
+    {
+    }
+    void on_frame(CyclTime /*now*/, ConstBuffer payload)
+    {
+        frames.emplace_back(static_cast<const char*>(payload.data()), payload.size());
+    }
+    void on_conn_disconnect(CyclTime /*now*/) { disconnected = true; }
+    void on_conn_error(CyclTime /*now*/, const std::system_error& e) { error = e.code(); }
+    void on_zerocopy_complete(CyclTime /*now*/, const ZeroCopyCompletion& zc)
+    {
+        completions.push_back(zc);
+    }
+    vector<string> frames;
+    vector<ZeroCopyCompletion> completions;
+    bool disconnected{false};
+    error_code error;
+};
+
+pair<IoSock, IoSock> make_socketpair()
+{
+    auto socks = socketpair(UnixStreamProtocol{});
+    socks.first.set_non_block();
+    socks.second.set_non_block();
+    return socks;
+}
+
+template <typename PredT>
+void poll_until(Reactor& r, PredT pred)
+{
+    for (int i{0}; i < 10000 && !pred(); ++i) {
+        r.poll(CyclTime::now(), 0ms);
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FramedConnSuite)
+
+BOOST_AUTO_TEST_CASE(FramedConnSendRecvCase)
+{
+    for (const auto len : {FrameLength::Fixed16, FrameLength::Fixed32, FrameLength::Varint}) {
+        Reactor r;
+        auto socks = make_socketpair();
+        Conn a{r, std::move(socks.first), len};
+        Conn b{r, std::move(socks.second), len};
+
+        a.send({"foo", 3});
+        a.send({"", 0});
+        a.send({"barbaz", 6});
+        BOOST_CHECK_EQUAL(a.pending(), 0U);
+
+        poll_until(r, [&b]() { return b.frames.size() == 3; });
+        BOOST_REQUIRE_EQUAL(b.frames.size(), 3U);
+        BOOST_CHECK_EQUAL(b.frames[0], "foo");
+        BOOST_CHECK(b.frames[1].empty());
+        BOOST_CHECK_EQUAL(b.frames[2], "barbaz");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(FramedConnBlockedCase)
+{
+    Reactor r;
+    auto socks = make_socketpair();
+    Conn a{r, std::move(socks.first), FrameLength::Fixed32};
+    Conn b{r, std::move(socks.second), FrameLength::Fixed32};
+
+    // Larger than the socket buffer, so that the remainder is buffered.
+    const string big(4 << 20, 'x');
+    a.send({big.data(), big.size()});
+    BOOST_CHECK_GT(a.pending(), 0U);
+    // Queued behind the pending output.
+    a.send({"foo", 3});
+
+    poll_until(r, [&b]() { return b.frames.size() == 2; });
+    BOOST_CHECK_EQUAL(a.pending(), 0U);
+    BOOST_REQUIRE_EQUAL(b.frames.size(), 2U);
+    BOOST_CHECK(b.frames[0] == big);
+    BOOST_CHECK_EQUAL(b.frames[1], "foo");
+
+    auto socks16 = make_socketpair();
+    Conn c{r, std::move(socks16.first), FrameLength::Fixed16};
+    BOOST_CHECK_THROW(c.send({big.data(), 0x10000}), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(FramedConnDisconnectCase)
+{
+    Reactor r;
+    auto socks = make_socketpair();
+    auto a = make_unique<Conn>(r, std::move(socks.first), FrameLength::Varint);
+    Conn b{r, std::move(socks.second), FrameLength::Varint};
+
+    a->send({"foo", 3});
+    a.reset();
+    poll_until(r, [&b]() { return b.disconnected; });
+    BOOST_CHECK(b.disconnected);
+    BOOST_CHECK(!b.connected());
+    BOOST_REQUIRE_EQUAL(b.frames.size(), 1U);
+    BOOST_CHECK_EQUAL(b.frames[0], "foo");
+}
+
+BOOST_AUTO_TEST_CASE(FramedConnHangupCase)
+{
+    Reactor r;
+    auto socks = make_socketpair();
+    Conn a{r, std::move(socks.first), FrameLength::Fixed32};
+    Conn b{r, std::move(socks.second), FrameLength::Fixed32};
+
+    // More than can be read in a single cycle, followed by the end of the stream, so that the
+    // hangup must be retained across cycles.
+    const string big(32 << 10, 'x');
+    a.send({big.data(), big.size()});
+    BOOST_REQUIRE_EQUAL(a.pending(), 0U);
+    os::shutdown(a.sock().get(), SHUT_WR);
+
+    poll_until(r, [&b]() { return b.disconnected; });
+    BOOST_CHECK(b.disconnected);
+    BOOST_REQUIRE_EQUAL(b.frames.size(), 1U);
+    BOOST_CHECK(b.frames[0] == big);
+}
+
+BOOST_AUTO_TEST_CASE(FramedConnBadFrameCase)
+{
+    Reactor r;
+    auto socks = make_socketpair();
+    // A 32-bit frame length that is shorter than the prefix.
+    socks.first.write("\0\0\0\1", 4);
+    Conn b{r, std::move(socks.second), FrameLength::Fixed32};
+    poll_until(r, [&b]() { return !b.connected(); });
+    BOOST_CHECK(b.error == errc::bad_message);
+}
+
+BOOST_AUTO_TEST_CASE(FramedConnZeroCopyCase)
+{
+    Reactor r;
+    auto ep = parse_stream_endpoint("tcp4://127.0.0.1:0");
+    StreamSockServ serv{ep.protocol()};
+    serv.bind(ep);
+    serv.listen(1);
+    serv.get_sock_name(ep);
+
+    StreamSockClnt clnt{ep.protocol()};
+    clnt.connect(ep);
+    clnt.set_non_block();
+    clnt.set_zerocopy(true);
+    StreamEndpoint peer;
+    auto acc = serv.accept(peer);
+    acc.set_non_block();
+
+    Conn a{r, std::move(clnt), FrameLength::Varint};
+    Conn b{r, std::move(acc), FrameLength::Varint};
+
+    const string payload(64 << 10, 'x');
+    const auto seq = a.send_zerocopy({payload.data(), payload.size()});
+    BOOST_REQUIRE(seq);
+    BOOST_CHECK_EQUAL(*seq, 0U);
+
+    poll_until(r, [&]() { return b.frames.size() == 1 && !a.completions.empty(); });
+    BOOST_REQUIRE_EQUAL(b.frames.size(), 1U);
+    BOOST_CHECK(b.frames[0] == payload);
+    BOOST_REQUIRE_EQUAL(a.completions.size(), 1U);
+    BOOST_CHECK_EQUAL(a.completions[0].lo, 0U);
+    BOOST_CHECK_EQUAL(a.completions[0].hi, 0U);
+    // Loopback always copies.
+    BOOST_CHECK(a.completions[0].copied);
+    BOOST_CHECK(a.connected());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
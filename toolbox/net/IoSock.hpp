@@ -80,6 +80,12 @@ struct IoSock : Sock {
     }
     std::size_t write(ConstBuffer buf) { return os::write(get(), buf); }
 
+    ssize_t writev(const iovec* iov, int iovcnt, std::error_code& ec) noexcept
+    {
+        return os::writev(get(), iov, iovcnt, ec);
+    }
+    std::size_t writev(const iovec* iov, int iovcnt) { return os::writev(get(), iov, iovcnt); }
+
     ssize_t send(const void* buf, std::size_t len, int flags, std::error_code& ec) noexcept
     {
         return os::send(get(), buf, len, flags, ec);
@@ -94,6 +100,23 @@ struct IoSock : Sock {
         return os::send(get(), buf, flags, ec);
     }
     std::size_t send(ConstBuffer buf, int flags) { return os::send(get(), buf, flags); }
+
+    ssize_t sendmsg(const msghdr& msg, int flags, std::error_code& ec) noexcept
+    {
+        return os::sendmsg(get(), msg, flags, ec);
+    }
+    std::size_t sendmsg(const msghdr& msg, int flags) { return os::sendmsg(get(), msg, flags); }
+
+    /// Read a MSG_ZEROCOPY completion from the error queue without blocking. Returns false if the
+    /// queue is empty.
+    bool recv_zerocopy_completion(ZeroCopyCompletion& zc, std::error_code& ec) noexcept
+    {
+        return os::recv_zerocopy_completion(get(), zc, ec);
+    }
+    bool recv_zerocopy_completion(ZeroCopyCompletion& zc)
+    {
+        return os::recv_zerocopy_completion(get(), zc);
+    }
 };
 
 template <typename ProtocolT>
@@ -0,0 +1,232 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_RECONNECTINGCONNECTOR_HPP
+#define TOOLBOX_NET_RECONNECTINGCONNECTOR_HPP
+
+#include <toolbox/net/StreamConnector.hpp>
+#include <toolbox/util/Random.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace toolbox {
+inline namespace net {
+
+/// Reconnection policy of a ReconnectingConnector.
+struct ReconnectPolicy {
+    /// Delay before retrying after every endpoint has failed.
+    Duration min_backoff{100ms};
+    /// Upper bound on the delay between retries.
+    Duration max_backoff{10s};
+    /// Factor by which the delay grows after each round of failures.
+    double multiplier{2.0};
+    /// Fraction of the delay that is randomised, so that many clients do not retry in lock-step.
+    double jitter{0.2};
+    /// Time allowed for each connection attempt, or zero for no limit.
+    Duration connect_timeout{1s};
+    /// Idle time before TCP keepalive probes are sent, or zero to disable keepalive.
+    Seconds keep_idle{0s};
+    /// Interval between keepalive probes.
+    Seconds keep_intvl{1s};
+    /// Number of unanswered keepalive probes after which the connection is dropped.
+    int keep_cnt{3};
+    /// Maximum time that transmitted data may remain unacknowledged, or zero for the system default.
+    Millis user_timeout{0ms};
+};
+
+/// Stream connector that retries failed connection attempts until a connection is established.
+///
+/// Endpoints are tried in turn, so that failover to a backup endpoint is immediate. The connector
+/// only backs off, with exponential delay and jitter, once every endpoint has failed. Retries and
+/// connect timeouts are scheduled on the reactor's timer queue.
+///
+/// The DerivedT type must provide the following member functions:
+///
+/// - on_connect(CyclTime now, IoSock&& sock, const Endpoint& ep) when a connection is established;
+/// - on_connect_error(CyclTime now, const std::exception& e, const Endpoint& ep) when an attempt
+///   fails. A retry is scheduled after the call returns, unless stop(), connect() or reconnect()
+///   was called.
+template <typename DerivedT>
+class ReconnectingConnector : StreamConnector<ReconnectingConnector<DerivedT>> {
+    friend class StreamConnector<ReconnectingConnector<DerivedT>>;
+    using Base = StreamConnector<ReconnectingConnector<DerivedT>>;
+
+  public:
+    using Protocol = StreamProtocol;
+    using Endpoint = StreamEndpoint;
+
+    explicit ReconnectingConnector(Reactor& r, ReconnectPolicy policy = {})
+    : reactor_{r}
+    , policy_{policy}
+    , backoff_{policy.min_backoff}
+    {
+    }
+
+    // Copy.
+    ReconnectingConnector(const ReconnectingConnector&) = delete;
+    ReconnectingConnector& operator=(const ReconnectingConnector&) = delete;
+
+    // Move.
+    ReconnectingConnector(ReconnectingConnector&&) = delete;
+    ReconnectingConnector& operator=(ReconnectingConnector&&) = delete;
+
+    const ReconnectPolicy& policy() const noexcept { return policy_; }
+    const std::vector<Endpoint>& endpoints() const noexcept { return eps_; }
+    /// Returns the endpoint of the current or most recent connection attempt.
+    const Endpoint& endpoint() const noexcept
+    {
+        assert(!eps_.empty());
+        return eps_[idx_];
+    }
+    /// Returns true if a connection attempt or retry is pending.
+    bool connecting() const noexcept { return active_; }
+
+    /// Connects to the first endpoint that accepts a connection. The endpoints are typically those
+    /// returned by get_endpoints() for a Resolver result.
+    void connect(CyclTime now, std::vector<Endpoint> eps)
+    {
+        if (eps.empty()) {
+            throw std::invalid_argument{"no endpoints"};
+        }
+        stop();
+        eps_ = std::move(eps);
+        idx_ = 0;
+        backoff_ = policy_.min_backoff;
+        start(now);
+    }
+
+    /// Connects to a single endpoint.
+    void connect(CyclTime now, const Endpoint& ep) { connect(now, std::vector<Endpoint>{ep}); }
+
+    /// Reconnects after a connection has been lost, starting with the endpoint of the last
+    /// connection.
+    void reconnect(CyclTime now)
+    {
+        assert(!eps_.empty());
+        stop();
+        start(now);
+    }
+
+    /// Cancels any pending connection attempt or retry.
+    void stop() noexcept
+    {
+        active_ = false;
+        tmr_.reset();
+        Base::cancel();
+    }
+
+  protected:
+    ~ReconnectingConnector() = default;
+
+  private:
+    void start(CyclTime now)
+    {
+        active_ = true;
+        ++gen_;
+        first_idx_ = idx_;
+        attempt(now);
+    }
+    void attempt(CyclTime now)
+    {
+        try {
+            if (Base::connect(now, reactor_, eps_[idx_])) {
+                // Connected synchronously.
+                return;
+            }
+        } catch (const std::exception& e) {
+            on_sock_connect_error(now, e);
+            return;
+        }
+        if (!is_zero(policy_.connect_timeout)) {
+            tmr_ = reactor_.timer(now.mono_time() + policy_.connect_timeout, Priority::Low,
+                                  bind<&ReconnectingConnector::on_timeout_timer>(this));
+        }
+    }
+    void on_sock_prepare(CyclTime /*now*/, IoSock& sock)
+    {
+        if (!sock.is_ip_family()) {
+            return;
+        }
+        if (!is_zero(policy_.keep_idle)) {
+            set_so_keep_alive(sock.get(), true);
+            set_tcp_keep_idle(sock.get(), policy_.keep_idle);
+            set_tcp_keep_intvl(sock.get(), policy_.keep_intvl);
+            set_tcp_keep_cnt(sock.get(), policy_.keep_cnt);
+        }
+        if (!is_zero(policy_.user_timeout)) {
+            set_tcp_user_timeout(sock.get(), policy_.user_timeout);
+        }
+    }
+    void on_sock_connect(CyclTime now, IoSock&& sock, const Endpoint& ep)
+    {
+        active_ = false;
+        tmr_.reset();
+        backoff_ = policy_.min_backoff;
+        static_cast<DerivedT*>(this)->on_connect(now, std::move(sock), ep);
+    }
+    void on_sock_connect_error(CyclTime now, const std::exception& e)
+    {
+        tmr_.reset();
+        const auto ep = eps_[idx_];
+        idx_ = (idx_ + 1) % eps_.size();
+        const auto gen = gen_;
+        static_cast<DerivedT*>(this)->on_connect_error(now, e, ep);
+        if (!active_ || gen_ != gen) {
+            // Stopped or restarted by the callback.
+            return;
+        }
+        if (idx_ != first_idx_) {
+            // Fail over to the next endpoint immediately.
+            attempt(now);
+            return;
+        }
+        tmr_ = reactor_.timer(now.mono_time() + next_backoff(), Priority::Low,
+                              bind<&ReconnectingConnector::on_retry_timer>(this));
+    }
+    void on_timeout_timer(CyclTime now, Timer& /*tmr*/)
+    {
+        Base::cancel();
+        const std::system_error e{std::make_error_code(std::errc::timed_out), "connect"};
+        on_sock_connect_error(now, e);
+    }
+    void on_retry_timer(CyclTime now, Timer& /*tmr*/) { start(now); }
+    Duration next_backoff() noexcept
+    {
+        auto delay = backoff_;
+        backoff_ = std::min(std::chrono::duration_cast<Duration>(backoff_ * policy_.multiplier),
+                            policy_.max_backoff);
+        if (policy_.jitter > 0.0) {
+            const auto range = static_cast<std::int64_t>(delay.count() * policy_.jitter);
+            delay += Duration{randint<std::int64_t>(-range, range)};
+        }
+        return delay;
+    }
+
+    Reactor& reactor_;
+    const ReconnectPolicy policy_;
+    std::vector<Endpoint> eps_;
+    std::size_t idx_{0}, first_idx_{0};
+    /// Incremented each time that a sequence of attempts is started.
+    std::uint64_t gen_{0};
+    Duration backoff_;
+    Timer tmr_;
+    bool active_{false};
+};
+
+} // namespace net
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_RECONNECTINGCONNECTOR_HPP
@@ -0,0 +1,196 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ReconnectingConnector.hpp"
+
+#include "Endpoint.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+struct Connector : ReconnectingConnector<Connector> {
+    Connector(Reactor& r, ReconnectPolicy policy)
+    : ReconnectingConnector<Connector>{r, policy}
+    {
+    }
+    void on_connect(CyclTime /*now*/, IoSock&& sock, const Endpoint& ep)
+    {
+        this->sock = std::move(sock);
+        connected = ep;
+    }
+    void on_connect_error(CyclTime now, const std::exception& e, const Endpoint& ep)
+    {
+        const auto* se = dynamic_cast<const std::system_error*>(&e);
+        errors.push_back({now.mono_time(), se ? se->code() : error_code{}, ep});
+        if (errors.size() == max_errors) {
+            stop();
+        } else if (redirect) {
+            connect(now, *std::exchange(redirect, nullopt));
+        }
+    }
+    struct Error {
+        MonoTime time;
+        error_code code;
+        Endpoint ep;
+    };
+    IoSock sock;
+    Endpoint connected;
+    vector<Error> errors;
+    size_t max_errors{0};
+    optional<Endpoint> redirect;
+};
+
+// Returns a loopback endpoint that refuses connections.
+StreamEndpoint make_closed_endpoint()
+{
+    auto ep = parse_stream_endpoint("tcp4://127.0.0.1:0");
+    StreamSockServ sock{ep.protocol()};
+    sock.bind(ep);
+    sock.get_sock_name(ep);
+    return ep;
+}
+
+StreamSockServ make_listener(StreamEndpoint& ep, int backlog)
+{
+    ep = parse_stream_endpoint("tcp4://127.0.0.1:0");
+    StreamSockServ sock{ep.protocol()};
+    sock.bind(ep);
+    sock.listen(backlog);
+    sock.get_sock_name(ep);
+    return sock;
+}
+
+template <typename PredT>
+void poll_until(Reactor& r, PredT pred)
+{
+    const auto deadline = MonoClock::now() + 5s;
+    while (!pred() && MonoClock::now() < deadline) {
+        r.poll(CyclTime::now(), 1ms);
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ReconnectingConnectorSuite)
+
+BOOST_AUTO_TEST_CASE(ReconnectingConnectorFailoverCase)
+{
+    Reactor r;
+    const auto closed = make_closed_endpoint();
+    StreamEndpoint ep;
+    const auto serv = make_listener(ep, SOMAXCONN);
+
+    ReconnectPolicy policy;
+    policy.keep_idle = 10s;
+    policy.user_timeout = 1000ms;
+    Connector c{r, policy};
+    const auto start = MonoClock::now();
+    c.connect(CyclTime::now(), {closed, ep});
+    poll_until(r, [&c]() { return !c.connecting(); });
+
+    // No backoff between endpoints.
+    BOOST_CHECK_LT(MonoClock::now() - start, policy.min_backoff);
+    BOOST_REQUIRE_EQUAL(c.errors.size(), 1U);
+    BOOST_CHECK(c.errors[0].code == errc::connection_refused);
+    BOOST_CHECK(c.errors[0].ep == closed);
+    BOOST_CHECK(c.connected == ep);
+    BOOST_CHECK(c.sock);
+    BOOST_CHECK(c.endpoint() == ep);
+}
+
+BOOST_AUTO_TEST_CASE(ReconnectingConnectorBackoffCase)
+{
+    Reactor r;
+    const auto closed = make_closed_endpoint();
+
+    ReconnectPolicy policy;
+    policy.min_backoff = 10ms;
+    policy.max_backoff = 30ms;
+    policy.jitter = 0.0;
+    Connector c{r, policy};
+    c.max_errors = 4;
+    c.connect(CyclTime::now(), closed);
+    poll_until(r, [&c]() { return !c.connecting(); });
+
+    BOOST_REQUIRE_EQUAL(c.errors.size(), 4U);
+    BOOST_CHECK_GE(c.errors[1].time - c.errors[0].time, 10ms);
+    BOOST_CHECK_GE(c.errors[2].time - c.errors[1].time, 20ms);
+    // Capped at the maximum.
+    BOOST_CHECK_GE(c.errors[3].time - c.errors[2].time, 30ms);
+    BOOST_CHECK_LT(c.errors[3].time - c.errors[2].time, 60ms);
+    BOOST_CHECK(!c.sock);
+}
+
+BOOST_AUTO_TEST_CASE(ReconnectingConnectorRedirectCase)
+{
+    Reactor r;
+    const auto closed = make_closed_endpoint();
+    StreamEndpoint ep;
+    // Fill the accept queue, so that further connection requests are not answered.
+    const auto serv = make_listener(ep, 0);
+    StreamSockClnt clnt{ep.protocol()};
+    clnt.connect(ep);
+
+    ReconnectPolicy policy;
+    policy.connect_timeout = 100ms;
+    policy.min_backoff = 1s;
+    policy.jitter = 0.0;
+    Connector c{r, policy};
+    c.max_errors = 2;
+    // The callback starts a new attempt, which must not be replaced by a retry of the old one.
+    c.redirect = ep;
+    c.connect(CyclTime::now(), closed);
+    poll_until(r, [&c]() { return !c.connecting(); });
+
+    BOOST_REQUIRE_EQUAL(c.errors.size(), 2U);
+    BOOST_CHECK(c.errors[0].code == errc::connection_refused);
+    BOOST_CHECK(c.errors[1].code == errc::timed_out);
+    BOOST_CHECK(c.errors[1].ep == ep);
+    // Timed out by the new attempt, rather than after a retry.
+    BOOST_CHECK_GE(c.errors[1].time - c.errors[0].time, policy.connect_timeout);
+    BOOST_CHECK_LT(c.errors[1].time - c.errors[0].time, policy.min_backoff);
+}
+
+BOOST_AUTO_TEST_CASE(ReconnectingConnectorTimeoutCase)
+{
+    Reactor r;
+    StreamEndpoint ep;
+    // Fill the accept queue, so that further connection requests are not answered.
+    const auto serv = make_listener(ep, 0);
+    StreamSockClnt clnt{ep.protocol()};
+    clnt.connect(ep);
+
+    ReconnectPolicy policy;
+    policy.connect_timeout = 20ms;
+    Connector c{r, policy};
+    c.max_errors = 1;
+    c.connect(CyclTime::now(), ep);
+    poll_until(r, [&c]() { return !c.connecting(); });
+
+    BOOST_REQUIRE_EQUAL(c.errors.size(), 1U);
+    BOOST_CHECK(c.errors[0].code == errc::timed_out);
+    BOOST_CHECK(!c.sock);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,9 @@
 #include "Resolver.hpp"
 
 #include <toolbox/net/Endpoint.hpp>
+#include <toolbox/util/ThreadPool.hpp>
+
+#include <memory>
 
 namespace toolbox {
 inline namespace net {
@@ -41,9 +44,54 @@ AddrInfoFuture Resolver::resolve(std::string uri, int type)
 {
     Task task{[uri = std::move(uri), type]() -> AddrInfoPtr { return parse_endpoint(uri, type); }};
     auto future = task.get_future();
-    tq_.push(std::move(task));
+    if (!push(task)) {
+        std::promise<AddrInfoPtr> p;
+        p.set_exception(std::make_exception_ptr(cancelled()));
+        return p.get_future();
+    }
     return future;
 }
 
+void Resolver::resolve(std::string uri, int type, ResolveCallback cb)
+{
+    // The callback is shared with the task, so that it can be completed here if the task is
+    // rejected.
+    auto ptr = std::make_shared<ResolveCallback>(std::move(cb));
+    Task task{[uri = std::move(uri), type, ptr]() -> AddrInfoPtr {
+        AddrInfoPtr ai{nullptr, freeaddrinfo};
+        std::exception_ptr e;
+        try {
+            ai = parse_endpoint(uri, type);
+        } catch (...) {
+            e = std::current_exception();
+        }
+        (*ptr)(std::move(ai), e);
+        return {nullptr, freeaddrinfo};
+    }};
+    if (!push(task)) {
+        (*ptr)({nullptr, freeaddrinfo}, std::make_exception_ptr(cancelled()));
+    }
+}
+
+std::system_error Resolver::cancelled()
+{
+    return std::system_error{std::make_error_code(std::errc::operation_canceled), "resolve"};
+}
+
+bool Resolver::push(Task& task)
+{
+    if (pool_) {
+        // The task is only moved into the pool if it is accepted.
+        auto ptr = std::make_shared<Task>(std::move(task));
+        if (!pool_->submit([ptr]() { (*ptr)(); })) {
+            task = std::move(*ptr);
+            return false;
+        }
+    } else {
+        tq_.push(std::move(task));
+    }
+    return true;
+}
+
 } // namespace net
 } // namespace toolbox
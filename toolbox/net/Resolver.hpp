@@ -22,20 +22,35 @@
 #include <toolbox/util/TaskQueue.hpp>
 
 #include <cassert>
+#include <functional>
 #include <future>
+#include <system_error>
+#include <vector>
 
 namespace toolbox {
+inline namespace util {
+class ThreadPool;
+} // namespace util
 inline namespace net {
 
 using AddrInfoFuture = std::future<AddrInfoPtr>;
+/// Completion callback for a resolution. Either the result is set, or the exception is.
+using ResolveCallback = std::function<void(AddrInfoPtr&& ai, std::exception_ptr e)>;
 
 /// The Resolver is designed to resolve socket URIs to address endpoints on a background thread,
 /// which may include a DNS lookup depending on the URI.
+///
+/// Tasks are queued until a thread calls run(), unless the Resolver is constructed with a thread
+/// pool, in which case tasks are submitted to the pool and run(), stop() and clear() have no effect.
 class TOOLBOX_API Resolver {
     using Task = std::packaged_task<AddrInfoPtr()>;
 
   public:
     Resolver() = default;
+    explicit Resolver(ThreadPool& pool) noexcept
+    : pool_{&pool}
+    {
+    }
     ~Resolver() = default;
 
     // Copy.
@@ -57,10 +72,22 @@ class TOOLBOX_API Resolver {
     /// Clear task queue. Any pending tasks will be cancelled, resulting in a broken promise.
     void clear();
 
-    /// Schedule a URI socket name resolution.
+    /// Schedule a URI socket name resolution. The future holds an operation_canceled error if the
+    /// thread pool has been stopped.
     AddrInfoFuture resolve(std::string uri, int type);
 
+    /// Schedule a URI socket name resolution, and invoke the callback from the thread that calls
+    /// run() when it completes. The callback is not invoked if the task is cleared. If the thread
+    /// pool has been stopped, then the callback is invoked immediately with an operation_canceled
+    /// error.
+    void resolve(std::string uri, int type, ResolveCallback cb);
+
   private:
+    static std::system_error cancelled();
+    /// Returns false, leaving the task unchanged, if the thread pool rejected it.
+    bool push(Task& task);
+
+    ThreadPool* pool_{nullptr};
     TaskQueue<Task> tq_;
 };
 
@@ -73,6 +100,26 @@ EndpointT get_endpoint(AddrInfoFuture& future)
     return {ai->ai_addr, ai->ai_addrlen, ai->ai_protocol};
 }
 
+/// Convert each result to an endpoint, in the order returned by the resolver.
+template <typename EndpointT>
+std::vector<EndpointT> get_endpoints(const addrinfo* ai)
+{
+    std::vector<EndpointT> eps;
+    for (; ai; ai = ai->ai_next) {
+        eps.emplace_back(ai->ai_addr, ai->ai_addrlen, ai->ai_protocol);
+    }
+    return eps;
+}
+
+/// Wait for future and convert each result to an endpoint, in the order returned by the resolver.
+template <typename EndpointT>
+std::vector<EndpointT> get_endpoints(AddrInfoFuture& future)
+{
+    const auto ai = future.get();
+    assert(!future.valid());
+    return get_endpoints<EndpointT>(ai.get());
+}
+
 /// Returns true if future is ready.
 template <typename ResultT>
 bool is_ready(std::future<ResultT>& future)
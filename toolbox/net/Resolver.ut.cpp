@@ -19,10 +19,13 @@
 #include "Endpoint.hpp"
 
 #include <toolbox/sys/Runner.hpp>
+#include <toolbox/util/ThreadPool.hpp>
 #include <toolbox/util/String.hpp>
 
 #include <boost/test/unit_test.hpp>
 
+#include <future>
+
 using namespace std;
 using namespace toolbox;
 
@@ -56,6 +59,69 @@ BOOST_AUTO_TEST_CASE(ResolverCase)
     BOOST_CHECK_THROW(future6.get(), future_error);
 }
 
+BOOST_AUTO_TEST_CASE(GetEndpointsCase)
+{
+    Resolver res;
+    const auto uri = "tcp4://192.168.1.3:443"s;
+    auto future = res.resolve(uri, SOCK_STREAM);
+    BOOST_CHECK(res.run());
+    const auto eps = get_endpoints<StreamEndpoint>(future);
+    BOOST_REQUIRE(!eps.empty());
+    for (const auto& ep : eps) {
+        BOOST_CHECK_EQUAL(to_string(ep), uri);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ResolverThreadPoolCase)
+{
+    ThreadPool pool{2, "resolver"s};
+    Resolver res{pool};
+    const auto uri = "tcp4://192.168.1.3:443"s;
+    auto future1 = res.resolve(uri, SOCK_STREAM);
+    auto future2 = res.resolve("bad://foo", SOCK_STREAM);
+    BOOST_CHECK_EQUAL(to_string(*future1.get()), uri);
+    BOOST_CHECK_THROW(future2.get(), invalid_argument);
+
+    // Tasks are rejected once the pool is stopped.
+    pool.stop();
+    auto future3 = res.resolve(uri, SOCK_STREAM);
+    BOOST_CHECK_THROW(future3.get(), system_error);
+    // The callback is completed immediately.
+    error_code ec;
+    res.resolve(uri, SOCK_STREAM, [&ec](AddrInfoPtr&& /*ai*/, exception_ptr e) {
+        try {
+            rethrow_exception(e);
+        } catch (const system_error& ex) {
+            ec = ex.code();
+        }
+    });
+    BOOST_CHECK(ec == errc::operation_canceled);
+}
+
+BOOST_AUTO_TEST_CASE(ResolverThreadPoolStopCase)
+{
+    const auto uri = "tcp4://192.168.1.3:443"s;
+    string result;
+    {
+        ThreadPool pool{1, "resolver"s};
+        Resolver res{pool};
+        promise<void> started, release;
+        auto fut = release.get_future();
+        pool.submit([&]() {
+            started.set_value();
+            fut.wait();
+        });
+        started.get_future().wait();
+        // Queued behind the blocked task when the pool is stopped.
+        res.resolve(uri, SOCK_STREAM, [&result](AddrInfoPtr&& ai, exception_ptr /*e*/) {
+            result = ai ? to_string(*ai) : "";
+        });
+        pool.stop();
+        release.set_value();
+    }
+    BOOST_CHECK_EQUAL(result, uri);
+}
+
 BOOST_AUTO_TEST_CASE(ResolverRunnerCase)
 {
     Resolver res;
@@ -20,15 +20,32 @@
 #include <toolbox/net/Error.hpp>
 
 #include <toolbox/io/File.hpp>
+#include <toolbox/sys/Time.hpp>
 
 #include <net/if.h>
 #include <netdb.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <linux/errqueue.h>
 #include <linux/net_tstamp.h>
 
+#include <cstring>
+
 namespace toolbox {
 inline namespace net {
 using AddrInfoPtr = std::unique_ptr<addrinfo, void (*)(addrinfo*)>;
+
+/// Range of MSG_ZEROCOPY sends whose buffers have been released by the kernel.
+struct ZeroCopyCompletion {
+    /// First sequence number in the range. Each successful MSG_ZEROCOPY send is numbered in order,
+    /// starting from zero.
+    std::uint32_t lo{0};
+    /// Last sequence number in the range, inclusive.
+    std::uint32_t hi{0};
+    /// True if the kernel copied the data instead, for example, because the device does not
+    /// support scatter/gather. Zero-copy is then unlikely to be beneficial for this socket.
+    bool copied{false};
+};
 } // namespace net
 namespace os {
 
@@ -422,6 +439,27 @@ inline std::size_t recvmsg(int sockfd, msghdr& msg, int flags)
     return ret;
 }
 
+/// Receive multiple messages from a socket.
+inline int recvmmsg(int sockfd, mmsghdr* msgvec, unsigned vlen, int flags,
+                    std::error_code& ec) noexcept
+{
+    const auto ret = ::recvmmsg(sockfd, msgvec, vlen, flags, nullptr);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+    return ret;
+}
+
+/// Receive multiple messages from a socket.
+inline std::size_t recvmmsg(int sockfd, mmsghdr* msgvec, unsigned vlen, int flags)
+{
+    const auto ret = ::recvmmsg(sockfd, msgvec, vlen, flags, nullptr);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "recvmmsg"};
+    }
+    return ret;
+}
+
 /// Receive a message from a socket.
 inline ssize_t recvfrom(int sockfd, void* buf, std::size_t len, int flags, sockaddr& addr,
                         socklen_t& addrlen, std::error_code& ec) noexcept
@@ -574,6 +612,169 @@ inline std::size_t sendto(int sockfd, ConstBuffer buf, int flags, const Endpoint
                   ep.size());
 }
 
+/// Send multiple messages on a socket.
+inline int sendmmsg(int sockfd, mmsghdr* msgvec, unsigned vlen, int flags,
+                    std::error_code& ec) noexcept
+{
+    const auto ret = ::sendmmsg(sockfd, msgvec, vlen, flags);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+    return ret;
+}
+
+/// Send multiple messages on a socket.
+inline std::size_t sendmmsg(int sockfd, mmsghdr* msgvec, unsigned vlen, int flags)
+{
+    const auto ret = ::sendmmsg(sockfd, msgvec, vlen, flags);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "sendmmsg"};
+    }
+    return ret;
+}
+
+/// Send a message on a socket.
+inline ssize_t sendmsg(int sockfd, const msghdr& msg, int flags, std::error_code& ec) noexcept
+{
+    const auto ret = ::sendmsg(sockfd, &msg, flags);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+    return ret;
+}
+
+/// Send a message on a socket.
+inline std::size_t sendmsg(int sockfd, const msghdr& msg, int flags)
+{
+    const auto ret = ::sendmsg(sockfd, &msg, flags);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "sendmsg"};
+    }
+    return ret;
+}
+
+namespace detail {
+
+/// Message header for a single buffer with room for one control message of type T.
+template <typename T>
+struct CmsgMsg {
+    CmsgMsg(const void* data, std::size_t len, const void* name, socklen_t namelen) noexcept
+    {
+        iov.iov_base = const_cast<void*>(data);
+        iov.iov_len = len;
+        msg.msg_name = const_cast<void*>(name);
+        msg.msg_namelen = namelen;
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+    }
+    void set(int level, int type, T val) noexcept
+    {
+        auto* const cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = level;
+        cmsg->cmsg_type = type;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(T));
+        std::memcpy(CMSG_DATA(cmsg), &val, sizeof(T));
+    }
+    /// Returns true if the control data did not fit in the buffer.
+    bool truncated() const noexcept { return (msg.msg_flags & MSG_CTRUNC) != 0; }
+    /// Returns the value of the first control message of the given type, or the default value.
+    ///
+    /// Truncated control data is treated as missing, because the last message in the buffer may
+    /// be incomplete.
+    T get(int level, int type, T dflt) noexcept
+    {
+        if (truncated()) {
+            return dflt;
+        }
+        for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == level && cmsg->cmsg_type == type
+                && cmsg->cmsg_len >= CMSG_LEN(sizeof(T))) {
+                T val;
+                std::memcpy(&val, CMSG_DATA(cmsg), sizeof(T));
+                return val;
+            }
+        }
+        return dflt;
+    }
+    iovec iov{};
+    msghdr msg{};
+    union {
+        char buf[CMSG_SPACE(sizeof(T))];
+        cmsghdr align;
+    } control{};
+};
+
+} // namespace detail
+
+/// Send a buffer as a series of datagrams of segment_size bytes using UDP generic segmentation
+/// offload (GSO). The final datagram may be shorter. The kernel, or the NIC if it supports UDP
+/// segmentation offload, splits the buffer, so that a burst costs a single traversal of the stack.
+template <typename EndpointT>
+inline ssize_t sendto_gso(int sockfd, ConstBuffer buf, std::uint16_t segment_size, int flags,
+                          const EndpointT& ep, std::error_code& ec) noexcept
+{
+    detail::CmsgMsg<std::uint16_t> m{buf.data(), buf.size(), ep.data(),
+                                     static_cast<socklen_t>(ep.size())};
+    m.set(SOL_UDP, UDP_SEGMENT, segment_size);
+    return sendmsg(sockfd, m.msg, flags, ec);
+}
+
+/// Send a buffer as a series of datagrams of segment_size bytes using UDP generic segmentation
+/// offload (GSO).
+template <typename EndpointT>
+inline std::size_t sendto_gso(int sockfd, ConstBuffer buf, std::uint16_t segment_size, int flags,
+                              const EndpointT& ep)
+{
+    detail::CmsgMsg<std::uint16_t> m{buf.data(), buf.size(), ep.data(),
+                                     static_cast<socklen_t>(ep.size())};
+    m.set(SOL_UDP, UDP_SEGMENT, segment_size);
+    return sendmsg(sockfd, m.msg, flags);
+}
+
+/// Receive a datagram, or a series of datagrams coalesced by UDP generic receive offload (GRO).
+///
+/// On return, segment_size is the size of each coalesced datagram, except the last, which may be
+/// shorter. If the datagrams were not coalesced, then segment_size is the size of the datagram.
+/// GRO must be enabled on the socket with set_udp_gro(). There is only room for the UDP_GRO control
+/// message, so no other control messages should be enabled on the socket. If the control data is
+/// truncated, then the segment size is unknown, and the call fails with EMSGSIZE, because the
+/// datagrams cannot be separated. The coalesced datagrams are consumed in that case.
+template <typename EndpointT>
+inline ssize_t recvfrom_gro(int sockfd, MutableBuffer buf, int flags, EndpointT& ep,
+                            std::size_t& segment_size, std::error_code& ec) noexcept
+{
+    detail::CmsgMsg<int> m{buf.data(), buf.size(), ep.data(),
+                           static_cast<socklen_t>(ep.capacity())};
+    const auto ret = recvmsg(sockfd, m.msg, flags, ec);
+    if (ret >= 0) {
+        ep.resize(std::min<std::size_t>(m.msg.msg_namelen, ep.capacity()));
+        if (m.truncated()) {
+            ec = make_error(EMSGSIZE);
+            return -1;
+        }
+        segment_size = m.get(SOL_UDP, UDP_GRO, ret);
+    }
+    return ret;
+}
+
+/// Receive a datagram, or a series of datagrams coalesced by UDP generic receive offload (GRO).
+template <typename EndpointT>
+inline std::size_t recvfrom_gro(int sockfd, MutableBuffer buf, int flags, EndpointT& ep,
+                                std::size_t& segment_size)
+{
+    detail::CmsgMsg<int> m{buf.data(), buf.size(), ep.data(),
+                           static_cast<socklen_t>(ep.capacity())};
+    const auto ret = recvmsg(sockfd, m.msg, flags);
+    ep.resize(std::min<std::size_t>(m.msg.msg_namelen, ep.capacity()));
+    if (m.truncated()) {
+        throw std::system_error{make_error(EMSGSIZE), "recvmsg"};
+    }
+    segment_size = m.get(SOL_UDP, UDP_GRO, ret);
+    return ret;
+}
+
 /// Get the socket name.
 inline void getsockname(int sockfd, sockaddr& addr, socklen_t& addrlen,
                         std::error_code& ec) noexcept
@@ -649,6 +850,59 @@ inline void setsockopt(int sockfd, int level, int optname, const void* optval, s
     }
 }
 
+/// Read a MSG_ZEROCOPY completion from the socket's error queue without blocking.
+///
+/// Zero-copy must be enabled on the socket with SO_ZEROCOPY. Messages on the error queue that do not
+/// contain a zero-copy completion are skipped.
+///
+/// \return false if the error queue is empty.
+inline bool recv_zerocopy_completion(int sockfd, ZeroCopyCompletion& zc,
+                                     std::error_code& ec) noexcept
+{
+    for (;;) {
+        union {
+            char buf[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+            cmsghdr align;
+        } control;
+        msghdr msg{};
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        std::error_code recv_ec;
+        if (recvmsg(sockfd, msg, MSG_ERRQUEUE | MSG_DONTWAIT, recv_ec) < 0) {
+            if (recv_ec != std::errc::operation_would_block) {
+                ec = recv_ec;
+            }
+            return false;
+        }
+        for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+                || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+                sock_extended_err err;
+                std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+                if (err.ee_errno == 0 && err.ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+                    zc.lo = err.ee_info;
+                    zc.hi = err.ee_data;
+                    zc.copied = (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+                    return true;
+                }
+            }
+        }
+    }
+}
+
+/// Read a MSG_ZEROCOPY completion from the socket's error queue without blocking.
+///
+/// \return false if the error queue is empty.
+inline bool recv_zerocopy_completion(int sockfd, ZeroCopyCompletion& zc)
+{
+    std::error_code ec;
+    const auto ret = recv_zerocopy_completion(sockfd, zc, ec);
+    if (ec) {
+        throw std::system_error{ec, "recvmsg"};
+    }
+    return ret;
+}
+
 } // namespace os
 inline namespace net {
 
@@ -715,6 +969,24 @@ inline int get_so_snd_buf(int sockfd)
     return optval;
 }
 
+/// Returns the CPU on which the socket's most recent packets were processed by the network stack,
+/// or -1 if unknown.
+inline int get_so_incoming_cpu(int sockfd, std::error_code& ec) noexcept
+{
+    int optval{};
+    socklen_t optlen{sizeof(optval)};
+    os::getsockopt(sockfd, SOL_SOCKET, SO_INCOMING_CPU, &optval, optlen, ec);
+    return optval;
+}
+
+inline int get_so_incoming_cpu(int sockfd)
+{
+    int optval{};
+    socklen_t optlen{sizeof(optval)};
+    os::getsockopt(sockfd, SOL_SOCKET, SO_INCOMING_CPU, &optval, optlen);
+    return optval;
+}
+
 inline bool is_tcp_no_delay(int sockfd, std::error_code& ec) noexcept
 {
     int optval{};
@@ -731,6 +1003,75 @@ inline bool is_tcp_no_delay(int sockfd)
     return optval != 0;
 }
 
+/// Set the approximate time in microseconds to busy poll the device queue on a blocking receive
+/// when there is no data. Raising the value above net.core.busy_read requires CAP_NET_ADMIN.
+///
+/// \param sockfd The socket descriptor.
+/// \param usecs Busy poll time in microseconds, or zero to disable.
+/// \param ec Error-code set on failure.
+inline void set_so_busy_poll(int sockfd, int usecs, std::error_code& ec) noexcept
+{
+    os::setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL, &usecs, sizeof(usecs), ec);
+}
+
+/// Set the approximate time in microseconds to busy poll the device queue on a blocking receive
+/// when there is no data.
+///
+/// \param sockfd The socket descriptor.
+/// \param usecs Busy poll time in microseconds, or zero to disable.
+inline void set_so_busy_poll(int sockfd, int usecs)
+{
+    os::setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL, &usecs, sizeof(usecs));
+}
+
+/// Set the maximum number of packets processed by each busy poll of the device queue.
+inline void set_so_busy_poll_budget(int sockfd, int budget, std::error_code& ec) noexcept
+{
+    os::setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &budget, sizeof(budget), ec);
+}
+
+/// Set the maximum number of packets processed by each busy poll of the device queue.
+inline void set_so_busy_poll_budget(int sockfd, int budget)
+{
+    os::setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &budget, sizeof(budget));
+}
+
+/// Steer the socket's flows to the given CPU when it is one of a group of SO_REUSEPORT sockets.
+inline void set_so_incoming_cpu(int sockfd, int cpu, std::error_code& ec) noexcept
+{
+    os::setsockopt(sockfd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu), ec);
+}
+
+/// Steer the socket's flows to the given CPU when it is one of a group of SO_REUSEPORT sockets.
+inline void set_so_incoming_cpu(int sockfd, int cpu)
+{
+    os::setsockopt(sockfd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu));
+}
+
+/// Prefer busy polling over softirq processing of the device queue.
+///
+/// When enabled, and the device is configured to defer hard interrupts, device interrupts remain
+/// masked while the application keeps busy polling. Enabling requires CAP_NET_ADMIN.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+/// \param ec Error-code set on failure.
+inline void set_so_prefer_busy_poll(int sockfd, bool enabled, std::error_code& ec) noexcept
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &optval, sizeof(optval), ec);
+}
+
+/// Prefer busy polling over softirq processing of the device queue.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+inline void set_so_prefer_busy_poll(int sockfd, bool enabled)
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &optval, sizeof(optval));
+}
+
 inline void set_so_rcv_buf(int sockfd, int size, std::error_code& ec) noexcept
 {
     os::setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size), ec);
@@ -794,6 +1135,90 @@ inline void set_tcp_no_delay(int sockfd, bool enabled)
     os::setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(optval));
 }
 
+/// Enable or disable the sending of keepalive probes on a connection-oriented socket.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+/// \param ec Error-code set on failure.
+inline void set_so_keep_alive(int sockfd, bool enabled, std::error_code& ec) noexcept
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_KEEPALIVE, &optval, sizeof(optval), ec);
+}
+
+/// Enable or disable the sending of keepalive probes on a connection-oriented socket.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+inline void set_so_keep_alive(int sockfd, bool enabled)
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_KEEPALIVE, &optval, sizeof(optval));
+}
+
+/// Set the time that a connection must be idle before TCP starts sending keepalive probes.
+inline void set_tcp_keep_idle(int sockfd, Seconds idle, std::error_code& ec) noexcept
+{
+    int optval{static_cast<int>(idle.count())};
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPIDLE, &optval, sizeof(optval), ec);
+}
+
+/// Set the time that a connection must be idle before TCP starts sending keepalive probes.
+inline void set_tcp_keep_idle(int sockfd, Seconds idle)
+{
+    int optval{static_cast<int>(idle.count())};
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPIDLE, &optval, sizeof(optval));
+}
+
+/// Set the time between individual keepalive probes.
+inline void set_tcp_keep_intvl(int sockfd, Seconds intvl, std::error_code& ec) noexcept
+{
+    int optval{static_cast<int>(intvl.count())};
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPINTVL, &optval, sizeof(optval), ec);
+}
+
+/// Set the time between individual keepalive probes.
+inline void set_tcp_keep_intvl(int sockfd, Seconds intvl)
+{
+    int optval{static_cast<int>(intvl.count())};
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPINTVL, &optval, sizeof(optval));
+}
+
+/// Set the number of unanswered keepalive probes after which the connection is dropped.
+inline void set_tcp_keep_cnt(int sockfd, int cnt, std::error_code& ec) noexcept
+{
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt), ec);
+}
+
+/// Set the number of unanswered keepalive probes after which the connection is dropped.
+inline void set_tcp_keep_cnt(int sockfd, int cnt)
+{
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt));
+}
+
+/// Set the maximum time that transmitted data may remain unacknowledged, or that buffered data may
+/// remain untransmitted due to a zero window, before the connection is forcibly closed.
+///
+/// \param sockfd The socket descriptor.
+/// \param timeout The timeout, or zero to use the system default.
+/// \param ec Error-code set on failure.
+inline void set_tcp_user_timeout(int sockfd, Millis timeout, std::error_code& ec) noexcept
+{
+    unsigned optval{static_cast<unsigned>(timeout.count())};
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_USER_TIMEOUT, &optval, sizeof(optval), ec);
+}
+
+/// Set the maximum time that transmitted data may remain unacknowledged, or that buffered data may
+/// remain untransmitted due to a zero window, before the connection is forcibly closed.
+///
+/// \param sockfd The socket descriptor.
+/// \param timeout The timeout, or zero to use the system default.
+inline void set_tcp_user_timeout(int sockfd, Millis timeout)
+{
+    unsigned optval{static_cast<unsigned>(timeout.count())};
+    os::setsockopt(sockfd, IPPROTO_TCP, TCP_USER_TIMEOUT, &optval, sizeof(optval));
+}
+
 /// Set the number of SYN retransmits that TCP should send before aborting the attempt to connect.
 ///
 /// The number of retransmits cannot exceed 255.
@@ -827,6 +1252,99 @@ inline void set_so_timestamping(int sockfd, int flags)
     os::setsockopt(sockfd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
 }
 
+/// Enable or disable nanosecond software receive timestamps.
+///
+/// When enabled, each received message carries an SCM_TIMESTAMPNS control message. SO_TIMESTAMPING
+/// is preferred where hardware or transmit timestamps are also required.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+/// \param ec Error-code set on failure.
+inline void set_so_timestampns(int sockfd, bool enabled, std::error_code& ec) noexcept
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_TIMESTAMPNS, &optval, sizeof(optval), ec);
+}
+
+/// Enable or disable nanosecond software receive timestamps.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+inline void set_so_timestampns(int sockfd, bool enabled)
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_TIMESTAMPNS, &optval, sizeof(optval));
+}
+
+/// Enable or disable the MSG_ZEROCOPY send flag on the socket.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+/// \param ec Error-code set on failure.
+inline void set_so_zerocopy(int sockfd, bool enabled, std::error_code& ec) noexcept
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval), ec);
+}
+
+/// Enable or disable the MSG_ZEROCOPY send flag on the socket.
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+inline void set_so_zerocopy(int sockfd, bool enabled)
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval));
+}
+
+/// Set the default segment size for UDP generic segmentation offload (GSO).
+///
+/// Sends of buffers larger than size are split into datagrams of size bytes. A size of zero
+/// disables segmentation.
+///
+/// \param sockfd The socket descriptor.
+/// \param size The segment size.
+/// \param ec Error-code set on failure.
+inline void set_udp_segment(int sockfd, std::uint16_t size, std::error_code& ec) noexcept
+{
+    int optval{size};
+    os::setsockopt(sockfd, SOL_UDP, UDP_SEGMENT, &optval, sizeof(optval), ec);
+}
+
+/// Set the default segment size for UDP generic segmentation offload (GSO).
+///
+/// \param sockfd The socket descriptor.
+/// \param size The segment size.
+inline void set_udp_segment(int sockfd, std::uint16_t size)
+{
+    int optval{size};
+    os::setsockopt(sockfd, SOL_UDP, UDP_SEGMENT, &optval, sizeof(optval));
+}
+
+/// Enable or disable UDP generic receive offload (GRO).
+///
+/// When enabled, consecutive same-sized datagrams from the same flow may be coalesced into a single
+/// buffer, which is received with recvfrom_gro().
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+/// \param ec Error-code set on failure.
+inline void set_udp_gro(int sockfd, bool enabled, std::error_code& ec) noexcept
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_UDP, UDP_GRO, &optval, sizeof(optval), ec);
+}
+
+/// Enable or disable UDP generic receive offload (GRO).
+///
+/// \param sockfd The socket descriptor.
+/// \param enabled Boolean switch to enable or disable.
+inline void set_udp_gro(int sockfd, bool enabled)
+{
+    int optval{enabled ? 1 : 0};
+    os::setsockopt(sockfd, SOL_UDP, UDP_GRO, &optval, sizeof(optval));
+}
+
 inline int get_so_timestamping(int sockfd, std::error_code& ec) noexcept
 {
     int optval{};
@@ -873,6 +1391,12 @@ struct Sock : FileHandle {
     }
     int get_snd_buf() const { return toolbox::get_so_snd_buf(get()); }
 
+    int get_incoming_cpu(std::error_code& ec) const noexcept
+    {
+        return toolbox::get_so_incoming_cpu(get(), ec);
+    }
+    int get_incoming_cpu() const { return toolbox::get_so_incoming_cpu(get()); }
+
     bool is_tcp_no_delay(std::error_code& ec) const noexcept
     {
         return toolbox::is_tcp_no_delay(get(), ec);
@@ -883,6 +1407,30 @@ struct Sock : FileHandle {
     void set_non_block(std::error_code& ec) noexcept { toolbox::set_non_block(get(), ec); }
     void set_non_block() { toolbox::set_non_block(get()); }
 
+    void set_busy_poll(int usecs, std::error_code& ec) noexcept
+    {
+        toolbox::set_so_busy_poll(get(), usecs, ec);
+    }
+    void set_busy_poll(int usecs) { toolbox::set_so_busy_poll(get(), usecs); }
+
+    void set_busy_poll_budget(int budget, std::error_code& ec) noexcept
+    {
+        toolbox::set_so_busy_poll_budget(get(), budget, ec);
+    }
+    void set_busy_poll_budget(int budget) { toolbox::set_so_busy_poll_budget(get(), budget); }
+
+    void set_incoming_cpu(int cpu, std::error_code& ec) noexcept
+    {
+        toolbox::set_so_incoming_cpu(get(), cpu, ec);
+    }
+    void set_incoming_cpu(int cpu) { toolbox::set_so_incoming_cpu(get(), cpu); }
+
+    void set_prefer_busy_poll(bool enabled, std::error_code& ec) noexcept
+    {
+        toolbox::set_so_prefer_busy_poll(get(), enabled, ec);
+    }
+    void set_prefer_busy_poll(bool enabled) { toolbox::set_so_prefer_busy_poll(get(), enabled); }
+
     void set_rcv_buf(int size, std::error_code& ec) noexcept
     {
         toolbox::set_so_rcv_buf(get(), size, ec);
@@ -901,6 +1449,12 @@ struct Sock : FileHandle {
     }
     void set_snd_buf(int size) { toolbox::set_so_snd_buf(get(), size); }
 
+    void set_zerocopy(bool enabled, std::error_code& ec) noexcept
+    {
+        toolbox::set_so_zerocopy(get(), enabled, ec);
+    }
+    void set_zerocopy(bool enabled) { toolbox::set_so_zerocopy(get(), enabled); }
+
     void enable_hardware_rcv_timestamps()
     {
         int flags = get_so_timestamping(get());
@@ -937,6 +1491,59 @@ struct Sock : FileHandle {
         }
     }
 
+    void enable_software_rcv_timestamps()
+    {
+        int flags = get_so_timestamping(get());
+        flags |= SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        set_so_timestamping(get(), flags);
+    }
+
+    void enable_software_rcv_timestamps(std::error_code& ec) noexcept
+    {
+        if (int flags = get_so_timestamping(get(), ec); !ec) {
+            flags |= SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+            set_so_timestamping(get(), flags, ec);
+        }
+    }
+
+    /// Enable software transmit timestamps, which are read from the error queue. Each timestamp is
+    /// tagged with the sequence number of the datagram, and the payload is not looped back.
+    void enable_software_snd_timestamps()
+    {
+        int flags = get_so_timestamping(get());
+        flags |= SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE
+            | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+        set_so_timestamping(get(), flags);
+    }
+
+    void enable_software_snd_timestamps(std::error_code& ec) noexcept
+    {
+        if (int flags = get_so_timestamping(get(), ec); !ec) {
+            flags |= SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE
+                | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+            set_so_timestamping(get(), flags, ec);
+        }
+    }
+
+    /// Enable NIC transmit timestamps, which are read from the error queue. The NIC must also be
+    /// configured for hardware timestamping with the SIOCSHWTSTAMP ioctl.
+    void enable_hardware_snd_timestamps()
+    {
+        int flags = get_so_timestamping(get());
+        flags |= SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE
+            | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+        set_so_timestamping(get(), flags);
+    }
+
+    void enable_hardware_snd_timestamps(std::error_code& ec) noexcept
+    {
+        if (int flags = get_so_timestamping(get(), ec); !ec) {
+            flags |= SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE
+                | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+            set_so_timestamping(get(), flags, ec);
+        }
+    }
+
   private:
     int family_{};
 };
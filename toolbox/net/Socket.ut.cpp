@@ -79,4 +79,23 @@ BOOST_AUTO_TEST_CASE(AbstractUnixSocketCase)
     BOOST_CHECK_EQUAL(msg_sent, msg_recv);
 }
 
+BOOST_AUTO_TEST_CASE(BusyPollOptionsCase)
+{
+    FileHandle sock;
+    BOOST_REQUIRE_NO_THROW(sock = os::socket(AF_INET, SOCK_DGRAM, 0));
+
+    // Unknown until packets have been processed.
+    BOOST_CHECK_EQUAL(get_so_incoming_cpu(sock.get()), -1);
+    BOOST_CHECK_NO_THROW(set_so_incoming_cpu(sock.get(), 0));
+    BOOST_CHECK_EQUAL(get_so_incoming_cpu(sock.get()), 0);
+
+    // Disabling is always permitted.
+    BOOST_CHECK_NO_THROW(set_so_busy_poll(sock.get(), 0));
+    BOOST_CHECK_NO_THROW(set_so_prefer_busy_poll(sock.get(), false));
+
+    error_code ec;
+    set_so_busy_poll(sock.get(), -1, ec);
+    BOOST_CHECK(ec == errc::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -71,6 +71,16 @@ class StreamConnector {
         return true;
     }
 
+    /// Returns true if a connection is pending asynchronous completion.
+    bool connecting() const noexcept { return static_cast<bool>(sub_); }
+
+    /// Abandons a connection that is pending asynchronous completion. No callback is made for it.
+    void cancel() noexcept
+    {
+        sub_.reset();
+        sock_.reset();
+    }
+
   protected:
     ~StreamConnector() = default;
 
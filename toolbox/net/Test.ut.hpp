@@ -0,0 +1,39 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_TEST_UT_HPP
+#define TOOLBOX_NET_TEST_UT_HPP
+
+#include <toolbox/net/DgramSock.hpp>
+
+namespace toolbox {
+inline namespace net {
+namespace test {
+
+/// Returns a socket bound to an ephemeral loopback port.
+inline DgramSock make_bound_sock(DgramEndpoint& ep)
+{
+    ep = parse_dgram_endpoint("udp4://127.0.0.1:0");
+    DgramSock sock{ep.protocol()};
+    sock.bind(ep);
+    sock.get_sock_name(ep);
+    return sock;
+}
+
+} // namespace test
+} // namespace net
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_TEST_UT_HPP
@@ -0,0 +1,102 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Timestamp.hpp"
+
+#include <cstring>
+
+namespace toolbox {
+inline namespace net {
+using namespace std;
+namespace {
+
+template <typename T>
+T get_cmsg_data(const cmsghdr* cmsg) noexcept
+{
+    T val;
+    memcpy(&val, CMSG_DATA(cmsg), sizeof(val));
+    return val;
+}
+
+} // namespace
+
+PacketTimestamps get_timestamps(msghdr& msg) noexcept
+{
+    PacketTimestamps ts;
+    if (msg.msg_flags & MSG_CTRUNC) {
+        // The last message in the buffer may be incomplete.
+        return ts;
+    }
+    for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            // Index 0 is the software timestamp, index 1 is deprecated, and index 2 is the raw
+            // hardware timestamp.
+            const auto tss = get_cmsg_data<scm_timestamping>(cmsg);
+            if (!is_zero(tss.ts[0])) {
+                ts.software = to_time<WallClock>(tss.ts[0]);
+            }
+            if (!is_zero(tss.ts[2])) {
+                ts.hardware = to_time<WallClock>(tss.ts[2]);
+            }
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            ts.software = to_time<WallClock>(get_cmsg_data<timespec>(cmsg));
+        }
+    }
+    return ts;
+}
+
+bool get_tx_timestamp(msghdr& msg, TxTimestamp& tx) noexcept
+{
+    bool has_err{false};
+    for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+            || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+            const auto err = get_cmsg_data<sock_extended_err>(cmsg);
+            if (err.ee_errno == ENOMSG && err.ee_origin == SO_EE_ORIGIN_TIMESTAMPING) {
+                tx.id = err.ee_data;
+                tx.type = err.ee_info;
+                has_err = true;
+            }
+        }
+    }
+    if (!has_err) {
+        return false;
+    }
+    tx.ts = get_timestamps(msg);
+    return bool{tx.ts};
+}
+
+int get_sock_error(msghdr& msg) noexcept
+{
+    if (msg.msg_flags & MSG_CTRUNC) {
+        return 0;
+    }
+    for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+            || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+            const auto err = get_cmsg_data<sock_extended_err>(cmsg);
+            if (err.ee_errno != 0 && err.ee_origin != SO_EE_ORIGIN_TIMESTAMPING) {
+                return static_cast<int>(err.ee_errno);
+            }
+        }
+    }
+    return 0;
+}
+
+} // namespace net
+} // namespace toolbox
@@ -0,0 +1,164 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_NET_TIMESTAMP_HPP
+#define TOOLBOX_NET_TIMESTAMP_HPP
+
+#include <toolbox/net/Socket.hpp>
+#include <toolbox/sys/Time.hpp>
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+
+namespace toolbox {
+inline namespace net {
+
+/// Packet timestamps extracted from the ancillary data of a message.
+struct PacketTimestamps {
+    /// Kernel software timestamp, or zero if not available.
+    WallTime software{};
+    /// Raw NIC hardware timestamp, or zero if not available.
+    WallTime hardware{};
+
+    explicit operator bool() const noexcept
+    {
+        return software != WallTime{} || hardware != WallTime{};
+    }
+    /// Returns the hardware timestamp if available, otherwise the software timestamp.
+    WallTime best() const noexcept { return hardware != WallTime{} ? hardware : software; }
+};
+
+/// Transmit timestamp read from a socket's error queue.
+struct TxTimestamp {
+    /// Sequence number of the datagram, counting from zero, when SOF_TIMESTAMPING_OPT_ID is set.
+    std::uint32_t id{0};
+    /// Point in the transmit path: SCM_TSTAMP_SCHED, SCM_TSTAMP_SND or SCM_TSTAMP_ACK.
+    std::uint32_t type{0};
+    PacketTimestamps ts;
+};
+
+/// Control buffer with space for the timestamp and extended error messages.
+union TimestampControl {
+    char buf[CMSG_SPACE(sizeof(scm_timestamping)) + CMSG_SPACE(sizeof(timespec))
+             + CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    cmsghdr align;
+};
+
+/// Returns the receive timestamps from the ancillary data of a message. Both SCM_TIMESTAMPING and
+/// SCM_TIMESTAMPNS messages are recognised. No timestamps are returned if the ancillary data was
+/// truncated.
+TOOLBOX_API PacketTimestamps get_timestamps(msghdr& msg) noexcept;
+
+/// Extracts a transmit timestamp from a message read from the error queue.
+///
+/// \return false if the message does not contain a transmit timestamp.
+TOOLBOX_API bool get_tx_timestamp(msghdr& msg, TxTimestamp& tx) noexcept;
+
+/// Returns the error number of an extended error, such as an ICMP error, in a message read from
+/// the error queue, or zero if the message does not contain one. Timestamps are not errors.
+TOOLBOX_API int get_sock_error(msghdr& msg) noexcept;
+
+} // namespace net
+namespace os {
+
+/// Receive a datagram together with its receive timestamps.
+///
+/// Timestamps must be enabled on the socket with SO_TIMESTAMPING or SO_TIMESTAMPNS, otherwise they
+/// are zero.
+template <typename EndpointT>
+inline ssize_t recvfrom(int sockfd, MutableBuffer buf, int flags, EndpointT& ep,
+                        PacketTimestamps& ts, std::error_code& ec) noexcept
+{
+    iovec iov{buf.data(), buf.size()};
+    TimestampControl control;
+    msghdr msg{};
+    msg.msg_name = ep.data();
+    msg.msg_namelen = ep.capacity();
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    const auto ret = recvmsg(sockfd, msg, flags, ec);
+    if (ret >= 0) {
+        ep.resize(std::min<std::size_t>(msg.msg_namelen, ep.capacity()));
+        ts = get_timestamps(msg);
+    }
+    return ret;
+}
+
+/// Receive a datagram together with its receive timestamps.
+template <typename EndpointT>
+inline std::size_t recvfrom(int sockfd, MutableBuffer buf, int flags, EndpointT& ep,
+                            PacketTimestamps& ts)
+{
+    std::error_code ec;
+    const auto ret = recvfrom(sockfd, buf, flags, ep, ts, ec);
+    if (ec) {
+        throw std::system_error{ec, "recvmsg"};
+    }
+    return ret;
+}
+
+/// Read a transmit timestamp from the socket's error queue without blocking.
+///
+/// Transmit timestamps must be enabled on the socket with SO_TIMESTAMPING. Any other message on the
+/// error queue is consumed and reported in ec, so that it is not lost: an extended error, such as
+/// an ICMP error, is reported with its error number, and any other message with EBADMSG.
+///
+/// \return false if the error queue is empty, or if the next message is not a transmit timestamp.
+inline bool recv_tx_timestamp(int sockfd, TxTimestamp& tx, std::error_code& ec) noexcept
+{
+    // Enough for the payload of a looped-back datagram if SOF_TIMESTAMPING_OPT_TSONLY is not set;
+    // the payload is otherwise discarded.
+    char data[64];
+    iovec iov{data, sizeof(data)};
+    TimestampControl control;
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    std::error_code recv_ec;
+    if (recvmsg(sockfd, msg, MSG_ERRQUEUE | MSG_DONTWAIT, recv_ec) < 0) {
+        if (recv_ec != std::errc::operation_would_block) {
+            ec = recv_ec;
+        }
+        return false;
+    }
+    if (get_tx_timestamp(msg, tx)) {
+        return true;
+    }
+    const auto err = get_sock_error(msg);
+    ec = make_error(err != 0 ? err : EBADMSG);
+    return false;
+}
+
+/// Read a transmit timestamp from the socket's error queue without blocking.
+///
+/// \return false if the error queue is empty.
+inline bool recv_tx_timestamp(int sockfd, TxTimestamp& tx)
+{
+    std::error_code ec;
+    const auto ret = recv_tx_timestamp(sockfd, tx, ec);
+    if (ec) {
+        throw std::system_error{ec, "recvmsg"};
+    }
+    return ret;
+}
+
+} // namespace os
+} // namespace toolbox
+
+#endif // TOOLBOX_NET_TIMESTAMP_HPP
@@ -0,0 +1,169 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Timestamp.hpp"
+
+#include "DgramSock.hpp"
+#include "Test.ut.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace std;
+using namespace toolbox;
+using toolbox::test::make_bound_sock;
+
+namespace {
+
+// Sends a datagram and receives it with its timestamps. The kernel enables receive timestamps
+// asynchronously, so the send is retried until a datagram arrives with a software timestamp.
+WallTime send_timestamped(DgramSock& tx, DgramSock& rx, const DgramEndpoint& rx_ep,
+                          DgramEndpoint& ep, PacketTimestamps& ts)
+{
+    WallTime before;
+    for (int i{0}; i < 100; ++i) {
+        before = WallClock::now();
+        tx.sendto({"foo", 3}, 0, rx_ep);
+        char buf[16];
+        BOOST_CHECK_EQUAL(rx.recvfrom({buf, sizeof(buf)}, MSG_DONTWAIT, ep, ts), 3U);
+        if (ts.software != WallTime{}) {
+            break;
+        }
+        this_thread::sleep_for(1ms);
+    }
+    return before;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(TimestampSuite)
+
+BOOST_AUTO_TEST_CASE(PacketTimestampsCase)
+{
+    PacketTimestamps ts;
+    BOOST_CHECK(!ts);
+    BOOST_CHECK(ts.best() == WallTime{});
+
+    ts.software = WallTime{1s};
+    BOOST_CHECK(ts);
+    BOOST_CHECK(ts.best() == WallTime{1s});
+
+    ts.hardware = WallTime{2s};
+    BOOST_CHECK(ts.best() == WallTime{2s});
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedTimestampCase)
+{
+    TimestampControl control{};
+    msghdr msg{};
+    msg.msg_control = control.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(timespec));
+    auto* const cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_TIMESTAMPNS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(timespec));
+    const timespec t{1, 0};
+    memcpy(CMSG_DATA(cmsg), &t, sizeof(t));
+    BOOST_CHECK(get_timestamps(msg).software == WallTime{1s});
+
+    // Truncated control data is ignored.
+    msg.msg_flags = MSG_CTRUNC;
+    BOOST_CHECK(!get_timestamps(msg));
+}
+
+BOOST_AUTO_TEST_CASE(SoftwareRcvTimestampCase)
+{
+    DgramEndpoint rx_ep, tx_ep;
+    auto rx = make_bound_sock(rx_ep);
+    auto tx = make_bound_sock(tx_ep);
+    rx.enable_software_rcv_timestamps();
+
+    DgramEndpoint ep;
+    PacketTimestamps ts;
+    const auto before = send_timestamped(tx, rx, rx_ep, ep, ts);
+    BOOST_CHECK(ep == tx_ep);
+    BOOST_CHECK(ts.software >= before);
+    BOOST_CHECK(ts.software <= WallClock::now());
+    // Loopback has no hardware timestamps.
+    BOOST_CHECK(ts.hardware == WallTime{});
+    BOOST_CHECK(ts.best() == ts.software);
+}
+
+BOOST_AUTO_TEST_CASE(TimestampNsCase)
+{
+    DgramEndpoint rx_ep, tx_ep;
+    auto rx = make_bound_sock(rx_ep);
+    auto tx = make_bound_sock(tx_ep);
+    set_so_timestampns(rx.get(), true);
+
+    DgramEndpoint ep;
+    PacketTimestamps ts;
+    const auto before = send_timestamped(tx, rx, rx_ep, ep, ts);
+    BOOST_CHECK(ts.software >= before);
+    BOOST_CHECK(ts.software <= WallClock::now());
+}
+
+BOOST_AUTO_TEST_CASE(SoftwareSndTimestampCase)
+{
+    DgramEndpoint rx_ep, tx_ep;
+    auto rx = make_bound_sock(rx_ep);
+    auto tx = make_bound_sock(tx_ep);
+    tx.enable_software_snd_timestamps();
+
+    TxTimestamp tt;
+    BOOST_CHECK(!tx.recv_tx_timestamp(tt));
+
+    const auto before = WallClock::now();
+    tx.sendto({"foo", 3}, 0, rx_ep);
+    tx.sendto({"bar", 3}, 0, rx_ep);
+
+    BOOST_CHECK(tx.recv_tx_timestamp(tt));
+    BOOST_CHECK_EQUAL(tt.id, 0U);
+    BOOST_CHECK_EQUAL(tt.type, static_cast<uint32_t>(SCM_TSTAMP_SND));
+    BOOST_CHECK(tt.ts.software >= before);
+    BOOST_CHECK(tt.ts.software <= WallClock::now());
+
+    BOOST_CHECK(tx.recv_tx_timestamp(tt));
+    BOOST_CHECK_EQUAL(tt.id, 1U);
+    BOOST_CHECK(!tx.recv_tx_timestamp(tt));
+}
+
+BOOST_AUTO_TEST_CASE(TxTimestampErrorCase)
+{
+    // Nothing is bound to the destination port once the socket is closed.
+    DgramEndpoint rx_ep, tx_ep;
+    make_bound_sock(rx_ep);
+    auto tx = make_bound_sock(tx_ep);
+    int optval{1};
+    os::setsockopt(tx.get(), SOL_IP, IP_RECVERR, &optval, sizeof(optval));
+    tx.enable_software_snd_timestamps();
+
+    tx.sendto({"foo", 3}, 0, rx_ep);
+    TxTimestamp tt;
+    BOOST_CHECK(tx.recv_tx_timestamp(tt));
+
+    // The ICMP port unreachable error is reported rather than skipped.
+    error_code ec;
+    BOOST_CHECK(!tx.recv_tx_timestamp(tt, ec));
+    BOOST_CHECK(ec == errc::connection_refused);
+    ec.clear();
+    BOOST_CHECK(!tx.recv_tx_timestamp(tt, ec));
+    BOOST_CHECK(!ec);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
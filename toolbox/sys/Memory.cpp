@@ -0,0 +1,68 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Memory.hpp"
+
+#include <toolbox/sys/Limits.hpp>
+
+#include <alloca.h>
+
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+namespace toolbox {
+inline namespace sys {
+using namespace std;
+
+PageFaults page_faults(int who)
+{
+    rusage ru;
+    os::getrusage(who, ru);
+    return {.minor = ru.ru_minflt, .major = ru.ru_majflt};
+}
+
+void prefault(void* addr, size_t len) noexcept
+{
+    if (len == 0) {
+        return;
+    }
+    const auto begin = reinterpret_cast<uintptr_t>(addr) & ~(PageSize - 1);
+    const auto end = reinterpret_cast<uintptr_t>(addr) + len;
+    error_code ec;
+    os::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_POPULATE_WRITE, ec);
+    if (!ec) {
+        return;
+    }
+    // MADV_POPULATE_WRITE requires Linux 5.14. Otherwise, write each page back to itself.
+    auto* const p = static_cast<volatile char*>(addr);
+    for (size_t i{0}; i < len; i += PageSize) {
+        p[i] = p[i];
+    }
+    p[len - 1] = p[len - 1];
+}
+
+void prefault_stack(size_t size) noexcept
+{
+    // Touch from the top down, which is the order in which the stack grows.
+    auto* const p = static_cast<volatile char*>(alloca(size));
+    for (size_t i{size}; i >= PageSize; i -= PageSize) {
+        p[i - 1] = 0;
+    }
+    p[0] = 0;
+}
+
+} // namespace sys
+} // namespace toolbox
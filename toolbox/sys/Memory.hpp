@@ -0,0 +1,164 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_SYS_MEMORY_HPP
+#define TOOLBOX_SYS_MEMORY_HPP
+
+#include <toolbox/sys/Error.hpp>
+
+#include <toolbox/Config.h>
+
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+namespace toolbox {
+namespace os {
+
+/// Lock all pages mapped into the address space of the calling process.
+inline void mlockall(int flags, std::error_code& ec) noexcept
+{
+    const auto ret = ::mlockall(flags);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+}
+
+/// Lock all pages mapped into the address space of the calling process.
+inline void mlockall(int flags)
+{
+    const auto ret = ::mlockall(flags);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "mlockall"};
+    }
+}
+
+/// Unlock all pages mapped into the address space of the calling process.
+inline void munlockall(std::error_code& ec) noexcept
+{
+    const auto ret = ::munlockall();
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+}
+
+/// Unlock all pages mapped into the address space of the calling process.
+inline void munlockall()
+{
+    const auto ret = ::munlockall();
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "munlockall"};
+    }
+}
+
+/// Map files or devices into memory.
+inline void* mmap(void* addr, std::size_t len, int prot, int flags, int fd, off_t offset,
+                  std::error_code& ec) noexcept
+{
+    void* const ret{::mmap(addr, len, prot, flags, fd, offset)};
+    if (ret == MAP_FAILED) {
+        ec = make_error(errno);
+    }
+    return ret;
+}
+
+/// Map files or devices into memory.
+inline void* mmap(void* addr, std::size_t len, int prot, int flags, int fd, off_t offset)
+{
+    void* const ret{::mmap(addr, len, prot, flags, fd, offset)};
+    if (ret == MAP_FAILED) {
+        throw std::system_error{make_error(errno), "mmap"};
+    }
+    return ret;
+}
+
+/// Unmap files or devices from memory.
+inline void munmap(void* addr, std::size_t len, std::error_code& ec) noexcept
+{
+    const auto ret = ::munmap(addr, len);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+}
+
+/// Unmap files or devices from memory.
+inline void munmap(void* addr, std::size_t len)
+{
+    const auto ret = ::munmap(addr, len);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "munmap"};
+    }
+}
+
+/// Give advice about use of memory.
+inline void madvise(void* addr, std::size_t len, int advice, std::error_code& ec) noexcept
+{
+    const auto ret = ::madvise(addr, len, advice);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+}
+
+/// Give advice about use of memory.
+inline void madvise(void* addr, std::size_t len, int advice)
+{
+    const auto ret = ::madvise(addr, len, advice);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "madvise"};
+    }
+}
+
+/// Get resource usage.
+inline void getrusage(int who, rusage& ru, std::error_code& ec) noexcept
+{
+    const auto ret = ::getrusage(who, &ru);
+    if (ret < 0) {
+        ec = make_error(errno);
+    }
+}
+
+/// Get resource usage.
+inline void getrusage(int who, rusage& ru)
+{
+    const auto ret = ::getrusage(who, &ru);
+    if (ret < 0) {
+        throw std::system_error{make_error(errno), "getrusage"};
+    }
+}
+
+} // namespace os
+inline namespace sys {
+
+struct PageFaults {
+    /// Faults serviced without I/O.
+    long minor{0};
+    /// Faults that required I/O.
+    long major{0};
+};
+
+/// Returns the page-fault counts for the calling thread (RUSAGE_THREAD), or for the process
+/// (RUSAGE_SELF).
+TOOLBOX_API PageFaults page_faults(int who = RUSAGE_THREAD);
+
+/// Faults-in each page of the range for writing, so that subsequent accesses do not incur page
+/// faults. The contents of the range are unchanged.
+TOOLBOX_API void prefault(void* addr, std::size_t len) noexcept;
+
+/// Faults-in size bytes of the calling thread's stack, below the caller's frame.
+TOOLBOX_API void prefault_stack(std::size_t size) noexcept;
+
+} // namespace sys
+} // namespace toolbox
+
+#endif // TOOLBOX_SYS_MEMORY_HPP
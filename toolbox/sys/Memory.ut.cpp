@@ -0,0 +1,114 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Memory.hpp"
+
+#include "Limits.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+
+#include <alloca.h>
+#include <pthread.h>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+struct Mapping {
+    explicit Mapping(size_t len)
+    : len{len}
+    , addr{mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)}
+    {
+        BOOST_REQUIRE(addr != MAP_FAILED);
+    }
+    ~Mapping() { munmap(addr, len); }
+    const size_t len;
+    void* const addr;
+};
+
+long write_faults(const Mapping& m)
+{
+    const auto before = page_faults();
+    memset(m.addr, 1, m.len);
+    return page_faults().minor - before.minor;
+}
+
+constexpr size_t StackPages{64};
+
+[[gnu::noinline]] long stack_write_faults()
+{
+    const auto before = page_faults();
+    auto* const p = static_cast<char*>(alloca(StackPages * PageSize));
+    memset(p, 1, StackPages * PageSize);
+    asm volatile("" : : "r"(p) : "memory");
+    return page_faults().minor - before.minor;
+}
+
+/// Returns the page faults incurred by writing to the stack of a new thread. The stack is mapped
+/// afresh, so that it is not warmed by previous threads.
+long thread_stack_write_faults(bool warm)
+{
+    const Mapping stack{2 * StackPages * PageSize};
+    struct Args {
+        bool warm;
+        long faults;
+    } args{warm, 0};
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack.addr, stack.len);
+    pthread_t tid;
+    const auto ret = pthread_create(
+        &tid, &attr,
+        [](void* arg) -> void* {
+            auto& args = *static_cast<Args*>(arg);
+            if (args.warm) {
+                prefault_stack(StackPages * PageSize);
+            }
+            args.faults = stack_write_faults();
+            return nullptr;
+        },
+        &args);
+    pthread_attr_destroy(&attr);
+    BOOST_REQUIRE_EQUAL(ret, 0);
+    pthread_join(tid, nullptr);
+    return args.faults;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(MemorySuite)
+
+BOOST_AUTO_TEST_CASE(PrefaultCase)
+{
+    constexpr size_t Pages{64};
+    const Mapping cold{Pages * PageSize};
+    BOOST_CHECK_GE(write_faults(cold), static_cast<long>(Pages) / 2);
+
+    const Mapping warm{Pages * PageSize};
+    prefault(warm.addr, warm.len);
+    BOOST_CHECK_LT(write_faults(warm), static_cast<long>(Pages) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(PrefaultStackCase)
+{
+    constexpr auto Pages = static_cast<long>(StackPages);
+    BOOST_CHECK_GE(thread_stack_write_faults(false), Pages / 2);
+    BOOST_CHECK_LT(thread_stack_write_faults(true), Pages / 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
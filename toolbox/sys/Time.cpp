@@ -16,6 +16,13 @@
 
 #include "Time.hpp"
 
+#include <limits>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
 namespace toolbox {
 inline namespace sys {
 using namespace std;
@@ -30,7 +37,83 @@ NanoTime get_time(clockid_t clock_id) noexcept
     return NanoTime{ts.tv_sec * 1'000'000'000LL + ts.tv_nsec};
 }
 
+namespace {
+
+struct Sample {
+    uint64_t tsc;
+    Duration mono;
+};
+
+// Reads the TSC and MonoClock as close together as possible by taking the reading with the
+// narrowest TSC window around the clock_gettime() call.
+Sample sample_tsc() noexcept
+{
+    Sample best{};
+    auto best_width = numeric_limits<uint64_t>::max();
+    for (int i{0}; i < 16; ++i) {
+        const auto t0 = rdtsc_ordered();
+        const auto mono = MonoClock::now().time_since_epoch();
+        const auto t1 = rdtsc_ordered();
+        if (t1 - t0 < best_width) {
+            best_width = t1 - t0;
+            best = {t0 + (t1 - t0) / 2, mono};
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+TscClock::Params TscClock::params_;
+
+bool TscClock::is_invariant() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    // Advanced Power Management Information: EDX bit 8 indicates an invariant TSC.
+    return (edx & (1U << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool TscClock::calibrate(Duration interval) noexcept
+{
+    if (!is_invariant()) {
+        params_ = {};
+        return false;
+    }
+    const auto s0 = sample_tsc();
+    this_thread::sleep_for(interval);
+    const auto s1 = sample_tsc();
+    const auto ticks = s1.tsc - s0.tsc;
+    const auto ns = (s1.mono - s0.mono).count();
+    if (ticks == 0 || ns <= 0) {
+        params_ = {};
+        return false;
+    }
+    Params params;
+    params.tsc = s1.tsc;
+    params.mono = s1.mono;
+    params.wall_offset = WallClock::now().time_since_epoch() - MonoClock::now().time_since_epoch();
+    params.mult = static_cast<uint64_t>((static_cast<unsigned __int128>(ns) << Shift) / ticks);
+    params_ = params;
+    return true;
+}
+
+double TscClock::frequency() noexcept
+{
+    if (params_.mult == 0) {
+        return 0.0;
+    }
+    return 1e9 * static_cast<double>(uint64_t{1} << Shift) / static_cast<double>(params_.mult);
+}
+
 thread_local CyclTime::Time CyclTime::time_;
+bool CyclTime::use_tsc_{false};
 
 } // namespace sys
 } // namespace toolbox
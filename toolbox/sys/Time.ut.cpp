@@ -155,5 +155,32 @@ BOOST_AUTO_TEST_CASE(ThrottledInvokerCheck)
     BOOST_CHECK_EQUAL(count, 3);
 }
 
+BOOST_AUTO_TEST_CASE(TscClockCase)
+{
+    if (!TscClock::calibrate(5ms)) {
+        BOOST_TEST_MESSAGE("invariant tsc not available");
+        BOOST_CHECK(!TscClock::is_calibrated());
+        // Falls back to MonoClock.
+        BOOST_CHECK(TscClock::now() <= MonoClock::now());
+        return;
+    }
+    BOOST_CHECK(TscClock::is_calibrated());
+    BOOST_CHECK_GT(TscClock::frequency(), 0.0);
+
+    const auto t0 = TscClock::now();
+    const auto m = MonoClock::now();
+    const auto t1 = TscClock::now();
+    BOOST_CHECK_LE(t0, t1);
+    // Calibration error over a short interval should be well within a millisecond.
+    BOOST_CHECK_LT(abs((m - t0).count()), Nanos{1ms}.count());
+    BOOST_CHECK_LT(abs((TscClock::wall_now() - WallClock::now()).count()), Nanos{1ms}.count());
+
+    // One second's worth of ticks.
+    const auto ticks = static_cast<int64_t>(TscClock::frequency());
+    BOOST_CHECK_LT(abs((TscClock::to_duration(ticks) - 1s).count()), Nanos{1us}.count());
+    // A counter that is behind the calibration point, such as on a skewed core, yields a negative
+    // duration rather than wrapping.
+    BOOST_CHECK_LT(abs((TscClock::to_duration(-ticks) + 1s).count()), Nanos{1us}.count());
+}
 
 BOOST_AUTO_TEST_SUITE_END()
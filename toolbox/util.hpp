@@ -19,8 +19,10 @@
 
 #include "util/Alarm.hpp"
 #include "util/Allocator.hpp"
+#include "util/Arena.hpp"
 #include "util/Argv.hpp"
 #include "util/Array.hpp"
+#include "util/BroadcastRing.hpp"
 #include "util/Concepts.hpp"
 #include "util/Config.hpp"
 #include "util/Enum.hpp"
@@ -28,11 +30,15 @@
 #include "util/Finally.hpp"
 #include "util/IntTypes.hpp"
 #include "util/Math.hpp"
+#include "util/MpmcRing.hpp"
+#include "util/ObjectPool.hpp"
 #include "util/Options.hpp"
 #include "util/RefCount.hpp"
 #include "util/RingBuffer.hpp"
 #include "util/RobinHood.hpp"
+#include "util/Slab.hpp"
 #include "util/Slot.hpp"
+#include "util/SpscRing.hpp"
 #include "util/Storage.hpp"
 #include "util/Stream.hpp"
 #include "util/StreamInserter.hpp"
@@ -40,6 +46,7 @@
 #include "util/StringBuf.hpp"
 #include "util/Struct.hpp"
 #include "util/TaskQueue.hpp"
+#include "util/ThreadPool.hpp"
 #include "util/Tokeniser.hpp"
 #include "util/Traits.hpp"
 #include "util/Trans.hpp"
@@ -48,5 +55,6 @@
 #include "util/VarSub.hpp"
 #include "util/Variant.hpp"
 #include "util/Version.hpp"
+#include "util/WorkDeque.hpp"
 
 #endif // TOOLBOX_UTIL_HPP
@@ -16,6 +16,10 @@
 
 #include "Allocator.hpp"
 
+#if TOOLBOX_USE_SLAB_ALLOCATOR
+#include "Slab.hpp"
+#endif
+
 namespace toolbox {
 using namespace std;
 
@@ -24,12 +28,18 @@ TOOLBOX_WEAK void deallocate(void* ptr, size_t size) noexcept;
 
 void* allocate(size_t size)
 {
+#if TOOLBOX_USE_SLAB_ALLOCATOR
+    return slab_allocate(size);
+#else
     return ::operator new(size);
+#endif
 }
 
 void deallocate(void* ptr, [[maybe_unused]] size_t size) noexcept
 {
-#if __cpp_sized_deallocation
+#if TOOLBOX_USE_SLAB_ALLOCATOR
+    slab_deallocate(ptr, size);
+#elif __cpp_sized_deallocation
     ::operator delete(ptr, size);
 #else
     ::operator delete(ptr);
@@ -0,0 +1,85 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Arena.hpp"
+
+#include <algorithm>
+
+namespace toolbox {
+inline namespace util {
+using namespace std;
+
+Arena::Arena(size_t block_size, pmr::memory_resource* upstream)
+: block_size_{block_size}
+, upstream_{upstream}
+{
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+void Arena::reset() noexcept
+{
+    used_ = 0;
+    if (head_) {
+        set_block(head_);
+    }
+}
+
+void Arena::release() noexcept
+{
+    for (auto* block = head_; block;) {
+        auto* const next = block->next;
+        upstream_->deallocate(block, block->size, alignof(Block));
+        block = next;
+    }
+    head_ = block_ = nullptr;
+    begin_ = ptr_ = end_ = 0;
+    used_ = capacity_ = 0;
+}
+
+void* Arena::allocate_slow(size_t size, size_t align)
+{
+    const size_t need{sizeof(Block) + size + align - 1};
+    // Move to the next retained block that is large enough, if any.
+    Block** link{block_ ? &block_->next : &head_};
+    while (*link && (*link)->size < need) {
+        link = &(*link)->next;
+    }
+    if (!*link) {
+        const size_t block_size{max(block_size_, need)};
+        auto* const block = static_cast<Block*>(upstream_->allocate(block_size, alignof(Block)));
+        *block = {nullptr, block_size};
+        *link = block;
+        capacity_ += block_size;
+    }
+    if (block_) {
+        used_ += ptr_ - begin_;
+    }
+    set_block(*link);
+    return allocate(size, align);
+}
+
+void Arena::set_block(Block* block) noexcept
+{
+    block_ = block;
+    begin_ = ptr_ = reinterpret_cast<uintptr_t>(block + 1);
+    end_ = reinterpret_cast<uintptr_t>(block) + block->size;
+}
+
+} // namespace util
+} // namespace toolbox
@@ -0,0 +1,140 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_ARENA_HPP
+#define TOOLBOX_UTIL_ARENA_HPP
+
+#include <toolbox/Config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace toolbox {
+inline namespace util {
+
+/// Bump allocator with chained blocks.
+///
+/// Deallocation is a no-op. Memory is reclaimed all at once by reset(), which rewinds the arena to
+/// its first block. Blocks are retained for reuse, so that an arena that is reset periodically
+/// stops allocating from upstream once it has grown to its high-water mark.
+///
+/// The arena is a std::pmr::memory_resource, so that it can be used with pmr containers. Calls
+/// made directly on the arena, or through ArenaAllocator, bypass virtual dispatch.
+class TOOLBOX_API Arena : public std::pmr::memory_resource {
+  public:
+    explicit Arena(std::size_t block_size = 64 * 1024,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~Arena() override;
+
+    // Copy.
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Move.
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    std::size_t block_size() const noexcept { return block_size_; }
+    /// Returns the number of bytes allocated since the last reset, including alignment padding.
+    std::size_t size() const noexcept { return used_ + (ptr_ - begin_); }
+    /// Returns the total size of the blocks held by the arena.
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t))
+    {
+        // Zero-sized allocations must still return a unique, non-null pointer, which a fresh arena
+        // with no current block would not.
+        size += size == 0;
+        const auto p = (ptr_ + align - 1) & ~(align - 1);
+        if (p + size <= end_) [[likely]] {
+            ptr_ = p + size;
+            return reinterpret_cast<void*>(p);
+        }
+        return allocate_slow(size, align);
+    }
+    void deallocate(void* /*ptr*/, std::size_t /*size*/,
+                    std::size_t /*align*/ = alignof(std::max_align_t)) noexcept
+    {
+    }
+
+    /// Rewinds the arena. All memory previously allocated from the arena is invalidated.
+    void reset() noexcept;
+    /// Returns all blocks to the upstream resource.
+    void release() noexcept;
+
+  private:
+    struct Block {
+        Block* next;
+        std::size_t size;
+    };
+    void* allocate_slow(std::size_t size, std::size_t align);
+    void set_block(Block* block) noexcept;
+
+    void* do_allocate(std::size_t size, std::size_t align) final { return allocate(size, align); }
+    void do_deallocate(void* /*ptr*/, std::size_t /*size*/, std::size_t /*align*/) final {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final
+    {
+        return this == &other;
+    }
+
+    const std::size_t block_size_;
+    std::pmr::memory_resource* const upstream_;
+    Block* head_{nullptr};
+    Block* block_{nullptr};
+    std::uintptr_t begin_{0}, ptr_{0}, end_{0};
+    // Bytes allocated from blocks before the current one.
+    std::size_t used_{0};
+    std::size_t capacity_{0};
+};
+
+/// Allocator that allocates from an Arena without virtual dispatch.
+template <typename ValueT>
+class ArenaAllocator {
+  public:
+    using value_type = ValueT;
+
+    ArenaAllocator(Arena& arena) noexcept // NOLINT(hicpp-explicit-conversions)
+    : arena_{&arena}
+    {
+    }
+    template <typename OtherT>
+    ArenaAllocator(const ArenaAllocator<OtherT>& other) noexcept // NOLINT
+    : arena_{&other.arena()}
+    {
+    }
+
+    Arena& arena() const noexcept { return *arena_; }
+
+    ValueT* allocate(std::size_t n)
+    {
+        return static_cast<ValueT*>(arena_->allocate(n * sizeof(ValueT), alignof(ValueT)));
+    }
+    void deallocate(ValueT* /*ptr*/, std::size_t /*n*/) noexcept {}
+
+    template <typename OtherT>
+    bool operator==(const ArenaAllocator<OtherT>& rhs) const noexcept
+    {
+        return arena_ == &rhs.arena();
+    }
+
+  private:
+    Arena* arena_;
+};
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_ARENA_HPP
@@ -0,0 +1,96 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Arena.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(ArenaSuite)
+
+BOOST_AUTO_TEST_CASE(ArenaAllocateCase)
+{
+    Arena arena{1024};
+    BOOST_CHECK_EQUAL(arena.size(), 0U);
+    BOOST_CHECK_EQUAL(arena.capacity(), 0U);
+
+    auto* const p1 = static_cast<char*>(arena.allocate(1, 1));
+    auto* const p2 = static_cast<char*>(arena.allocate(8, 8));
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p2) % 8, 0U);
+    BOOST_CHECK(p2 > p1);
+    auto* const p3 = arena.allocate(16, 64);
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p3) % 64, 0U);
+    BOOST_CHECK_EQUAL(arena.capacity(), 1024U);
+
+    // Chain a new block.
+    arena.allocate(1000, 1);
+    BOOST_CHECK_EQUAL(arena.capacity(), 2048U);
+    // Larger than the block size.
+    arena.allocate(4096);
+    BOOST_CHECK_GT(arena.capacity(), 2048U + 4096U);
+    BOOST_CHECK_GE(arena.size(), 1000U + 4096U);
+
+    // Blocks are retained and reused after a reset.
+    const auto capacity = arena.capacity();
+    arena.reset();
+    BOOST_CHECK_EQUAL(arena.size(), 0U);
+    BOOST_CHECK_EQUAL(arena.allocate(1, 1), p1);
+    arena.allocate(1000, 1);
+    arena.allocate(4096);
+    BOOST_CHECK_EQUAL(arena.capacity(), capacity);
+
+    arena.release();
+    BOOST_CHECK_EQUAL(arena.capacity(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(ArenaZeroSizeCase)
+{
+    Arena arena{1024};
+    // A fresh arena has no current block.
+    auto* const p1 = arena.allocate(0);
+    BOOST_CHECK(p1 != nullptr);
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p1) % alignof(max_align_t), 0U);
+    BOOST_CHECK(arena.allocate(0) != p1);
+}
+
+BOOST_AUTO_TEST_CASE(ArenaContainerCase)
+{
+    Arena arena{256};
+    {
+        pmr::vector<pmr::string> v{&arena};
+        for (int i{0}; i < 100; ++i) {
+            v.emplace_back(to_string(i) + " is a number that does not fit in the small buffer");
+        }
+        BOOST_CHECK_EQUAL(v.back(), "99 is a number that does not fit in the small buffer");
+    }
+    {
+        vector<int, ArenaAllocator<int>> v{arena};
+        for (int i{0}; i < 100; ++i) {
+            v.push_back(i);
+        }
+        BOOST_CHECK_EQUAL(v[99], 99);
+        BOOST_CHECK(v.get_allocator() == ArenaAllocator<char>{arena});
+    }
+    BOOST_CHECK_GT(arena.size(), 100 * sizeof(int));
+    BOOST_CHECK(arena.is_equal(arena));
+    BOOST_CHECK(!arena.is_equal(*pmr::new_delete_resource()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,199 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_BROADCASTRING_HPP
+#define TOOLBOX_UTIL_BROADCASTRING_HPP
+
+#include <toolbox/sys/Limits.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace toolbox {
+inline namespace util {
+
+/// Single-writer, multi-reader ring for fanning-out messages to many threads.
+///
+/// The writer never waits for readers: each message is assigned a sequence number, and slow
+/// readers that are lapped by the writer detect the overrun and skip ahead. Each slot is protected
+/// by a sequence lock, so readers do not write to shared memory and do not contend with one
+/// another.
+template <typename ValueT>
+class alignas(CacheLineSize) BroadcastRing {
+    static_assert(std::is_trivially_copyable_v<ValueT>);
+
+  public:
+    enum class Status { Ok, Empty, Overrun };
+
+    class Reader {
+      public:
+        /// Readers start at the writer's current position.
+        explicit Reader(const BroadcastRing& ring) noexcept
+        : ring_{&ring}
+        , seq_{ring.head()}
+        {
+        }
+
+        /// Returns the sequence number of the next message to be read.
+        std::uint64_t sequence() const noexcept { return seq_; }
+        /// Returns the number of messages that were skipped due to overruns.
+        std::uint64_t dropped() const noexcept { return dropped_; }
+
+        /// Reads the next message into val. If the reader has been lapped by the writer, then the
+        /// reader skips to the oldest message still available and Overrun is returned.
+        Status read(ValueT& val) noexcept
+        {
+            const auto status = ring_->read(seq_, val);
+            if (status == Status::Ok) {
+                ++seq_;
+            } else if (status == Status::Overrun) {
+                skip();
+            }
+            return status;
+        }
+        /// Reads up to n messages into vals, and returns the number read. Reading stops at the
+        /// first message that is not available. Overruns are handled as for read(), and are
+        /// reflected in dropped().
+        std::size_t pop_n(ValueT* vals, std::size_t n) noexcept
+        {
+            std::size_t i{0};
+            while (i < n && read(vals[i]) == Status::Ok) {
+                ++i;
+            }
+            return i;
+        }
+        /// Reads the next message and, if successful, invokes fn with a reference to it. The
+        /// message is copied out of the slot before fn is invoked, because the writer may overwrite
+        /// the slot at any time.
+        template <typename FnT>
+        Status try_read(FnT fn) noexcept(noexcept(fn(std::declval<const ValueT&>())))
+        {
+            ValueT val;
+            const auto status = read(val);
+            if (status == Status::Ok) {
+                fn(std::as_const(val));
+            }
+            return status;
+        }
+
+      private:
+        void skip() noexcept
+        {
+            // The slot after the writer's position is the next to be overwritten.
+            const auto seq = ring_->head() - ring_->capacity() + 1;
+            dropped_ += seq - seq_;
+            seq_ = seq;
+        }
+
+        const BroadcastRing* ring_;
+        std::uint64_t seq_;
+        std::uint64_t dropped_{0};
+    };
+
+    explicit BroadcastRing(std::size_t capacity)
+    : capacity_{next_pow2(capacity)}
+    , mask_{capacity_ - 1}
+    , slots_{new Slot[capacity_]{}}
+    {
+    }
+    ~BroadcastRing() = default;
+
+    // Copy.
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    // Move.
+    BroadcastRing(BroadcastRing&&) = delete;
+    BroadcastRing& operator=(BroadcastRing&&) = delete;
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    /// Returns the sequence number of the next message to be written.
+    std::uint64_t head() const noexcept { return wpos_.load(std::memory_order_acquire); }
+    Reader reader() const noexcept { return Reader{*this}; }
+
+    /// Writer. Returns the sequence number of the message.
+    std::uint64_t push(const ValueT& val) noexcept
+    {
+        return write([&val](ValueT& ref) { ref = val; });
+    }
+    /// Writer. Pushes n messages, and returns the sequence number of the first. Each message is
+    /// published as soon as its slot is written, so that a reader lapped part way through a batch
+    /// skips to a position that accounts for the messages already overwritten.
+    std::uint64_t push_n(const ValueT* vals, std::size_t n) noexcept
+    {
+        const auto first = wpos_.load(std::memory_order_relaxed);
+        for (std::size_t i{0}; i < n; ++i) {
+            write_slot(first + i, [&val = vals[i]](ValueT& ref) { ref = val; });
+            wpos_.store(first + i + 1, std::memory_order_release);
+        }
+        return first;
+    }
+    /// Writer. Invokes fn with a reference to the next slot, so that the message can be written in
+    /// place. The message is published when fn returns. Returns the sequence number of the message.
+    template <typename FnT>
+    std::uint64_t write(FnT fn) noexcept
+    {
+        const auto seq = wpos_.load(std::memory_order_relaxed);
+        write_slot(seq, fn);
+        wpos_.store(seq + 1, std::memory_order_release);
+        return seq;
+    }
+
+  private:
+    template <typename FnT>
+    void write_slot(std::uint64_t seq, FnT&& fn) noexcept
+    {
+        auto& slot = slots_[seq & mask_];
+        // An odd value marks the slot as being written.
+        slot.seq.store(seq * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fn(slot.value);
+        slot.seq.store(seq * 2 + 2, std::memory_order_release);
+    }
+    Status read(std::uint64_t seq, ValueT& val) const noexcept
+    {
+        const auto& slot = slots_[seq & mask_];
+        const auto expect = seq * 2 + 2;
+        const auto before = slot.seq.load(std::memory_order_acquire);
+        if (before < expect) {
+            return Status::Empty;
+        }
+        if (before > expect) {
+            return Status::Overrun;
+        }
+        std::memcpy(&val, &slot.value, sizeof(ValueT));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto after = slot.seq.load(std::memory_order_relaxed);
+        return after == before ? Status::Ok : Status::Overrun;
+    }
+
+    struct Slot {
+        std::atomic<std::uint64_t> seq;
+        ValueT value;
+    };
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    const std::unique_ptr<Slot[]> slots_;
+    alignas(CacheLineSize) std::atomic<std::uint64_t> wpos_{0};
+};
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_BROADCASTRING_HPP
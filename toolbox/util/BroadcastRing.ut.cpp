@@ -0,0 +1,177 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "BroadcastRing.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+struct Tick {
+    uint64_t seq;
+    uint64_t check;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(BroadcastRingSuite)
+
+BOOST_AUTO_TEST_CASE(BroadcastRingCase)
+{
+    BroadcastRing<int> rb{4};
+    auto r1 = rb.reader();
+    BOOST_CHECK_EQUAL(rb.push(1), 0U);
+    BOOST_CHECK_EQUAL(rb.write([](int& ref) { ref = 2; }), 1U);
+    // Readers start at the head.
+    auto r2 = rb.reader();
+    BOOST_CHECK_EQUAL(r2.sequence(), 2U);
+
+    int val{0};
+    BOOST_CHECK(r1.read(val) == BroadcastRing<int>::Status::Ok);
+    BOOST_CHECK_EQUAL(val, 1);
+    BOOST_CHECK(r2.read(val) == BroadcastRing<int>::Status::Empty);
+
+    for (int i{3}; i <= 6; ++i) {
+        rb.push(i);
+    }
+    BOOST_CHECK(r2.read(val) == BroadcastRing<int>::Status::Ok);
+    BOOST_CHECK_EQUAL(val, 3);
+    rb.push(7);
+    rb.push(8);
+
+    // Lapped by the writer.
+    BOOST_CHECK(r1.read(val) == BroadcastRing<int>::Status::Overrun);
+    BOOST_CHECK_EQUAL(r1.sequence(), 5U);
+    BOOST_CHECK_EQUAL(r1.dropped(), 4U);
+    for (int i{6}; i <= 8; ++i) {
+        BOOST_CHECK(r1.read(val) == BroadcastRing<int>::Status::Ok);
+        BOOST_CHECK_EQUAL(val, i);
+    }
+    BOOST_CHECK(r1.read(val) == BroadcastRing<int>::Status::Empty);
+}
+
+BOOST_AUTO_TEST_CASE(BroadcastRingBatchCase)
+{
+    BroadcastRing<int> rb{8};
+    auto r = rb.reader();
+    const int in[]{1, 2, 3, 4, 5};
+    BOOST_CHECK_EQUAL(rb.push_n(in, 3), 0U);
+    BOOST_CHECK_EQUAL(rb.push_n(in + 3, 2), 3U);
+    BOOST_CHECK_EQUAL(rb.head(), 5U);
+
+    int out[8]{};
+    BOOST_CHECK_EQUAL(r.pop_n(out, 2), 2U);
+    BOOST_CHECK_EQUAL(out[0], 1);
+    BOOST_CHECK_EQUAL(out[1], 2);
+
+    int val{0};
+    BOOST_CHECK(r.try_read([&val](const int& ref) { val = ref; })
+                == BroadcastRing<int>::Status::Ok);
+    BOOST_CHECK_EQUAL(val, 3);
+
+    // Stops at the writer's position.
+    BOOST_CHECK_EQUAL(r.pop_n(out, 8), 2U);
+    BOOST_CHECK_EQUAL(out[0], 4);
+    BOOST_CHECK_EQUAL(out[1], 5);
+    BOOST_CHECK(r.try_read([](const int&) {}) == BroadcastRing<int>::Status::Empty);
+}
+
+BOOST_AUTO_TEST_CASE(BroadcastRingThreadCase)
+{
+    constexpr uint64_t N{200'000};
+    BroadcastRing<Tick> rb{64};
+    atomic<int> ready{0};
+    atomic<bool> torn{false};
+
+    vector<thread> readers;
+    for (int t{0}; t < 2; ++t) {
+        readers.emplace_back([&]() {
+            auto r = rb.reader();
+            ready.fetch_add(1);
+            Tick tick;
+            uint64_t last{0};
+            while (last + 1 < N) {
+                if (r.read(tick) == BroadcastRing<Tick>::Status::Ok) {
+                    // Messages are never torn, and sequences are increasing.
+                    if (tick.check != ~tick.seq || (last > 0 && tick.seq <= last)) {
+                        torn = true;
+                    }
+                    last = tick.seq;
+                } else {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    while (ready.load() < 2) {
+        this_thread::yield();
+    }
+    for (uint64_t i{0}; i < N; ++i) {
+        rb.write([i](Tick& ref) {
+            ref.seq = i;
+            ref.check = ~i;
+        });
+    }
+    for (auto& t : readers) {
+        t.join();
+    }
+    BOOST_CHECK(!torn);
+}
+
+BOOST_AUTO_TEST_CASE(BroadcastRingBatchThreadCase)
+{
+    constexpr uint64_t N{200'000}, Batch{100};
+    BroadcastRing<Tick> rb{64};
+    atomic<bool> ready{false}, backwards{false};
+
+    thread reader{[&]() {
+        auto r = rb.reader();
+        ready = true;
+        Tick tick;
+        uint64_t last{0};
+        while (last + 1 < N) {
+            const auto seq = r.sequence();
+            if (r.read(tick) == BroadcastRing<Tick>::Status::Ok) {
+                last = tick.seq;
+            } else {
+                this_thread::yield();
+            }
+            // A lapped reader never moves backwards, even when a batch is larger than the ring.
+            if (r.sequence() < seq || r.dropped() > N) {
+                backwards = true;
+            }
+        }
+    }};
+    while (!ready.load()) {
+        this_thread::yield();
+    }
+    vector<Tick> ticks(Batch);
+    for (uint64_t i{0}; i < N; i += Batch) {
+        for (uint64_t j{0}; j < Batch; ++j) {
+            ticks[j] = {i + j, ~(i + j)};
+        }
+        rb.push_n(ticks.data(), Batch);
+    }
+    reader.join();
+    BOOST_CHECK(!backwards);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,162 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_MPMCRING_HPP
+#define TOOLBOX_UTIL_MPMCRING_HPP
+
+#include <toolbox/sys/Limits.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace toolbox {
+inline namespace util {
+
+/// Bounded, lock-free, multi-producer/multi-consumer queue.
+///
+/// Each slot carries a sequence number that tells producers and consumers whether the slot is free
+/// for the current lap of the ring, so that the only contended operations are a compare-and-swap
+/// on the producer or consumer index.
+template <typename ValueT>
+class alignas(CacheLineSize) MpmcRing {
+  public:
+    explicit MpmcRing(std::size_t capacity)
+    : capacity_{next_pow2(capacity)}
+    , mask_{capacity_ - 1}
+    , cells_{new Cell[capacity_]}
+    {
+        for (std::size_t i{0}; i < capacity_; ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~MpmcRing() = default;
+
+    // Copy.
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    // Move.
+    MpmcRing(MpmcRing&&) = delete;
+    MpmcRing& operator=(MpmcRing&&) = delete;
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    /// Returns the number of elements. The result is approximate if called concurrently.
+    std::size_t size() const noexcept
+    {
+        const auto rpos = rpos_.load(std::memory_order_acquire);
+        const auto wpos = wpos_.load(std::memory_order_acquire);
+        return wpos > rpos ? wpos - rpos : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+    bool push(const ValueT& val)
+    {
+        return try_write([&val](ValueT& ref) { ref = val; });
+    }
+    bool push(ValueT&& val)
+    {
+        return try_write([&val](ValueT& ref) { ref = std::move(val); });
+    }
+    /// Pushes up to n elements, and returns the number pushed. Elements from other producers may
+    /// be interleaved with the batch.
+    std::size_t push_n(const ValueT* vals, std::size_t n)
+    {
+        std::size_t i{0};
+        while (i < n && push(vals[i])) {
+            ++i;
+        }
+        return i;
+    }
+    /// Claims the next free slot and invokes fn with a reference to it, so that the element can be
+    /// written in place. The element is published when fn returns. Returns false if the queue is
+    /// full.
+    template <typename FnT>
+    bool try_write(FnT fn)
+    {
+        auto pos = wpos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells_[pos & mask_];
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::int64_t>(seq - pos);
+            if (diff == 0) {
+                if (wpos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fn(cell.value);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // Full.
+                return false;
+            } else {
+                pos = wpos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(ValueT& val)
+    {
+        return try_read([&val](ValueT& ref) { val = std::move(ref); });
+    }
+    /// Pops up to n elements, and returns the number popped.
+    std::size_t pop_n(ValueT* vals, std::size_t n)
+    {
+        std::size_t i{0};
+        while (i < n && pop(vals[i])) {
+            ++i;
+        }
+        return i;
+    }
+    /// Claims the next element and invokes fn with a reference to it. The slot is released when fn
+    /// returns. Returns false if the queue is empty.
+    template <typename FnT>
+    bool try_read(FnT fn)
+    {
+        auto pos = rpos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells_[pos & mask_];
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::int64_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (rpos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fn(cell.value);
+                    cell.seq.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // Empty.
+                return false;
+            } else {
+                pos = rpos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+  private:
+    struct Cell {
+        std::atomic<std::uint64_t> seq;
+        ValueT value;
+    };
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    const std::unique_ptr<Cell[]> cells_;
+    alignas(CacheLineSize) std::atomic<std::uint64_t> wpos_{0};
+    alignas(CacheLineSize) std::atomic<std::uint64_t> rpos_{0};
+};
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_MPMCRING_HPP
@@ -0,0 +1,85 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MpmcRing.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(MpmcRingSuite)
+
+BOOST_AUTO_TEST_CASE(MpmcRingCase)
+{
+    MpmcRing<int> rb{4};
+    const int in[] = {1, 2, 3, 4, 5};
+    BOOST_CHECK_EQUAL(rb.push_n(in, 5), 4U);
+    BOOST_CHECK(!rb.push(6));
+    BOOST_CHECK_EQUAL(rb.size(), 4U);
+
+    int val{0};
+    BOOST_CHECK(rb.pop(val));
+    BOOST_CHECK_EQUAL(val, 1);
+    BOOST_CHECK(rb.try_write([](int& ref) { ref = 7; }));
+    int out[8];
+    BOOST_CHECK_EQUAL(rb.pop_n(out, 8), 4U);
+    BOOST_CHECK_EQUAL(out[0], 2);
+    BOOST_CHECK_EQUAL(out[3], 7);
+    BOOST_CHECK(!rb.try_read([](int&) {}));
+    BOOST_CHECK(rb.empty());
+}
+
+BOOST_AUTO_TEST_CASE(MpmcRingThreadCase)
+{
+    constexpr int Threads{2};
+    constexpr uint64_t N{200'000};
+    MpmcRing<uint64_t> rb{256};
+    atomic<uint64_t> sum{0}, count{0};
+
+    vector<thread> threads;
+    for (int t{0}; t < Threads; ++t) {
+        threads.emplace_back([&rb]() {
+            for (uint64_t i{1}; i <= N;) {
+                if (rb.push(i)) {
+                    ++i;
+                } else {
+                    this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&]() {
+            uint64_t val;
+            while (count.load(memory_order_relaxed) < Threads * N) {
+                if (rb.pop(val)) {
+                    sum.fetch_add(val, memory_order_relaxed);
+                    count.fetch_add(1, memory_order_relaxed);
+                } else {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    BOOST_CHECK_EQUAL(count.load(), Threads * N);
+    BOOST_CHECK_EQUAL(sum.load(), Threads * N * (N + 1) / 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,190 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ObjectPool.hpp"
+
+#include <toolbox/sys/Error.hpp>
+#include <toolbox/sys/Limits.hpp>
+#include <toolbox/sys/Memory.hpp>
+
+#include <algorithm>
+#include <new>
+#include <system_error>
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace toolbox {
+inline namespace util {
+using namespace std;
+namespace {
+
+// Number of free objects in each slab, computed by shrink().
+struct SlabHeader {
+    size_t free;
+};
+
+// Slabs are mapped in chunks of at least this size, which amortises the cost of the system calls.
+constexpr size_t MinChunkSize{64 * 1024};
+
+constexpr size_t ceil_align(size_t size, size_t align) noexcept
+{
+    return (size + align - 1) & ~(align - 1);
+}
+
+} // namespace
+
+BasicObjectPool::BasicObjectPool(size_t size, size_t align, size_t slab_size, int numa_node)
+: stride_{ceil_align(max(size, sizeof(Node)), max(align, alignof(Node)))}
+, offset_{ceil_align(sizeof(SlabHeader), max(align, alignof(Node)))}
+, slab_size_{slab_size}
+, per_slab_{(slab_size - offset_) / stride_}
+, numa_node_{numa_node}
+{
+    assert(is_pow2(slab_size) && slab_size >= PageSize);
+    assert(per_slab_ > 0);
+}
+
+BasicObjectPool::~BasicObjectPool()
+{
+    for (auto* slab : slabs_) {
+        free_slab(slab);
+    }
+    for (auto* slab : spare_) {
+        free_slab(slab);
+    }
+}
+
+ObjectPoolStats BasicObjectPool::stats() const noexcept
+{
+    return {.slabs = slabs_.size(),
+            .capacity = capacity(),
+            .in_use = in_use_,
+            .high_water = high_water_,
+            .allocs = allocs_};
+}
+
+void BasicObjectPool::reserve(size_t n)
+{
+    while (capacity() < n) {
+        add_slab();
+    }
+}
+
+size_t BasicObjectPool::shrink() noexcept
+{
+    const auto header = [this](const void* ptr) {
+        return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(ptr) & ~(slab_size_ - 1));
+    };
+    for (auto* slab : slabs_) {
+        static_cast<SlabHeader*>(slab)->free = 0;
+    }
+    for (auto* node = free_; node; node = node->next) {
+        ++header(node)->free;
+    }
+    // Unlink free objects that belong to empty slabs.
+    Node** link{&free_};
+    while (*link) {
+        if (header(*link)->free == per_slab_) {
+            *link = (*link)->next;
+        } else {
+            link = &(*link)->next;
+        }
+    }
+    const auto it = remove_if(slabs_.begin(), slabs_.end(), [this](void* slab) {
+        if (static_cast<SlabHeader*>(slab)->free == per_slab_) {
+            free_slab(slab);
+            return true;
+        }
+        return false;
+    });
+    const auto n = static_cast<size_t>(slabs_.end() - it);
+    slabs_.erase(it, slabs_.end());
+    return n;
+}
+
+void BasicObjectPool::add_slab()
+{
+    slabs_.reserve(slabs_.size() + 1);
+    if (spare_.empty()) {
+        map_chunk();
+    }
+    void* const slab{spare_.back()};
+    spare_.pop_back();
+    new (slab) SlabHeader{0};
+    // Push in reverse, so that objects are allocated in address order.
+    auto* const base = static_cast<char*>(slab) + offset_;
+    for (size_t i{per_slab_}; i-- > 0;) {
+        auto* const node = reinterpret_cast<Node*>(base + i * stride_);
+        node->next = free_;
+        free_ = node;
+    }
+    slabs_.push_back(slab);
+}
+
+void BasicObjectPool::map_chunk()
+{
+    const auto chunk_size = max(slab_size_, MinChunkSize);
+    spare_.reserve(spare_.size() + chunk_size / slab_size_);
+    vector<unsigned long> nodes;
+    constexpr size_t Bits{sizeof(unsigned long) * 8};
+    if (numa_node_ >= 0) {
+        // The node mask is sized for the node number.
+        nodes.resize(numa_node_ / Bits + 1);
+        nodes.back() = 1UL << (numa_node_ % Bits);
+    }
+
+    // Over-allocate, so that the chunk can be trimmed to the slab alignment. Unlike an aligned
+    // operator new, this leaves no per-slab allocator overhead.
+    const auto len = chunk_size + slab_size_ - PageSize;
+    auto* const base = static_cast<char*>(
+        os::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    auto* const begin
+        = reinterpret_cast<char*>(ceil_align(reinterpret_cast<uintptr_t>(base), slab_size_));
+    auto* const end = begin + chunk_size;
+    error_code ec;
+    if (begin > base) {
+        os::munmap(base, begin - base, ec);
+    }
+    if (end < base + len) {
+        os::munmap(end, base + len - end, ec);
+    }
+    if (!nodes.empty()) {
+        // Prefer the node before the pages are touched.
+        if (syscall(SYS_mbind, begin, chunk_size, MPOL_PREFERRED, nodes.data(), nodes.size() * Bits,
+                    MPOL_MF_MOVE)
+            < 0) {
+            const auto err = make_error(errno);
+            os::munmap(begin, chunk_size, ec);
+            throw system_error{err, "mbind"};
+        }
+    }
+    // Push in reverse, so that slabs are used in address order.
+    for (auto* slab = end; slab != begin;) {
+        slab -= slab_size_;
+        spare_.push_back(slab);
+    }
+}
+
+void BasicObjectPool::free_slab(void* slab) noexcept
+{
+    // Each slab can be unmapped independently of the rest of its chunk.
+    error_code ec;
+    os::munmap(slab, slab_size_, ec);
+}
+
+} // namespace util
+} // namespace toolbox
@@ -0,0 +1,153 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_OBJECTPOOL_HPP
+#define TOOLBOX_UTIL_OBJECTPOOL_HPP
+
+#include <toolbox/Config.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace toolbox {
+inline namespace util {
+
+struct ObjectPoolStats {
+    std::size_t slabs{0};
+    /// Total number of objects that the slabs can hold.
+    std::size_t capacity{0};
+    /// Number of objects currently allocated.
+    std::size_t in_use{0};
+    /// Maximum number of objects allocated at any one time.
+    std::size_t high_water{0};
+    std::uint64_t allocs{0};
+};
+
+/// Type-erased pool of fixed-size objects.
+///
+/// Objects are carved from slabs and recycled through a singly-linked free-list, so that allocation
+/// and deallocation are a pointer swap in the common case. Slabs are aligned to their size, which
+/// allows shrink() to identify and release slabs whose objects are all free.
+class TOOLBOX_API BasicObjectPool {
+  public:
+    /// \param size Object size.
+    /// \param align Object alignment.
+    /// \param slab_size Slab size, which must be a power of two that is no smaller than a page.
+    /// \param numa_node Preferred NUMA node for slab memory, or -1 for the default policy.
+    BasicObjectPool(std::size_t size, std::size_t align, std::size_t slab_size, int numa_node);
+    ~BasicObjectPool();
+
+    // Copy.
+    BasicObjectPool(const BasicObjectPool&) = delete;
+    BasicObjectPool& operator=(const BasicObjectPool&) = delete;
+
+    // Move.
+    BasicObjectPool(BasicObjectPool&&) = delete;
+    BasicObjectPool& operator=(BasicObjectPool&&) = delete;
+
+    std::size_t capacity() const noexcept { return slabs_.size() * per_slab_; }
+    std::size_t size() const noexcept { return in_use_; }
+    ObjectPoolStats stats() const noexcept;
+
+    /// Returns uninitialised storage for a single object.
+    void* allocate()
+    {
+        if (!free_) [[unlikely]] {
+            add_slab();
+        }
+        auto* const node = free_;
+        free_ = node->next;
+        if (++in_use_ > high_water_) {
+            high_water_ = in_use_;
+        }
+        ++allocs_;
+        return node;
+    }
+    void deallocate(void* ptr) noexcept
+    {
+        assert(ptr);
+        auto* const node = static_cast<Node*>(ptr);
+        node->next = free_;
+        free_ = node;
+        --in_use_;
+    }
+
+    /// Adds slabs until the pool can hold at least n objects. Slab memory is touched as the slab is
+    /// added, so that page faults are taken up-front rather than on the allocation path.
+    void reserve(std::size_t n);
+
+    /// Releases slabs that contain no allocated objects, and returns the number released.
+    ///
+    /// This is linear in the number of free objects, and is intended to be called periodically,
+    /// outside of the critical path.
+    std::size_t shrink() noexcept;
+
+  private:
+    struct Node {
+        Node* next;
+    };
+    void add_slab();
+    void map_chunk();
+    void free_slab(void* slab) noexcept;
+
+    const std::size_t stride_, offset_, slab_size_, per_slab_;
+    const int numa_node_;
+    std::vector<void*> slabs_;
+    /// Slabs that have been mapped but not yet used.
+    std::vector<void*> spare_;
+    /// Head of free-list.
+    Node* free_{nullptr};
+    std::size_t in_use_{0}, high_water_{0};
+    std::uint64_t allocs_{0};
+};
+
+/// Pool of objects of type ValueT.
+template <typename ValueT>
+class ObjectPool : public BasicObjectPool {
+  public:
+    explicit ObjectPool(std::size_t slab_size = 4096, int numa_node = -1)
+    : BasicObjectPool{sizeof(ValueT), alignof(ValueT), slab_size, numa_node}
+    {
+    }
+
+    /// Returns uninitialised storage for a single object.
+    ValueT* allocate() { return static_cast<ValueT*>(BasicObjectPool::allocate()); }
+    void deallocate(ValueT* ptr) noexcept { BasicObjectPool::deallocate(ptr); }
+
+    template <typename... ArgsT>
+    ValueT* construct(ArgsT&&... args)
+    {
+        auto* const ptr = allocate();
+        try {
+            return new (ptr) ValueT{std::forward<ArgsT>(args)...};
+        } catch (...) {
+            deallocate(ptr);
+            throw;
+        }
+    }
+    void destroy(ValueT* ptr) noexcept
+    {
+        ptr->~ValueT();
+        deallocate(ptr);
+    }
+};
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_OBJECTPOOL_HPP
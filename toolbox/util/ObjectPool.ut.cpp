@@ -0,0 +1,124 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ObjectPool.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+struct Foo {
+    int id;
+    string name;
+};
+
+struct alignas(64) Bar {
+    char data[64];
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ObjectPoolSuite)
+
+BOOST_AUTO_TEST_CASE(ObjectPoolCase)
+{
+    ObjectPool<Foo> pool;
+    BOOST_CHECK_EQUAL(pool.capacity(), 0U);
+
+    auto* const foo = pool.construct(101, "foo"s);
+    BOOST_CHECK_EQUAL(foo->id, 101);
+    BOOST_CHECK_EQUAL(foo->name, "foo");
+    BOOST_CHECK_EQUAL(pool.size(), 1U);
+    const auto capacity = pool.capacity();
+    BOOST_CHECK_GT(capacity, 1U);
+
+    // Objects are allocated in address order.
+    auto* const bar = pool.construct(102, "bar"s);
+    BOOST_CHECK_EQUAL(reinterpret_cast<char*>(bar) - reinterpret_cast<char*>(foo), sizeof(Foo));
+
+    // Freed objects are reused.
+    pool.destroy(foo);
+    BOOST_CHECK_EQUAL(pool.construct(103, "baz"s), foo);
+    pool.destroy(foo);
+    pool.destroy(bar);
+
+    const auto stats = pool.stats();
+    BOOST_CHECK_EQUAL(stats.slabs, 1U);
+    BOOST_CHECK_EQUAL(stats.capacity, capacity);
+    BOOST_CHECK_EQUAL(stats.in_use, 0U);
+    BOOST_CHECK_EQUAL(stats.high_water, 2U);
+    BOOST_CHECK_EQUAL(stats.allocs, 3U);
+}
+
+BOOST_AUTO_TEST_CASE(ObjectPoolAlignCase)
+{
+    ObjectPool<Bar> pool;
+    for (int i{0}; i < 100; ++i) {
+        BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(pool.allocate()) % alignof(Bar), 0U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ObjectPoolShrinkCase)
+{
+    ObjectPool<Foo> pool;
+    pool.reserve(1000);
+    const auto slabs = pool.stats().slabs;
+    BOOST_CHECK_GE(pool.capacity(), 1000U);
+    BOOST_CHECK_GT(slabs, 1U);
+
+    vector<Foo*> foos;
+    for (int i{0}; i < 1000; ++i) {
+        foos.push_back(pool.construct(i, to_string(i)));
+    }
+    BOOST_CHECK_EQUAL(pool.stats().slabs, slabs);
+
+    // Free all but the first and last objects.
+    for (size_t i{1}; i < foos.size() - 1; ++i) {
+        pool.destroy(foos[i]);
+    }
+    BOOST_CHECK_EQUAL(pool.shrink(), slabs - 2);
+    BOOST_CHECK_EQUAL(pool.stats().slabs, 2U);
+    BOOST_CHECK_EQUAL(foos.front()->name, "0");
+    BOOST_CHECK_EQUAL(foos.back()->name, "999");
+
+    // The remaining free-list only refers to retained slabs.
+    for (size_t i{0}; i < pool.capacity() - 2; ++i) {
+        pool.allocate();
+    }
+    BOOST_CHECK_EQUAL(pool.stats().slabs, 2U);
+    pool.allocate();
+    BOOST_CHECK_EQUAL(pool.stats().slabs, 3U);
+}
+
+BOOST_AUTO_TEST_CASE(ObjectPoolNumaCase)
+{
+    // Node zero is always present.
+    ObjectPool<Foo> pool{1 << 16, 0};
+    pool.destroy(pool.construct(1, "foo"s));
+    BOOST_CHECK_EQUAL(pool.stats().slabs, 1U);
+
+    // The node mask is sized for node numbers beyond the width of a long.
+    ObjectPool<Foo> other{4096, 100};
+    BOOST_CHECK_THROW(other.allocate(), system_error);
+    BOOST_CHECK_EQUAL(other.stats().slabs, 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,284 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Slab.hpp"
+
+#include <toolbox/sys/Limits.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include <sys/mman.h>
+
+namespace toolbox {
+inline namespace util {
+using namespace std;
+namespace {
+
+// Chunks are aligned to their size, so that the chunk header can be found from any object.
+constexpr size_t ChunkBits{21};
+constexpr size_t ChunkSize{1 << ChunkBits};
+
+// Sixteen byte spacing up to 128 bytes, then four classes per power of two.
+constexpr size_t SlabSizes[] = {16,   32,   48,   64,   80,   96,   112,  128,  160,  192,
+                                224,  256,  320,  384,  448,  512,  640,  768,  896,  1024,
+                                1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096};
+constexpr size_t NumClasses{size(SlabSizes)};
+static_assert(SlabSizes[NumClasses - 1] == MaxSlabSize);
+
+constexpr auto make_class_index() noexcept
+{
+    array<uint8_t, MaxSlabSize / 16 + 1> index{};
+    size_t cls{0};
+    for (size_t i{0}; i < index.size(); ++i) {
+        while (SlabSizes[cls] < i * 16) {
+            ++cls;
+        }
+        index[i] = cls;
+    }
+    return index;
+}
+constexpr auto ClassIndex = make_class_index();
+
+constexpr size_t class_of(size_t size) noexcept
+{
+    return ClassIndex[(size + 15) >> 4];
+}
+
+struct Node {
+    Node* next;
+};
+
+struct Heap;
+
+struct alignas(CacheLineSize) Chunk {
+    Heap* owner;
+    size_t cls;
+};
+
+inline Chunk* chunk_of(void* ptr) noexcept
+{
+    return reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(ptr) & ~(ChunkSize - 1));
+}
+
+struct Heap {
+    struct Class {
+        Node* free{nullptr};
+        char* next{nullptr};
+        char* end{nullptr};
+        SlabStats stats;
+    };
+    array<Class, NumClasses> classes;
+    // Next idle heap.
+    Heap* next_idle{nullptr};
+    // Objects freed by threads other than the owner.
+    alignas(CacheLineSize) atomic<Node*> remote{nullptr};
+};
+
+atomic<bool> huge_pages_{false};
+
+// Heaps released by exited threads. Intrusive, so that no destructor runs at exit.
+mutex mutex_;
+Heap* idle_{nullptr};
+
+thread_local Heap* heap_{nullptr};
+thread_local bool exited_{false};
+
+char* map_chunk()
+{
+    constexpr int Prot{PROT_READ | PROT_WRITE};
+    constexpr int Flags{MAP_PRIVATE | MAP_ANONYMOUS};
+    const bool huge_pages{huge_pages_.load(memory_order_relaxed)};
+    if (huge_pages) {
+        // Huge pages are naturally aligned.
+        void* const p{mmap(nullptr, ChunkSize, Prot, Flags | MAP_HUGETLB, -1, 0)};
+        if (p != MAP_FAILED) {
+            return static_cast<char*>(p);
+        }
+    }
+    // Over-allocate and trim, so that the chunk is aligned to its size.
+    void* const p{mmap(nullptr, 2 * ChunkSize, Prot, Flags, -1, 0)};
+    if (p == MAP_FAILED) {
+        throw bad_alloc{};
+    }
+    auto* const base = static_cast<char*>(p);
+    auto* const chunk = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(base) + ChunkSize - 1) & ~(ChunkSize - 1));
+    if (const size_t head = chunk - base; head > 0) {
+        munmap(base, head);
+    }
+    if (const size_t tail = base + ChunkSize - chunk; tail > 0) {
+        munmap(chunk + ChunkSize, tail);
+    }
+    if (huge_pages) {
+        madvise(chunk, ChunkSize, MADV_HUGEPAGE);
+    }
+    return chunk;
+}
+
+void release_heap(Heap* heap) noexcept
+{
+    if (heap) {
+        lock_guard lock{mutex_};
+        heap->next_idle = idle_;
+        idle_ = heap;
+    }
+}
+
+struct HeapGuard {
+    ~HeapGuard()
+    {
+        release_heap(exchange(heap_, nullptr));
+        exited_ = true;
+    }
+};
+
+Heap* acquire_heap()
+{
+    Heap* heap{nullptr};
+    {
+        lock_guard lock{mutex_};
+        if (idle_) {
+            heap = exchange(idle_, idle_->next_idle);
+        }
+    }
+    if (!heap) {
+        heap = new Heap{};
+        for (size_t i{0}; i < NumClasses; ++i) {
+            heap->classes[i].stats.size = SlabSizes[i];
+        }
+    }
+    // Heaps acquired during thread exit are not released.
+    if (!exited_) {
+        static thread_local HeapGuard guard;
+    }
+    heap_ = heap;
+    return heap;
+}
+
+void drain_remote(Heap& heap) noexcept
+{
+    auto* node = heap.remote.exchange(nullptr, memory_order_acquire);
+    while (node) {
+        auto* const next = node->next;
+        auto& c = heap.classes[chunk_of(node)->cls];
+        node->next = c.free;
+        c.free = node;
+        ++c.stats.frees;
+        ++c.stats.remote_frees;
+        node = next;
+    }
+}
+
+void* refill(Heap& heap, size_t cls)
+{
+    auto& c = heap.classes[cls];
+    if (heap.remote.load(memory_order_relaxed)) {
+        drain_remote(heap);
+        if (auto* const node = c.free) {
+            c.free = node->next;
+            ++c.stats.allocs;
+            return node;
+        }
+    }
+    const auto size = SlabSizes[cls];
+    if (c.next + size > c.end) {
+        auto* const chunk = map_chunk();
+        new (chunk) Chunk{&heap, cls};
+        c.next = chunk + sizeof(Chunk);
+        c.end = chunk + ChunkSize;
+        ++c.stats.chunks;
+    }
+    void* const ptr{c.next};
+    c.next += size;
+    ++c.stats.allocs;
+    return ptr;
+}
+
+} // namespace
+
+void* slab_allocate(size_t size)
+{
+    if (size > MaxSlabSize) [[unlikely]] {
+        return ::operator new(size);
+    }
+    auto* heap = heap_;
+    if (!heap) [[unlikely]] {
+        heap = acquire_heap();
+    }
+    const auto cls = class_of(size);
+    auto& c = heap->classes[cls];
+    if (auto* const node = c.free) [[likely]] {
+        c.free = node->next;
+        ++c.stats.allocs;
+        return node;
+    }
+    return refill(*heap, cls);
+}
+
+void slab_deallocate(void* ptr, size_t size) noexcept
+{
+    if (size > MaxSlabSize) [[unlikely]] {
+#if __cpp_sized_deallocation
+        ::operator delete(ptr, size);
+#else
+        ::operator delete(ptr);
+#endif
+        return;
+    }
+    if (!ptr) {
+        return;
+    }
+    auto* const node = static_cast<Node*>(ptr);
+    const auto* const chunk = chunk_of(ptr);
+    auto* const owner = chunk->owner;
+    if (owner == heap_) [[likely]] {
+        auto& c = owner->classes[chunk->cls];
+        node->next = c.free;
+        c.free = node;
+        ++c.stats.frees;
+        return;
+    }
+    auto* head = owner->remote.load(memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!owner->remote.compare_exchange_weak(head, node, memory_order_release,
+                                                  memory_order_relaxed));
+}
+
+void set_slab_huge_pages(bool enable) noexcept
+{
+    huge_pages_.store(enable, memory_order_relaxed);
+}
+
+vector<SlabStats> slab_stats()
+{
+    vector<SlabStats> stats;
+    stats.reserve(NumClasses);
+    for (size_t i{0}; i < NumClasses; ++i) {
+        if (heap_) {
+            stats.push_back(heap_->classes[i].stats);
+        } else {
+            stats.push_back({.size = SlabSizes[i]});
+        }
+    }
+    return stats;
+}
+
+} // namespace util
+} // namespace toolbox
@@ -0,0 +1,75 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_SLAB_HPP
+#define TOOLBOX_UTIL_SLAB_HPP
+
+#include <toolbox/Config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace toolbox {
+inline namespace util {
+
+/// Largest request served from a slab. Larger requests are forwarded to the global operator new.
+constexpr std::size_t MaxSlabSize{4096};
+
+/// Allocation statistics for a single size-class.
+struct SlabStats {
+    /// Object size for this size-class.
+    std::size_t size{0};
+    std::uint64_t allocs{0};
+    /// Total frees, including remote frees.
+    std::uint64_t frees{0};
+    /// Objects that were freed by a thread other than the owner.
+    std::uint64_t remote_frees{0};
+    /// Number of chunks acquired for this size-class.
+    std::uint64_t chunks{0};
+};
+
+/// Allocates size bytes from the calling thread's slab heap.
+///
+/// Each thread owns a heap of size-classes, each comprising a free-list and a bump region within a
+/// chunk obtained from mmap(). Allocation and same-thread deallocation are lock-free and do not
+/// call into malloc. Objects freed by another thread are pushed onto a lock-free queue owned by
+/// the heap, which is drained when the owner's free-list is exhausted.
+///
+/// Chunks are never returned to the operating system. When a thread exits, its heap (including any
+/// live objects) is adopted by the next thread that allocates.
+///
+/// Alignment is that of __STDCPP_DEFAULT_NEW_ALIGNMENT__.
+TOOLBOX_API void* slab_allocate(std::size_t size);
+
+/// Returns memory obtained from slab_allocate(). The size must match that passed to
+/// slab_allocate(). Memory may be returned from any thread.
+TOOLBOX_API void slab_deallocate(void* ptr, std::size_t size) noexcept;
+
+/// Back subsequent chunks with 2MiB huge pages.
+///
+/// Explicit huge pages (MAP_HUGETLB) are used when available, otherwise transparent huge pages
+/// are requested with madvise(). This should be called during initialisation.
+TOOLBOX_API void set_slab_huge_pages(bool enable = true) noexcept;
+
+/// Returns per size-class statistics for the calling thread's heap.
+///
+/// Remote frees are only accounted for once they have been drained by the owning thread.
+TOOLBOX_API std::vector<SlabStats> slab_stats();
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_SLAB_HPP
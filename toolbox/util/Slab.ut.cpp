@@ -0,0 +1,107 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Slab.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <thread>
+
+using namespace std;
+using namespace toolbox;
+
+namespace {
+
+const SlabStats& stats_for(const vector<SlabStats>& stats, size_t size)
+{
+    for (const auto& s : stats) {
+        if (s.size >= size) {
+            return s;
+        }
+    }
+    throw out_of_range{"size"};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(SlabSuite)
+
+BOOST_AUTO_TEST_CASE(SlabSizeClassCase)
+{
+    const auto before = slab_stats();
+    BOOST_CHECK_EQUAL(before.front().size, 16U);
+    BOOST_CHECK_EQUAL(before.back().size, MaxSlabSize);
+
+    for (size_t size{1}; size <= MaxSlabSize + 1; size += 7) {
+        auto* const ptr = static_cast<char*>(slab_allocate(size));
+        BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(ptr) % __STDCPP_DEFAULT_NEW_ALIGNMENT__, 0U);
+        memset(ptr, 0xff, size);
+        slab_deallocate(ptr, size);
+        // Freed objects are reused.
+        BOOST_CHECK_EQUAL(slab_allocate(size), ptr);
+        slab_deallocate(ptr, size);
+    }
+
+    const auto after = slab_stats();
+    const auto& b = stats_for(before, 100);
+    const auto& a = stats_for(after, 100);
+    BOOST_CHECK_EQUAL(a.size, 112U);
+    BOOST_CHECK_EQUAL(a.allocs - b.allocs, 4U);
+    BOOST_CHECK_EQUAL(a.frees - b.frees, 4U);
+    BOOST_CHECK_GE(a.chunks, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(SlabRemoteFreeCase)
+{
+    constexpr size_t Size{40};
+    auto* const ptr = slab_allocate(Size);
+    const auto before = stats_for(slab_stats(), Size);
+
+    thread t{[ptr]() { slab_deallocate(ptr, Size); }};
+    t.join();
+
+    // The remote free is drained once the local free-list is exhausted.
+    vector<void*> ptrs;
+    do {
+        ptrs.push_back(slab_allocate(Size));
+    } while (ptrs.back() != ptr && ptrs.size() < 100000);
+    BOOST_CHECK_EQUAL(ptrs.back(), ptr);
+
+    const auto after = stats_for(slab_stats(), Size);
+    BOOST_CHECK_EQUAL(after.remote_frees - before.remote_frees, 1U);
+    for (auto* p : ptrs) {
+        slab_deallocate(p, Size);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SlabThreadExitCase)
+{
+    void* ptr{nullptr};
+    thread t{[&ptr]() { ptr = slab_allocate(64); }};
+    t.join();
+    // The exited thread's heap is adopted by the next thread.
+    // Boost.Test assertions are not thread-safe, so the result is checked after the join.
+    void* reused{nullptr};
+    thread u{[ptr, &reused]() {
+        slab_deallocate(ptr, 64);
+        reused = slab_allocate(64);
+        slab_deallocate(reused, 64);
+    }};
+    u.join();
+    BOOST_CHECK_EQUAL(reused, ptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_SPSCRING_HPP
+#define TOOLBOX_UTIL_SPSCRING_HPP
+
+#include <toolbox/sys/Limits.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace toolbox {
+inline namespace util {
+
+/// Bounded, lock-free, single-producer/single-consumer queue.
+///
+/// Unlike RingBuffer, the queue never overwrites unread elements: push operations fail when the
+/// queue is full. The producer and consumer indices are held on separate cache-lines, together
+/// with a cached copy of the opposite index, so that the shared index is only loaded when the
+/// cached copy indicates that the queue is full (or empty).
+template <typename ValueT>
+class alignas(CacheLineSize) SpscRing {
+  public:
+    explicit SpscRing(std::size_t capacity)
+    : capacity_{next_pow2(capacity)}
+    , mask_{capacity_ - 1}
+    , buf_{new ValueT[capacity_]}
+    {
+    }
+    ~SpscRing() = default;
+
+    // Copy.
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Move.
+    SpscRing(SpscRing&&) = delete;
+    SpscRing& operator=(SpscRing&&) = delete;
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    /// Returns the number of elements. The result is approximate if called concurrently.
+    std::size_t size() const noexcept
+    {
+        // Load the read position first, so that a concurrent pop cannot move it past the snapshot
+        // of the write position.
+        const auto rpos = cons_.rpos.load(std::memory_order_acquire);
+        const auto wpos = prod_.wpos.load(std::memory_order_acquire);
+        return wpos > rpos ? wpos - rpos : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+    /// Producer.
+    bool push(const ValueT& val)
+    {
+        return try_write([&val](ValueT& ref) { ref = val; });
+    }
+    /// Producer.
+    bool push(ValueT&& val)
+    {
+        return try_write([&val](ValueT& ref) { ref = std::move(val); });
+    }
+    /// Producer. Pushes up to n elements, and returns the number pushed.
+    std::size_t push_n(const ValueT* vals, std::size_t n)
+    {
+        const auto wpos = prod_.wpos.load(std::memory_order_relaxed);
+        n = std::min(n, writable(wpos, n));
+        for (std::size_t i{0}; i < n; ++i) {
+            buf_[(wpos + i) & mask_] = vals[i];
+        }
+        prod_.wpos.store(wpos + n, std::memory_order_release);
+        return n;
+    }
+    /// Producer. Invokes fn with a reference to the next free slot, so that the element can be
+    /// written in place. The element is published when fn returns. Returns false if the queue is
+    /// full.
+    template <typename FnT>
+    bool try_write(FnT fn)
+    {
+        const auto wpos = prod_.wpos.load(std::memory_order_relaxed);
+        if (writable(wpos, 1) == 0) {
+            return false;
+        }
+        fn(buf_[wpos & mask_]);
+        prod_.wpos.store(wpos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer.
+    bool pop(ValueT& val)
+    {
+        return try_read([&val](ValueT& ref) { val = std::move(ref); });
+    }
+    /// Consumer. Pops up to n elements, and returns the number popped.
+    std::size_t pop_n(ValueT* vals, std::size_t n)
+    {
+        const auto rpos = cons_.rpos.load(std::memory_order_relaxed);
+        n = std::min(n, readable(rpos, n));
+        for (std::size_t i{0}; i < n; ++i) {
+            vals[i] = std::move(buf_[(rpos + i) & mask_]);
+        }
+        cons_.rpos.store(rpos + n, std::memory_order_release);
+        return n;
+    }
+    /// Consumer. Invokes fn with a reference to the next element, which is released when fn
+    /// returns. Returns false if the queue is empty.
+    template <typename FnT>
+    bool try_read(FnT fn)
+    {
+        const auto rpos = cons_.rpos.load(std::memory_order_relaxed);
+        if (readable(rpos, 1) == 0) {
+            return false;
+        }
+        fn(buf_[rpos & mask_]);
+        cons_.rpos.store(rpos + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    std::size_t writable(std::uint64_t wpos, std::size_t n) noexcept
+    {
+        auto avail = capacity_ - (wpos - prod_.rpos_cache);
+        if (avail < n) {
+            prod_.rpos_cache = cons_.rpos.load(std::memory_order_acquire);
+            avail = capacity_ - (wpos - prod_.rpos_cache);
+        }
+        return avail;
+    }
+    std::size_t readable(std::uint64_t rpos, std::size_t n) noexcept
+    {
+        auto avail = cons_.wpos_cache - rpos;
+        if (avail < n) {
+            cons_.wpos_cache = prod_.wpos.load(std::memory_order_acquire);
+            avail = cons_.wpos_cache - rpos;
+        }
+        return avail;
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    const std::unique_ptr<ValueT[]> buf_;
+    struct alignas(CacheLineSize) {
+        std::atomic<std::uint64_t> wpos{0};
+        std::uint64_t rpos_cache{0};
+    } prod_;
+    struct alignas(CacheLineSize) {
+        std::atomic<std::uint64_t> rpos{0};
+        std::uint64_t wpos_cache{0};
+    } cons_;
+};
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_SPSCRING_HPP
@@ -0,0 +1,102 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SpscRing.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(SpscRingSuite)
+
+BOOST_AUTO_TEST_CASE(SpscRingCase)
+{
+    SpscRing<string> rb{3};
+    BOOST_CHECK_EQUAL(rb.capacity(), 4U);
+    BOOST_CHECK(rb.empty());
+
+    BOOST_CHECK(rb.push("foo"s));
+    BOOST_CHECK(rb.push("bar"s));
+    BOOST_CHECK(rb.try_write([](string& ref) { ref = "baz"; }));
+    BOOST_CHECK(rb.push("qux"s));
+    // Full elements are not overwritten.
+    BOOST_CHECK(!rb.push("quux"s));
+    BOOST_CHECK_EQUAL(rb.size(), 4U);
+
+    string s;
+    BOOST_CHECK(rb.pop(s));
+    BOOST_CHECK_EQUAL(s, "foo");
+    BOOST_CHECK(rb.try_read([](string& ref) { BOOST_CHECK_EQUAL(ref, "bar"); }));
+    string out[4];
+    BOOST_CHECK_EQUAL(rb.pop_n(out, 4), 2U);
+    BOOST_CHECK_EQUAL(out[0], "baz");
+    BOOST_CHECK_EQUAL(out[1], "qux");
+    BOOST_CHECK(!rb.pop(s));
+    BOOST_CHECK(rb.empty());
+
+    const string in[] = {"a", "b", "c", "d", "e"};
+    BOOST_CHECK_EQUAL(rb.push_n(in, 5), 4U);
+    BOOST_CHECK_EQUAL(rb.pop_n(out, 4), 4U);
+    BOOST_CHECK_EQUAL(out[3], "d");
+}
+
+BOOST_AUTO_TEST_CASE(SpscRingThreadCase)
+{
+    constexpr uint64_t N{200'000};
+    SpscRing<uint64_t> rb{1024};
+    thread producer{[&rb]() {
+        uint64_t batch[16];
+        for (uint64_t i{0}; i < N;) {
+            if (i % 2 == 0) {
+                if (rb.push(i)) {
+                    ++i;
+                } else {
+                    this_thread::yield();
+                }
+            } else {
+                const auto n = min<uint64_t>(16, N - i);
+                for (uint64_t j{0}; j < n; ++j) {
+                    batch[j] = i + j;
+                }
+                const auto m = rb.push_n(batch, n);
+                if (m == 0) {
+                    this_thread::yield();
+                }
+                i += m;
+            }
+        }
+    }};
+    uint64_t expect{0};
+    bool ordered{true};
+    uint64_t batch[16];
+    while (expect < N) {
+        const auto n = rb.pop_n(batch, 16);
+        if (n == 0) {
+            this_thread::yield();
+        }
+        for (size_t i{0}; i < n; ++i) {
+            ordered = ordered && batch[i] == expect++;
+        }
+    }
+    producer.join();
+    BOOST_CHECK(ordered);
+    BOOST_CHECK(rb.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
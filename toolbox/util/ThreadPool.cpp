@@ -0,0 +1,215 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ThreadPool.hpp"
+
+#include <toolbox/sys/Log.hpp>
+#include <toolbox/sys/Signal.hpp>
+
+namespace toolbox {
+inline namespace util {
+using namespace std;
+namespace {
+
+// Number of times that an idle worker looks for work before sleeping.
+constexpr int SpinCount{16};
+
+thread_local const ThreadPool* tl_pool{nullptr};
+thread_local int tl_worker{-1};
+
+vector<ThreadConfig> make_configs(size_t n, const ThreadConfig& config)
+{
+    vector<ThreadConfig> configs;
+    configs.reserve(n);
+    for (size_t i{0}; i < n; ++i) {
+        auto& c = configs.emplace_back(config);
+        c.name += to_string(i);
+    }
+    return configs;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(vector<ThreadConfig> configs, size_t capacity)
+: inject_{capacity}
+{
+    workers_.reserve(configs.size());
+    for (size_t i{0}; i < configs.size(); ++i) {
+        workers_.push_back(make_unique<Worker>(capacity));
+    }
+    // Start the workers once all deques exist, because workers steal from each other.
+    for (size_t i{0}; i < configs.size(); ++i) {
+        workers_[i]->thread = thread{&ThreadPool::run, this, i, std::move(configs[i])};
+    }
+}
+
+ThreadPool::ThreadPool(size_t n, const ThreadConfig& config, size_t capacity)
+: ThreadPool{make_configs(n, config), capacity}
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+    for (auto& w : workers_) {
+        w->thread.join();
+    }
+    // The workers drain the queues before they exit, but a task submitted concurrently with stop()
+    // may be queued afterwards, so it is run here.
+    const string name{"thread pool"};
+    Task* task;
+    for (auto& w : workers_) {
+        while (w->deque.pop(task)) {
+            run_task(task, name);
+        }
+    }
+    while (inject_.pop(task)) {
+        run_task(task, name);
+    }
+    for (auto* t : overflow_) {
+        run_task(t, name);
+    }
+}
+
+int ThreadPool::current_worker() const noexcept
+{
+    return tl_pool == this ? tl_worker : -1;
+}
+
+void ThreadPool::stop() noexcept
+{
+    stop_.store(true, memory_order_seq_cst);
+    epoch_.fetch_add(1, memory_order_release);
+    epoch_.notify_all();
+}
+
+void ThreadPool::run_task(Task* task, const string& name) noexcept
+{
+    const unique_ptr<Task> ptr{task};
+    try {
+        ptr->run();
+    } catch (const exception& e) {
+        TOOLBOX_ERROR << "exception on " << name << " thread: " << e.what();
+    }
+}
+
+bool ThreadPool::push(Task* task)
+{
+    if (stop_.load(memory_order_acquire)) {
+        delete task;
+        return false;
+    }
+    const auto i = current_worker();
+    if (i < 0 || !workers_[i]->deque.push(task)) {
+        if (!inject_.push(task)) {
+            lock_guard lock{overflow_mtx_};
+            overflow_.push_back(task);
+            has_overflow_.store(true, memory_order_release);
+        }
+    }
+    notify();
+    return true;
+}
+
+void ThreadPool::run(size_t i, const ThreadConfig& config)
+{
+    sig_block_all();
+    tl_pool = this;
+    tl_worker = static_cast<int>(i);
+    try {
+        set_thread_attrs(config);
+    } catch (const exception& e) {
+        TOOLBOX_ERROR << "could not set attributes of " << config.name << " thread: " << e.what();
+    }
+    TOOLBOX_NOTICE << "started " << config.name << " thread";
+    int spins{0};
+    while (!stop_.load(memory_order_acquire)) {
+        if (auto* const task = find_task(i)) {
+            spins = 0;
+            run_task(task, config.name);
+            continue;
+        }
+        if (++spins < SpinCount) {
+            this_thread::yield();
+            continue;
+        }
+        spins = 0;
+        // Register as a sleeper before the final check for work, so that a concurrent submitter
+        // either sees the sleeper or the sleeper sees the task.
+        const auto epoch = epoch_.load(memory_order_acquire);
+        sleepers_.fetch_add(1, memory_order_seq_cst);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!stop_.load(memory_order_relaxed) && !has_task()) {
+            epoch_.wait(epoch, memory_order_acquire);
+        }
+        sleepers_.fetch_sub(1, memory_order_relaxed);
+    }
+    // Tasks that were accepted before the pool was stopped still run.
+    while (auto* const task = find_task(i)) {
+        run_task(task, config.name);
+    }
+    TOOLBOX_NOTICE << "stopping " << config.name << " thread";
+}
+
+ThreadPool::Task* ThreadPool::find_task(size_t i) noexcept
+{
+    Task* task;
+    if (workers_[i]->deque.pop(task) || inject_.pop(task)) {
+        return task;
+    }
+    if (has_overflow_.load(memory_order_acquire)) {
+        lock_guard lock{overflow_mtx_};
+        if (!overflow_.empty()) {
+            task = overflow_.back();
+            overflow_.pop_back();
+            has_overflow_.store(!overflow_.empty(), memory_order_release);
+            return task;
+        }
+    }
+    const auto n = workers_.size();
+    for (size_t j{1}; j < n; ++j) {
+        if (workers_[(i + j) % n]->deque.steal(task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+bool ThreadPool::has_task() const noexcept
+{
+    if (!inject_.empty() || has_overflow_.load(memory_order_relaxed)) {
+        return true;
+    }
+    for (const auto& w : workers_) {
+        if (!w->deque.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::notify() noexcept
+{
+    // Pairs with the fence in run(), so that the task is visible to a worker that is about to
+    // sleep, or the worker is visible here.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (sleepers_.load(memory_order_relaxed) > 0) {
+        epoch_.fetch_add(1, memory_order_release);
+        epoch_.notify_one();
+    }
+}
+
+} // namespace util
+} // namespace toolbox
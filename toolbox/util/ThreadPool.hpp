@@ -0,0 +1,124 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_THREADPOOL_HPP
+#define TOOLBOX_UTIL_THREADPOOL_HPP
+
+#include <toolbox/sys/Thread.hpp>
+#include <toolbox/util/MpmcRing.hpp>
+#include <toolbox/util/WorkDeque.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace toolbox {
+inline namespace util {
+
+/// Pool of worker threads for background jobs, with a work-stealing deque per worker.
+///
+/// Tasks submitted from a worker are pushed onto that worker's own deque, so that fan-out from a
+/// task does not contend on a shared lock. Tasks submitted from other threads are pushed onto a
+/// shared lock-free queue. Idle workers take work from their own deque first, then from the shared
+/// queue, and finally steal from the other workers.
+///
+/// Idle workers spin briefly before sleeping, and submitters only wake a worker when one is
+/// sleeping, so that a burst of submissions does not issue a wakeup per task.
+class TOOLBOX_API ThreadPool {
+  public:
+    /// Creates a worker for each thread config, which sets the name and affinity of the worker.
+    explicit ThreadPool(std::vector<ThreadConfig> configs, std::size_t capacity = 1024);
+    /// Creates n workers. The workers are named after config, with the worker index appended, and
+    /// share its affinity.
+    ThreadPool(std::size_t n, const ThreadConfig& config, std::size_t capacity = 1024);
+    /// Stops the workers. Every accepted task is run before the pool is destroyed.
+    ~ThreadPool();
+
+    // Copy.
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Move.
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    std::size_t size() const noexcept { return workers_.size(); }
+    /// Returns the index of the calling worker, or -1 if the caller is not a worker of this pool.
+    int current_worker() const noexcept;
+
+    /// Submits a task to run on a worker. Returns false if the pool has been stopped.
+    ///
+    /// Exceptions thrown by tasks are logged and discarded.
+    template <typename FnT>
+    bool submit(FnT&& fn)
+    {
+        return push(new TaskImpl<std::decay_t<FnT>>{std::forward<FnT>(fn)});
+    }
+
+    /// Stops the workers once the tasks already accepted have run. Subsequent submissions are
+    /// rejected.
+    void stop() noexcept;
+
+  private:
+    struct Task {
+        virtual ~Task() = default;
+        virtual void run() = 0;
+    };
+    template <typename FnT>
+    struct TaskImpl final : Task {
+        explicit TaskImpl(FnT&& fn)
+        : fn{std::move(fn)}
+        {
+        }
+        explicit TaskImpl(const FnT& fn)
+        : fn{fn}
+        {
+        }
+        void run() override { fn(); }
+        FnT fn;
+    };
+    struct Worker {
+        explicit Worker(std::size_t capacity)
+        : deque{capacity}
+        {
+        }
+        WorkDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    static void run_task(Task* task, const std::string& name) noexcept;
+    bool push(Task* task);
+    void run(std::size_t i, const ThreadConfig& config);
+    Task* find_task(std::size_t i) noexcept;
+    bool has_task() const noexcept;
+    void notify() noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    MpmcRing<Task*> inject_;
+    std::mutex overflow_mtx_;
+    std::vector<Task*> overflow_;
+    std::atomic<bool> has_overflow_{false};
+    alignas(CacheLineSize) std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint32_t> sleepers_{0};
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_THREADPOOL_HPP
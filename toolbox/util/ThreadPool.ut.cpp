@@ -0,0 +1,101 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ThreadPool.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <condition_variable>
+#include <future>
+#include <set>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolSuite)
+
+BOOST_AUTO_TEST_CASE(ThreadPoolCase)
+{
+    ThreadPool pool{3, "worker"s};
+    BOOST_CHECK_EQUAL(pool.size(), 3U);
+    BOOST_CHECK_EQUAL(pool.current_worker(), -1);
+
+    // Move-only tasks are supported.
+    packaged_task<int()> task{[&pool]() { return pool.current_worker(); }};
+    auto future = task.get_future();
+    BOOST_CHECK(pool.submit(std::move(task)));
+    const auto i = future.get();
+    BOOST_CHECK(i >= 0 && i < 3);
+
+    // Exceptions are logged and do not stop the worker.
+    BOOST_CHECK(pool.submit([]() { throw runtime_error{"test"}; }));
+    promise<void> p;
+    BOOST_CHECK(pool.submit([&p]() { p.set_value(); }));
+    p.get_future().get();
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPoolFanOutCase)
+{
+    constexpr int N{100}, M{100};
+    ThreadPool pool{2, "worker"s, 16};
+    atomic<int> count{0};
+    mutex mtx;
+    condition_variable cond;
+    set<int> workers;
+
+    // Each task fans out from a worker, which overflows the worker's deque.
+    for (int i{0}; i < N; ++i) {
+        pool.submit([&]() {
+            for (int j{0}; j < M; ++j) {
+                pool.submit([&]() {
+                    const auto w = pool.current_worker();
+                    lock_guard lock{mtx};
+                    workers.insert(w);
+                    if (++count == N * M) {
+                        cond.notify_one();
+                    }
+                });
+            }
+        });
+    }
+    unique_lock lock{mtx};
+    cond.wait(lock, [&]() { return count == N * M; });
+    BOOST_CHECK(!workers.contains(-1));
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPoolStopCase)
+{
+    atomic<int> count{0};
+    {
+        ThreadPool pool{1, "worker"s};
+        promise<void> started, release;
+        auto fut = release.get_future();
+        pool.submit([&]() {
+            started.set_value();
+            fut.wait();
+            ++count;
+        });
+        started.get_future().wait();
+        // Queued behind the running task.
+        BOOST_CHECK(pool.submit([&]() { ++count; }));
+        pool.stop();
+        BOOST_CHECK(!pool.submit([&]() { ++count; }));
+        release.set_value();
+    }
+    // The queued task still runs after the pool is stopped.
+    BOOST_CHECK_EQUAL(count.load(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
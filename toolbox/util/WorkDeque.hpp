@@ -0,0 +1,128 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLBOX_UTIL_WORKDEQUE_HPP
+#define TOOLBOX_UTIL_WORKDEQUE_HPP
+
+#include <toolbox/sys/Limits.hpp>
+#include <toolbox/util/Math.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace toolbox {
+inline namespace util {
+
+/// Bounded Chase-Lev work-stealing deque.
+///
+/// The owning thread pushes and pops at the bottom of the deque, in LIFO order, without contention
+/// except when a single element remains. Other threads steal from the top, in FIFO order, with a
+/// compare-and-swap on the top index. The memory orderings follow Lê et al., "Correct and
+/// Efficient Work-Stealing for Weak Memory Models".
+template <typename ValueT>
+class alignas(CacheLineSize) WorkDeque {
+    static_assert(std::is_trivially_copyable_v<ValueT>);
+
+  public:
+    explicit WorkDeque(std::size_t capacity)
+    : capacity_{next_pow2(capacity)}
+    , mask_{capacity_ - 1}
+    , buf_{new std::atomic<ValueT>[capacity_]}
+    {
+    }
+    ~WorkDeque() = default;
+
+    // Copy.
+    WorkDeque(const WorkDeque&) = delete;
+    WorkDeque& operator=(const WorkDeque&) = delete;
+
+    // Move.
+    WorkDeque(WorkDeque&&) = delete;
+    WorkDeque& operator=(WorkDeque&&) = delete;
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    /// Returns the number of elements. The result is approximate if called concurrently.
+    std::size_t size() const noexcept
+    {
+        const auto b = bottom_.load(std::memory_order_relaxed);
+        const auto t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+    /// Owner only. Returns false if the deque is full.
+    bool push(ValueT val) noexcept
+    {
+        const auto b = bottom_.load(std::memory_order_relaxed);
+        const auto t = top_.load(std::memory_order_acquire);
+        if (b - t >= static_cast<std::int64_t>(capacity_)) {
+            return false;
+        }
+        buf_[b & mask_].store(val, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+    /// Owner only. Returns false if the deque is empty.
+    bool pop(ValueT& val) noexcept
+    {
+        const auto b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top_.load(std::memory_order_relaxed);
+        bool ok{false};
+        if (t <= b) {
+            val = buf_[b & mask_].load(std::memory_order_relaxed);
+            ok = true;
+            if (t == b) {
+                // The last element, which may be contended by thieves.
+                ok = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return ok;
+    }
+    /// Any thread. Returns false if the deque is empty, or if the steal lost a race with the owner
+    /// or another thief.
+    bool steal(ValueT& val) noexcept
+    {
+        auto t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        val = buf_[t & mask_].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+  private:
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    const std::unique_ptr<std::atomic<ValueT>[]> buf_;
+    alignas(CacheLineSize) std::atomic<std::int64_t> top_{0};
+    alignas(CacheLineSize) std::atomic<std::int64_t> bottom_{0};
+};
+
+} // namespace util
+} // namespace toolbox
+
+#endif // TOOLBOX_UTIL_WORKDEQUE_HPP
@@ -0,0 +1,111 @@
+// The Reactive C++ Toolbox.
+// Copyright (C) 2021 Reactive Markets Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "WorkDeque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace toolbox;
+
+BOOST_AUTO_TEST_SUITE(WorkDequeSuite)
+
+BOOST_AUTO_TEST_CASE(WorkDequeCase)
+{
+    WorkDeque<int> dq{3};
+    BOOST_CHECK_EQUAL(dq.capacity(), 4U);
+    BOOST_CHECK(dq.empty());
+
+    int val{};
+    BOOST_CHECK(!dq.pop(val));
+    BOOST_CHECK(!dq.steal(val));
+    for (int i{1}; i <= 4; ++i) {
+        BOOST_CHECK(dq.push(i));
+    }
+    BOOST_CHECK(!dq.push(5));
+    BOOST_CHECK_EQUAL(dq.size(), 4U);
+
+    // The owner pops the most recent element, and thieves steal the oldest.
+    BOOST_CHECK(dq.pop(val));
+    BOOST_CHECK_EQUAL(val, 4);
+    BOOST_CHECK(dq.steal(val));
+    BOOST_CHECK_EQUAL(val, 1);
+    BOOST_CHECK(dq.push(5));
+    BOOST_CHECK(dq.push(6));
+    BOOST_CHECK(!dq.push(7));
+
+    BOOST_CHECK(dq.steal(val));
+    BOOST_CHECK_EQUAL(val, 2);
+    BOOST_CHECK(dq.pop(val));
+    BOOST_CHECK_EQUAL(val, 6);
+    BOOST_CHECK(dq.pop(val));
+    BOOST_CHECK_EQUAL(val, 5);
+    BOOST_CHECK(dq.pop(val));
+    BOOST_CHECK_EQUAL(val, 3);
+    BOOST_CHECK(!dq.pop(val));
+    BOOST_CHECK(dq.empty());
+}
+
+BOOST_AUTO_TEST_CASE(WorkDequeStealCase)
+{
+    constexpr int N{100000};
+    WorkDeque<int> dq{64};
+    vector<atomic<int>> seen(N);
+    atomic<bool> done{false};
+
+    auto thief = [&]() {
+        int val;
+        while (!done.load(memory_order_acquire) || !dq.empty()) {
+            if (dq.steal(val)) {
+                seen[val].fetch_add(1, memory_order_relaxed);
+            } else {
+                this_thread::yield();
+            }
+        }
+    };
+    thread t1{thief}, t2{thief};
+    int val;
+    for (int i{0}; i < N;) {
+        if (dq.push(i)) {
+            ++i;
+        }
+        // Pop every other element, so that the owner and thieves contend for the last one.
+        if (i % 2 == 0 && dq.pop(val)) {
+            seen[val].fetch_add(1, memory_order_relaxed);
+        }
+        if (i % 64 == 0) {
+            this_thread::yield();
+        }
+    }
+    while (dq.pop(val)) {
+        seen[val].fetch_add(1, memory_order_relaxed);
+    }
+    done.store(true, memory_order_release);
+    t1.join();
+    t2.join();
+
+    // Each element is taken exactly once.
+    int bad{0};
+    for (const auto& n : seen) {
+        bad += n.load() != 1;
+    }
+    BOOST_CHECK_EQUAL(bad, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()